@@ -101,6 +101,26 @@ public:
     // Set EnableAnalyzeAllFunctions
     virtual void setEnableAnalyzeAllFunctions(bool Set) = 0;
 
+    // Get the number of threads used by translateBinary
+    virtual const uint32_t getThreadCount() const = 0;
+
+    // Set the number of threads used by translateBinary, 0 means hardware concurrency
+    virtual void setThreadCount(uint32_t ThreadCount) = 0;
+
+    // Get the directory of the lift cache, it is empty if the cache is disabled
+    virtual const std::string &getLiftCacheDirectory() const = 0;
+
+    // Set the directory of the lift cache and its pruning policy ("prune_after=24h:cache_size_bytes=1g", see
+    // unknown::parseCachePruningPolicy). An empty directory disables the cache.
+    virtual void setLiftCacheDirectory(const std::string &CacheDirectory, const std::string &PruningPolicy = "") = 0;
+
+    // Get the directory of the PDB symbol index, it is empty if the index is disabled
+    virtual const std::string &getSymbolIndexDirectory() const = 0;
+
+    // Set the directory of the PDB symbol index, the symbols are parsed by initTranslator so it must be set before. The
+    // index is kept by the pruning of a lift cache in the same directory.
+    virtual void setSymbolIndexDirectory(const std::string &IndexDirectory) = 0;
+
 public:
     // Static
     static std::unique_ptr<UnknownFrontendTranslator> createTranslator(
@@ -58,6 +58,11 @@ public:
 public:
     // Static
     static Argument *get(Type *Ty, const unknown::StringRef &ArgName = "", Function *F = nullptr, uint32_t ArgNo = 0);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == ArgumentVal; }
 };
 
 } // namespace uir
@@ -1,17 +1,23 @@
 #pragma once
 #include <UnknownIR/Constant.h>
+#include <UnknownIR/InstructionBase.h>
+
+#include <UnknownUtils/unknown/ADT/simple_ilist.h>
+
+#include <list>
 
 namespace uir {
 class Function;
-class Instruction;
 class TerminatorInstruction;
 
 class BasicBlock : public Constant
 {
+    friend class Function;
     friend class TerminatorInstruction;
 
 public:
-    using InstListType = std::list<Instruction *>;
+    // The instructions are linked intrusively, the block does not own them
+    using InstListType = unknown::simple_ilist<Instruction>;
     using PredecessorsListType = std::vector<BasicBlock *>;
 
 private:
@@ -19,6 +25,11 @@ private:
     uint64_t mBasicBlockAddressBegin;
     uint64_t mBasicBlockAddressEnd;
     Function *mParent;
+
+    // The position of this block in the block list of its parent, it is only valid while the block is linked. A block
+    // created with a parent or given one by setParent isn't linked until the parent inserts it
+    std::list<BasicBlock *>::iterator mParentIt;
+    bool mLinked;
     InstListType mInstList;
     PredecessorsListType mPredecessorsList;
 
@@ -45,32 +56,32 @@ public:
     using const_reverse_iterator = InstListType::const_reverse_iterator;
 
     iterator begin() { return mInstList.begin(); }
-    const_iterator begin() const { return mInstList.cbegin(); }
+    const_iterator begin() const { return mInstList.begin(); }
     iterator end() { return mInstList.end(); }
-    const_iterator end() const { return mInstList.cend(); }
+    const_iterator end() const { return mInstList.end(); }
 
     reverse_iterator rbegin() { return mInstList.rbegin(); }
-    const_reverse_iterator rbegin() const { return mInstList.crbegin(); }
+    const_reverse_iterator rbegin() const { return mInstList.rbegin(); }
     reverse_iterator rend() { return mInstList.rend(); }
-    const_reverse_iterator rend() const { return mInstList.crend(); }
+    const_reverse_iterator rend() const { return mInstList.rend(); }
 
+    // The size is O(n), use empty() if possible
     size_t size() const { return mInstList.size(); }
     bool empty() const { return mInstList.empty(); }
-    const Instruction &front() const { return *mInstList.front(); }
-    Instruction &front() { return *mInstList.front(); }
-    const Instruction &back() const { return *mInstList.back(); }
-    Instruction &back() { return *mInstList.back(); }
-    void push(Instruction *I) { mInstList.push_back(I); }
+    const Instruction &front() const { return mInstList.front(); }
+    Instruction &front() { return mInstList.front(); }
+    const Instruction &back() const { return mInstList.back(); }
+    Instruction &back() { return mInstList.back(); }
+    void push(Instruction *I) { mInstList.push_back(*I); }
     void pop() { mInstList.pop_back(); }
-    void push_back(Instruction *I) { mInstList.push_back(I); }
+    void push_back(Instruction *I) { mInstList.push_back(*I); }
     void pop_back() { mInstList.pop_back(); }
-    void push_front(Instruction *I) { mInstList.push_front(I); }
+    void push_front(Instruction *I) { mInstList.push_front(*I); }
     void pop_front() { mInstList.pop_front(); }
-    void insert(iterator I, Instruction *Inst) { mInstList.insert(I, Inst); }
-    void insert(iterator I, size_t N, Instruction *Inst) { mInstList.insert(I, N, Inst); }
-    void insert(iterator I, iterator First, iterator Last) { mInstList.insert(I, First, Last); }
-    void erase(iterator I) { mInstList.erase(I); }
-    void erase(iterator First, iterator Last) { mInstList.erase(First, Last); }
+    iterator insert(iterator I, Instruction *Inst) { return mInstList.insert(I, *Inst); }
+    void remove(Instruction *Inst) { mInstList.remove(*Inst); }
+    iterator erase(iterator I) { return mInstList.erase(I); }
+    iterator erase(iterator First, iterator Last) { return mInstList.erase(First, Last); }
     void clear() { mInstList.clear(); }
 
 public:
@@ -167,8 +178,8 @@ public:
 
 public:
     // Virtual functions
-    // Get the readable name of this object
-    virtual std::string getReadableName() const override;
+    // Print the readable name of this object
+    virtual void printReadableName(unknown::raw_ostream &OS) const override;
 
     // Get the property 'bb' of the value
     virtual unknown::StringRef getPropertyBB() const;
@@ -181,9 +192,6 @@ public:
 
 public:
     // Static
-    // Generate a new block name by order
-    static std::string generateOrderedBasicBlockName(Context &C);
-
     // Creates a new BasicBlock.
     static BasicBlock *get(Context &C);
 
@@ -205,6 +213,11 @@ public:
         uint64_t BasicBlockAddressBegin = 0,
         uint64_t BasicBlockAddressEnd = 0,
         Function *Parent = nullptr);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == BasicBlockVal; }
 };
 
 } // namespace uir
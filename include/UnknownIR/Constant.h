@@ -17,6 +17,11 @@ public:
     // Static
     // Get a Constant object
     static Constant *get(Type *Ty, const unknown::StringRef &ConstantName);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *) { return true; }
 };
 
 class ConstantInt : public Constant
@@ -41,8 +46,11 @@ public:
 
 public:
     // Virtual functions
-    // Get the readable name of this object
-    virtual std::string getReadableName() const override;
+    // Get the name of this object, it is formatted when it is needed
+    virtual std::string getName() const override;
+
+    // Print the readable name of this object
+    virtual void printReadableName(unknown::raw_ostream &OS) const override;
 
 public:
     // Static
@@ -51,6 +59,11 @@ public:
 
     // Get a ConstantInt from a value
     static ConstantInt *get(IntegerType *Ty, const unknown::APInt &Val);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == ConstantIntVal; }
 };
 
 } // namespace uir
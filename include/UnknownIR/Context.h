@@ -45,6 +45,11 @@ public:
     unknown::StringRef getModeString();
     void setMode(Mode mode);
     uint32_t getModeBits();
+
+public:
+    // Statistics
+    // Get the number of ConstantInt allocated by this context
+    uint64_t getNumIntConstantsAllocated() const;
 };
 
 } // namespace uir
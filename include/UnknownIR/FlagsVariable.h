@@ -65,6 +65,11 @@ public:
     // Static
     static FlagsVariable *get(Type *Ty);
     static FlagsVariable *get(Context &C);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == FlagsVariableVal; }
 };
 
 } // namespace uir
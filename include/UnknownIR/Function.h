@@ -3,6 +3,9 @@
 
 #include <UnknownUtils/unknown/Support/raw_ostream.h>
 
+#include <iterator>
+#include <list>
+
 namespace uir {
 
 class Module;
@@ -31,6 +34,15 @@ private:
     bool mHasAsyncEH;
     bool mHasNaked;
 
+    // The arena of the blocks and instructions of this function, nullptr if it is not enabled
+    std::unique_ptr<unknown::BumpPtrAllocator> mArena;
+
+    // The next index of the anonymous local variables, they are numbered by numberLocals
+    mutable uint64_t mLocalVarNameIndex;
+
+    // The next index of the anonymous blocks, they are numbered when they join this function
+    uint64_t mBlockNameIndex;
+
 public:
     explicit Function(
         Context &C,
@@ -75,11 +87,14 @@ public:
     BasicBlock &front() { return *mBasicBlocksList.front(); }
     const BasicBlock &back() const { return *mBasicBlocksList.back(); }
     BasicBlock &back() { return *mBasicBlocksList.back(); }
-    void push_back(BasicBlock *BB) { mBasicBlocksList.push_back(BB); }
-    void push_front(BasicBlock *BB) { mBasicBlocksList.push_front(BB); }
-    void pop_back() { mBasicBlocksList.pop_back(); }
-    void pop_front() { mBasicBlocksList.pop_front(); }
-    void clear() { mBasicBlocksList.clear(); }
+    // The blocks remember their position in the list, so that they are unlinked in constant time
+    iterator insert(iterator InsertPos, BasicBlock *BB);
+    iterator erase(iterator It);
+    void push_back(BasicBlock *BB) { insert(end(), BB); }
+    void push_front(BasicBlock *BB) { insert(begin(), BB); }
+    void pop_back() { erase(std::prev(end())); }
+    void pop_front() { erase(begin()); }
+    void clear();
 
 public:
     // Argument iterators
@@ -200,6 +215,24 @@ public:
     // function is __declspec(naked)?
     void setNaked(bool HasNaked);
 
+public:
+    // Arena
+    // Enable the arena, the blocks, instructions, arguments and contexts created for this function are allocated in
+    // it and released in bulk with the function. They must not outlive the function.
+    void enableArena();
+
+    // Get the arena of this function, nullptr if it is not enabled
+    unknown::BumpPtrAllocator *getArena() const;
+
+public:
+    // Local names
+    // Number the anonymous local variables of this function in print order, every instruction before its operands.
+    // It runs before the function is printed or written, so the numbers don't depend on which name is asked first.
+    void numberLocals() const;
+
+    // Get the next index of the anonymous blocks of this function, then increase it.
+    uint64_t nextBlockNameIndex();
+
 public:
     // Function Attribute
     // Add function attribute to this function.
@@ -241,8 +274,11 @@ public:
 
 public:
     // Virtual functions
-    // Get the readable name of this object
-    virtual std::string getReadableName() const override;
+    // Set the name of the value, the name index of the parent is kept in sync
+    virtual void setName(const unknown::Twine &ValueName) override;
+
+    // Print the readable name of this object
+    virtual void printReadableName(unknown::raw_ostream &OS) const override;
 
     // Get the property 'f' of the value
     virtual unknown::StringRef getPropertyFunction() const;
@@ -269,6 +305,11 @@ public:
         Module *Parent = nullptr,
         uint64_t FunctionAddressBegin = 0,
         uint64_t FunctionAddressEnd = 0);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == FunctionVal; }
 };
 
 } // namespace uir
@@ -63,6 +63,11 @@ public:
     // Static
     static FunctionContext *
     get(Type *Ty, const unknown::StringRef &CtxName = "", Function *F = nullptr, uint32_t CtxNo = 0);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == FunctionContextVal; }
 };
 
 } // namespace uir
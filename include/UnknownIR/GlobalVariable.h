@@ -1,6 +1,10 @@
 #pragma once
 #include <UnknownIR/Constant.h>
 
+#include <UnknownUtils/unknown/ADT/ArrayRef.h>
+
+#include <cstring>
+
 namespace uir {
 
 class Module;
@@ -28,6 +32,15 @@ public:
     // Set the address of this global variable
     void setGlobalVariableAddress(uint64_t GlobalVariableAddress);
 
+    // Get the size of the data of this global variable
+    virtual uint64_t getGlobalVariableSize() const;
+
+    // Is this global variable a GlobalArray?
+    virtual bool isGlobalArray() const;
+
+    // Get the bytes of the elements of the global array, they are empty if it has no serializable elements
+    virtual unknown::ArrayRef<uint8_t> getGlobalArrayData() const;
+
     // Get parent module
     const Module *getParent() const;
 
@@ -44,8 +57,11 @@ public:
 
 public:
     // Virtual functions
-    // Get the readable name of this object
-    virtual std::string getReadableName() const override;
+    // Set the name of the value, the name index of the parent is kept in sync
+    virtual void setName(const unknown::Twine &ValueName) override;
+
+    // Print the readable name of this object
+    virtual void printReadableName(unknown::raw_ostream &OS) const override;
 
     // Get the property 'gv' of the value
     virtual unknown::StringRef getPropertyGV() const;
@@ -64,6 +80,11 @@ public:
     // Allocate a GlobalVariable
     static GlobalVariable *get(Type *Ty, const unknown::StringRef &GlobalVariableName, uint64_t GlobalVariableAddress);
     static GlobalVariable *get(Type *Ty);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() == GlobalVariableVal; }
 };
 
 template <typename T = uint8_t>
@@ -101,6 +122,26 @@ public:
     const GlobalArrayType &getGlobalArray() const { return mElements; }
     void setGlobalArray(const GlobalArrayType &GlobalArrayElements) { mElements = GlobalArrayElements; }
 
+    // Get the size of the data of this global variable
+    virtual uint64_t getGlobalVariableSize() const override { return mElements.size() * sizeof(T); }
+
+    // Is this global variable a GlobalArray?
+    virtual bool isGlobalArray() const override { return true; }
+
+    // Get the bytes of the elements of the global array, the pointers of the host are not serializable
+    virtual unknown::ArrayRef<uint8_t> getGlobalArrayData() const override
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            return unknown::ArrayRef<uint8_t>(
+                reinterpret_cast<const uint8_t *>(mElements.data()), mElements.size() * sizeof(T));
+        }
+        else
+        {
+            return {};
+        }
+    }
+
 public:
     // Static
     static GlobalArray *
@@ -117,6 +158,20 @@ public:
     {
         return get(C, ElmtTy, GlobalArrayElements, generateOrderedGlobalVarName(C), 0);
     }
+
+    // Allocate a GlobalArray from the bytes of its elements, the size of the bytes is a multiple of sizeof(T)
+    static GlobalArray *
+    getFromData(
+        Context &C,
+        Type *ElmtTy,
+        unknown::ArrayRef<uint8_t> Data,
+        const unknown::StringRef &GlobalArrayName,
+        uint64_t GlobalArrayAddress)
+    {
+        GlobalArrayType Elements(Data.size() / sizeof(T));
+        std::memcpy(Elements.data(), Data.data(), Elements.size() * sizeof(T));
+        return get(C, ElmtTy, Elements, GlobalArrayName, GlobalArrayAddress);
+    }
 };
 
 } // namespace uir
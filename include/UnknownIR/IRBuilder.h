@@ -1,6 +1,7 @@
 #pragma once
 #include <UnknownIR/Instruction.h>
 #include <UnknownIR/BasicBlock.h>
+#include <UnknownIR/Function.h>
 
 namespace uir {
 
@@ -26,6 +27,9 @@ public:
     BasicBlock *getInsertBlock() const;
     BasicBlock::iterator getInsertPoint() const;
 
+    // Get the arena of the function of the insert block, nullptr if there is none
+    unknown::BumpPtrAllocator *getArena() const;
+
 public:
     // Insertion Point
     // Clear the insertion point
@@ -69,6 +73,12 @@ public:
     JmpAddrInstruction *createJmpAddr(ConstantInt *JmpDest, uint64_t InstAddress);
     JmpBBInstruction *createJmpBB(BasicBlock *DestBB, uint64_t InstAddress);
 
+    // Jcc
+    JccAddrInstruction *
+    createJccAddr(ConstantInt *JccDest, ConstantInt *JccNormal, FlagsVariable *FlagsVar, uint64_t InstAddress);
+    JccBBInstruction *
+    createJccBB(BasicBlock *JccDestBB, BasicBlock *JccNormalBB, FlagsVariable *FlagsVar, uint64_t InstAddress);
+
     // Load
     LoadInstruction *createLoad(Value *Ptr, uint64_t InstAddress);
 
@@ -77,6 +87,15 @@ public:
 
     // GetBitPtr
     GetBitPtrInstruction *createGetBitPtr(PointerType *ResType, Value *Ptr, Value *BitIndex, uint64_t InstAddress);
+
+    // Binary operators, FlagsVar is nullptr if the instruction leaves the flags alone
+    AddInstruction *createAdd(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress);
+    SubInstruction *createSub(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress);
+
+    // Bitwise
+    XorInstruction *createXor(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress);
+    OrInstruction *createOr(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress);
+    AndInstruction *createAnd(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress);
 };
 
 } // namespace uir
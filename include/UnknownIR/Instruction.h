@@ -11,6 +11,10 @@
 #include <UnknownIR/Instruction/Instruction.add.h>
 #include <UnknownIR/Instruction/Instruction.sub.h>
 
+#include <UnknownIR/Instruction/Instruction.xor.h>
+#include <UnknownIR/Instruction/Instruction.or.h>
+#include <UnknownIR/Instruction/Instruction.and.h>
+
 #include <UnknownIR/Instruction/Instruction.return.h>
 #include <UnknownIR/Instruction/Instruction.jmp.h>
 #include <UnknownIR/Instruction/Instruction.jcc.h>
@@ -49,6 +49,15 @@ public:
 public:
     // Static
     static GetBitPtrInstruction *get(PointerType *ResType, Value *Ptr, Value *BitIndex);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::GetBitPtr; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
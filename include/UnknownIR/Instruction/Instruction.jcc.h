@@ -47,6 +47,15 @@ public:
 public:
     // Static
     static JccAddrInstruction *get(Context &C, ConstantInt *JccDest, ConstantInt *JccNormal, FlagsVariable *FlagsVar);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::JccAddr; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 class JccBBInstruction : public TerminatorInstruction
@@ -98,6 +107,15 @@ public:
 public:
     // Static
     static JccBBInstruction *get(Context &C, BasicBlock *JccDestBB, BasicBlock *JccNormalBB, FlagsVariable *FlagsVar);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::JccBB; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
@@ -40,6 +40,15 @@ public:
 public:
     // Static
     static JmpAddrInstruction *get(Context &C, ConstantInt *JmpDest);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::JmpAddr; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 class JmpBBInstruction : public TerminatorInstruction
@@ -82,6 +91,15 @@ public:
 public:
     // Static
     static JmpBBInstruction *get(Context &C, BasicBlock *DestBB);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::JmpBB; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
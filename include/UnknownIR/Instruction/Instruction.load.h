@@ -40,6 +40,15 @@ public:
 public:
     // Static
     static LoadInstruction *get(Value *Ptr);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::Load; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
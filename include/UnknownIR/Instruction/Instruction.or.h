@@ -0,0 +1,40 @@
+#pragma once
+#include <UnknownIR/InstructionBase.h>
+
+namespace uir {
+
+class OrInstruction : public BinaryInstruction
+{
+public:
+    explicit OrInstruction(Value *LHS, Value *RHS, FlagsVariable *FlagsVar);
+    virtual ~OrInstruction();
+
+public:
+    // Virtual
+    // Get the opcode name of this instruction
+    virtual unknown::StringRef getOpcodeName() const override;
+
+    // Get the default number of operands
+    virtual uint32_t getDefaultNumberOfOperands() const override;
+
+    // Is this instruction with result?
+    virtual bool hasResult() const override;
+
+    // Is this instruction with flags?
+    virtual bool hasFlags() const override;
+
+public:
+    // Static
+    static OrInstruction *get(Value *LHS, Value *RHS, FlagsVariable *FlagsVar);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::Or; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
+};
+
+} // namespace uir
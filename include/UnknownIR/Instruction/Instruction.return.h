@@ -30,6 +30,15 @@ public:
 public:
     // Static
     static ReturnInstruction *get(Context &C);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::Ret; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 class ReturnImmInstruction : public TerminatorInstruction
@@ -66,6 +75,15 @@ public:
 public:
     // Static
     static ReturnImmInstruction *get(Context &C, ConstantInt *ImmConstantInt);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::RetIMM; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
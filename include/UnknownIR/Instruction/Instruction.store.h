@@ -58,6 +58,15 @@ public:
 public:
     // Static
     static StoreInstruction *get(Context &C, Value *Val, Value *Ptr, bool IsVolatile = false);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I) { return I->getOpCodeID() == OpCodeID::Store; }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
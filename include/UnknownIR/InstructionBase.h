@@ -5,6 +5,7 @@
 
 #include <UnknownUtils/unknown/Support/raw_ostream.h>
 #include <UnknownUtils/unknown/ADT/StringRef.h>
+#include <UnknownUtils/unknown/ADT/ilist_node.h>
 #include <unknown/tinyxml2/tinyxml2.h>
 
 namespace uir {
@@ -13,7 +14,7 @@ class BasicBlock;
 class LocalVariable;
 class Context;
 
-class Instruction : public LocalVariable
+class Instruction : public LocalVariable, public unknown::ilist_node<Instruction>
 {
 protected:
     OpCodeID mOpCodeID;
@@ -21,6 +22,8 @@ protected:
     BasicBlock *mParent;
     std::unique_ptr<FlagsVariable> mFlagsVariable;
     std::unique_ptr<LocalVariable> mStackVariable;
+    Use mFlagsVariableUse;
+    Use mStackVariableUse;
     bool mEnablePrintOp;
 
 public:
@@ -85,7 +88,7 @@ public:
     void setParent(BasicBlock *BB);
 
     // Get the opcode of this instruction
-    const OpCodeID getOpCodeID() const;
+    const OpCodeID getOpCodeID() const { return mOpCodeID; }
 
     // Set the opcode of this instruction
     void setOpCodeID(OpCodeID OpCodeId);
@@ -150,6 +153,11 @@ public:
 
     // Is this instruction Enable 'print detailed op'?
     bool hasPrintOp() const;
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() >= InstructionVal; }
 };
 
 class TerminatorInstruction : public Instruction
@@ -205,6 +213,62 @@ public:
 
     // Erase a successor into the terminator instruction.
     void eraseSuccessor(BasicBlock *Successor);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I)
+    {
+        return I->getOpCodeID() >= OpCodeID::Ret && I->getOpCodeID() <= OpCodeID::JccBB;
+    }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
+};
+
+class BinaryInstruction : public Instruction
+{
+protected:
+    BinaryInstruction(OpCodeID OpCodeId, Value *LHS, Value *RHS, FlagsVariable *FlagsVar);
+    virtual ~BinaryInstruction();
+
+public:
+    // Virtual
+    // Print the instruction
+    virtual void printInst(unknown::raw_ostream &OS) const override;
+
+public:
+    // Get/Set
+    // Get the left operand of this instruction
+    Value *getLHS();
+
+    // Get the left operand of this instruction
+    const Value *getLHS() const;
+
+    // Set the left operand of this instruction
+    void setLHS(Value *LHS);
+
+    // Get the right operand of this instruction
+    Value *getRHS();
+
+    // Get the right operand of this instruction
+    const Value *getRHS() const;
+
+    // Set the right operand of this instruction
+    void setRHS(Value *RHS);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Instruction *I)
+    {
+        return I->getOpCodeID() >= OpCodeID::Add && I->getOpCodeID() <= OpCodeID::And;
+    }
+    static bool classof(const Value *V)
+    {
+        return unknown::isa<Instruction>(V) && classof(unknown::cast<Instruction>(V));
+    }
 };
 
 } // namespace uir
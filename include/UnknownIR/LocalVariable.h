@@ -4,6 +4,7 @@
 namespace uir {
 
 class Context;
+class Function;
 
 class LocalVariable : public Constant
 {
@@ -23,6 +24,18 @@ public:
     // Set the address of this local variable
     void setLocalVariableAddress(uint64_t LocalVariableAddress);
 
+    // Name this anonymous local variable by its index in its function, the name is cached like a lazy name
+    void setOrderedName(uint64_t Index) const;
+
+public:
+    // Virtual functions
+    // Get the name of this local variable, the function using an anonymous one numbers its locals first
+    virtual std::string getName() const override;
+
+private:
+    // Get the function that uses this local variable, nullptr if there is none
+    const Function *getUsingFunction() const;
+
 public:
     // Static
     // Generate a new value name by order
@@ -31,6 +44,11 @@ public:
     // Allocate a LocalVariable
     static LocalVariable *get(Type *Ty, const unknown::StringRef &LocalVariableName, uint64_t LocalVariableAddress);
     static LocalVariable *get(Type *Ty);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *V) { return V->getValueID() >= LocalVariableVal; }
 };
 
 } // namespace uir
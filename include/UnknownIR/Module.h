@@ -3,6 +3,11 @@
 #include <UnknownIR/GlobalVariable.h>
 
 #include <UnknownUtils/unknown/Support/raw_ostream.h>
+#include <UnknownUtils/unknown/ADT/StringMap.h>
+#include <UnknownUtils/unknown/ADT/StringSet.h>
+
+#include <map>
+#include <set>
 
 namespace uir {
 
@@ -12,12 +17,37 @@ public:
     using FunctionSetType = std::list<Function *>;
     using GlobalVariableSetType = std::list<GlobalVariable *>;
 
+    // Indexed by name
+    using FunctionNameIndexType = unknown::StringMap<Function *>;
+    using GlobalVariableNameIndexType = unknown::StringMap<GlobalVariable *>;
+
+    // Indexed by begin address, sorted
+    using FunctionAddressIndexType = std::map<uint64_t, Function *>;
+    using GlobalVariableAddressIndexType = std::map<uint64_t, GlobalVariable *>;
+
 protected:
     Context &mContext;
     std::string mModuleName;
     FunctionSetType mFunctionList;
     GlobalVariableSetType mGlobalVariableList;
 
+protected:
+    // The indexes are kept in sync by insert/remove and by the name and address setters of the values
+    FunctionNameIndexType mFunctionNameIndex;
+    GlobalVariableNameIndexType mGlobalVariableNameIndex;
+    FunctionAddressIndexType mFunctionAddressIndex;
+    GlobalVariableAddressIndexType mGlobalVariableAddressIndex;
+
+    // The keys used by more than one value, the list is searched only when the indexed one of them goes away
+    unknown::StringSet<> mSharedFunctionNames;
+    unknown::StringSet<> mSharedGlobalVariableNames;
+    std::set<uint64_t> mSharedFunctionAddresses;
+    std::set<uint64_t> mSharedGlobalVariableAddresses;
+
+protected:
+    // The arena of the functions of this module, nullptr if it is not enabled
+    std::unique_ptr<unknown::BumpPtrAllocator> mArena;
+
 public:
     explicit Module(Context &C, const unknown::StringRef &ModuleName);
     virtual ~Module();
@@ -36,8 +66,18 @@ public:
     // Context
     Context &getContext() const;
 
+public:
+    // Arena
+    // Enable the arena, the functions created by Function::get for this module are allocated in it and get their own
+    // arena. They are released in bulk with the module and must not outlive it.
+    void enableArena();
+
+    // Get the arena of this module, nullptr if it is not enabled
+    unknown::BumpPtrAllocator *getArena() const;
+
 public:
     // Iterators
+    // The list operations below do not update the indexes
     // Function Iterators
     using iterator = FunctionSetType::iterator;
     using const_iterator = FunctionSetType::const_iterator;
@@ -99,14 +139,26 @@ public:
     // Get the specified global variable by address in the module
     std::optional<GlobalVariable *> getGlobalVariable(uint64_t Address) const;
 
+    // Get the function containing the address in the module
+    std::optional<Function *> getFunctionContaining(uint64_t Address) const;
+
+    // Get the global variable containing the address in the module
+    std::optional<GlobalVariable *> getGlobalVariableContaining(uint64_t Address) const;
+
 public:
-    // Insert/Drop/Clear
+    // Insert/Remove/Drop/Clear
     // Insert a function into the module
     void insertFunction(Function *Function);
 
     // Insert a global variable into the module
     void insertGlobalVariable(GlobalVariable *GV);
 
+    // Remove a function from the module, but does not delete it.
+    void removeFunction(Function *Function);
+
+    // Remove a global variable from the module, but does not delete it.
+    void removeGlobalVariable(GlobalVariable *GV);
+
     // Drop all functions/global variables in this module.
     void dropAllReferences();
 
@@ -116,6 +168,20 @@ public:
     // Clear all global variables in this module.
     void clearAllGlobalVariables();
 
+public:
+    // Index
+    // Add the function to the name and address indexes
+    void addFunctionToIndex(Function *Function);
+
+    // Remove the function from the name and address indexes
+    void removeFunctionFromIndex(Function *Function);
+
+    // Add the global variable to the name and address indexes
+    void addGlobalVariableToIndex(GlobalVariable *GV);
+
+    // Remove the global variable from the name and address indexes
+    void removeGlobalVariableFromIndex(GlobalVariable *GV);
+
 public:
     // Virtual functions
     // Get the property 'module' of the value
@@ -138,6 +204,14 @@ public:
     // Print the module
     void print(unknown::XMLPrinter &Printer) const;
 
+    // Print the module, the functions are rendered into their own buffers on ThreadCount threads and written in module
+    // order. The output is the same as the one of print, 0 means the hardware concurrency.
+    void printParallel(unknown::raw_ostream &OS, uint32_t ThreadCount = 0) const;
+
+private:
+    // Open the module element and print its attributes and its global variables
+    void printBegin(unknown::XMLPrinter &Printer) const;
+
 public:
     // Static
     static std::unique_ptr<Module> get(Context &C, const unknown::StringRef &ModuleName);
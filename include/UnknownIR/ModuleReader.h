@@ -0,0 +1,155 @@
+#pragma once
+#include <UnknownIR/Module.h>
+#include <UnknownIR/LocalVariable.h>
+#include <UnknownIR/Instruction.h>
+
+#include <UnknownUtils/unknown/ADT/DenseMap.h>
+#include <UnknownUtils/unknown/ADT/SmallVector.h>
+#include <UnknownUtils/unknown/ADT/StringMap.h>
+#include <UnknownUtils/unknown/ADT/Twine.h>
+#include <UnknownUtils/unknown/Support/MemoryBuffer.h>
+
+#include <optional>
+
+namespace uir {
+
+// Read a module from the binary UIR container written by ModuleWriter.
+// The container is mapped into memory, the function bodies are decoded when they are materialized.
+class ModuleReader
+{
+private:
+    // Decode the LEB128/bytes of the container
+    class Cursor;
+
+    // The type, name and annotation of a value
+    struct ValueHeader
+    {
+        Type *Ty = nullptr;
+        unknown::StringRef Name;
+        bool HasAnnotation = false;
+        unknown::SmallVector<unknown::StringRef, 2> ExtraInfoList;
+        unknown::StringRef Comment;
+    };
+
+    // A function of the module table
+    struct FunctionEntry
+    {
+        unknown::StringRef Name;
+        uint64_t BeginAddress = 0;
+        uint64_t EndAddress = 0;
+        uint64_t BodyOffset = 0;
+        uint64_t BodySize = 0;
+        Function *F = nullptr;
+        bool Materialized = false;
+        bool Malformed = false;
+    };
+
+    // The state of the function being read
+    struct FunctionState
+    {
+        Function *F = nullptr;
+        std::vector<BasicBlock *> Blocks;
+        std::vector<Argument *> Arguments;
+        std::vector<FunctionContext *> FunctionContexts;
+        std::vector<LocalVariable *> Slots;
+
+        // The placeholders of the forward references, they are replaced when the slot is defined
+        unknown::DenseMap<uint32_t, LocalVariable *> Placeholders;
+    };
+
+private:
+    Context &mContext;
+    std::string mFilePath;
+    std::unique_ptr<unknown::MemoryBuffer> mBuffer;
+    std::unique_ptr<Module> mModule;
+    std::string mErrorMessage;
+
+    // Tables, the strings point into the buffer
+    std::vector<unknown::StringRef> mStrings;
+    std::vector<Type *> mTypes;
+    std::vector<GlobalVariable *> mGlobals;
+    std::vector<FunctionEntry> mFunctions;
+    unknown::StringMap<uint32_t> mFunctionIndex;
+
+public:
+    ModuleReader(Context &C, const std::string &FilePath);
+    ModuleReader(Context &C, std::unique_ptr<unknown::MemoryBuffer> Buffer);
+    virtual ~ModuleReader();
+
+public:
+    // Parse
+    // Parse the header and the tables, the function bodies are not decoded
+    bool parse();
+
+public:
+    // Get/Set
+    // Get the module, nullptr if it is not parsed
+    Module *getModule();
+
+    // Take the module, the materialized functions don't depend on the reader
+    std::unique_ptr<Module> takeModule();
+
+    // Get the error message of the last failure
+    const std::string &getErrorMessage() const;
+
+    // Get the number of the functions in the container
+    size_t getNumFunctions() const;
+
+    // Get the name of the function in the container
+    unknown::StringRef getFunctionName(size_t Index) const;
+
+public:
+    // Materialize
+    // Decode the body of the function, nullptr if it is malformed
+    Function *materializeFunction(size_t Index);
+
+    // Decode the body of the function by name
+    std::optional<Function *> materializeFunction(unknown::StringRef FunctionName);
+
+    // Decode all the function bodies, in the order of the container
+    bool materializeAll();
+
+    // Decode the body of the function into F, F is owned by the caller and is not inserted into the module.
+    // The body must not reference the globals or the other functions, they live in the module of the reader.
+    bool materializeFunctionInto(size_t Index, Function *F);
+
+private:
+    // Tables
+    bool parseStringTable(Cursor &C);
+    bool parseTypeTable(Cursor &C);
+    bool parseModuleTable(Cursor &C);
+    bool parseGlobalTable(Cursor &C);
+
+    // Decode the elements of a global array, nullptr if they are malformed
+    GlobalVariable *parseGlobalArray(Cursor &C, const ValueHeader &Header, uint64_t Address);
+
+    // Get the function shell of the module table, its body is decoded later
+    Function *getOrCreateFunction(size_t Index);
+
+private:
+    // Function
+    // Decode the body of the function
+    bool parseFunctionBody(FunctionEntry &Entry);
+
+    // Decode an instruction, it is not inserted into a block
+    Instruction *parseInstruction(Cursor &C, FunctionState &FS, uint64_t &PrevAddress);
+
+    // Decode a value reference
+    Value *parseValueRef(Cursor &C, FunctionState &FS);
+
+    // Define the next local slot, the forward references to it are resolved
+    void defineSlot(FunctionState &FS, LocalVariable *LV);
+
+private:
+    // Values
+    bool parseString(Cursor &C, unknown::StringRef &Str);
+    bool parseType(Cursor &C, Type *&Ty);
+    bool parseName(Cursor &C, ValueHeader &Header);
+    bool parseValueHeader(Cursor &C, ValueHeader &Header);
+    void applyValueHeader(Value &V, const ValueHeader &Header);
+
+    // Record the error, always returns false
+    bool error(const unknown::Twine &Message);
+};
+
+} // namespace uir
@@ -0,0 +1,116 @@
+#pragma once
+#include <UnknownIR/Module.h>
+#include <UnknownIR/LocalVariable.h>
+#include <UnknownIR/Instruction.h>
+
+#include <UnknownUtils/unknown/ADT/DenseMap.h>
+#include <UnknownUtils/unknown/ADT/SmallPtrSet.h>
+#include <UnknownUtils/unknown/ADT/SmallVector.h>
+#include <UnknownUtils/unknown/ADT/StringMap.h>
+#include <UnknownUtils/unknown/Support/raw_ostream.h>
+
+namespace uir {
+
+// Write a module into the binary UIR container, it is read back by ModuleReader
+class ModuleWriter
+{
+private:
+    // The module is nullptr if a single function is written
+    const Module *mModule;
+    std::vector<const Function *> mFunctions;
+
+    // String table
+    unknown::StringMap<uint32_t> mStringIndex;
+    std::vector<unknown::StringRef> mStrings;
+
+    // Type table
+    unknown::DenseMap<const Type *, uint32_t> mTypeIndex;
+    std::vector<const Type *> mTypes;
+
+    // Global table
+    unknown::DenseMap<const GlobalVariable *, uint32_t> mGlobalIndex;
+    std::vector<const GlobalVariable *> mGlobals;
+
+    // The index of the functions of the module
+    unknown::DenseMap<const Function *, uint32_t> mFunctionIndex;
+
+    // The first value which can't be written, nothing is written then
+    std::string mErrorMessage;
+
+    // The state of the function being written
+    struct FunctionState
+    {
+        const Function *F = nullptr;
+        unknown::DenseMap<const Value *, uint32_t> BlockIndex;
+        unknown::DenseMap<const Value *, uint32_t> ArgumentIndex;
+        unknown::DenseMap<const Value *, uint32_t> FunctionContextIndex;
+        unknown::DenseMap<const Value *, uint32_t> LocalSlots;
+
+        // The instructions of the blocks and their variables, the other local operands are detached
+        unknown::SmallPtrSet<const Value *, 32> InBlockValues;
+        unknown::SmallPtrSet<const Value *, 16> DetachedVisited;
+
+        // The number of the local slots assigned/defined so far, a reference to a later slot is a forward reference
+        uint32_t NumSlots = 0;
+        uint32_t NumDefinedSlots = 0;
+    };
+
+public:
+    explicit ModuleWriter(const Module &M);
+
+    // Write a container with the single function, the function doesn't need to be in a module.
+    // The references to the globals and the other functions are not valid outside the container.
+    explicit ModuleWriter(const Function &F);
+    virtual ~ModuleWriter();
+
+public:
+    // Write
+    // Write the module into the stream, nothing is written if a value can't be referenced in the container
+    bool write(unknown::raw_ostream &OS);
+
+    // Write the module into the file
+    bool writeToFile(const std::string &FilePath);
+
+    // Get the error message of the last failure
+    const std::string &getErrorMessage() const;
+
+private:
+    // Tables
+    // Get the index of the string/type/global, it is added to the table if it isn't there
+    uint32_t getStringIndex(unknown::StringRef Str);
+    uint32_t getTypeIndex(const Type *Ty);
+    uint32_t getGlobalIndex(const GlobalVariable *GV);
+
+    // Write the tables
+    void writeStringTable(unknown::raw_ostream &OS) const;
+    void writeTypeTable(unknown::raw_ostream &OS) const;
+    void writeGlobalTable(unknown::raw_ostream &OS);
+
+private:
+    // Function
+    // Write the body of the function
+    void writeFunction(unknown::raw_ostream &OS, const Function &F);
+
+    // Collect the function-local values which are not in a block, the operands come first
+    void collectDetachedValue(FunctionState &FS, const Value *V, std::vector<const LocalVariable *> &Detached);
+
+    // Assign the local slots of the instruction, its flags variable and its stack variable
+    void assignInstructionSlots(FunctionState &FS, const Instruction &I);
+
+    // Write the instruction, the address is encoded relative to PrevAddress
+    void writeInstruction(unknown::raw_ostream &OS, FunctionState &FS, const Instruction &I, uint64_t &PrevAddress);
+
+    // Write the type, name and annotation of the value
+    void writeValueHeader(unknown::raw_ostream &OS, const Value &V);
+
+    // Write the name and the annotation of the value, the name is empty if the value is anonymous
+    void writeName(unknown::raw_ostream &OS, unknown::StringRef Name, const Value &V);
+
+    // Write the reference to the value
+    void writeValueRef(unknown::raw_ostream &OS, FunctionState &FS, const Value *V);
+
+    // Record the first error, always returns false
+    bool error(const unknown::Twine &Message);
+};
+
+} // namespace uir
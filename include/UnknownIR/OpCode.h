@@ -13,7 +13,7 @@ enum class OpCodeID : uint8_t
     Store,
     GetBitPtr,
 
-    // Binary operators instructions
+    // Binary operators instructions, they are contiguous with the bitwise ones up to And for BinaryInstruction::classof
     Add,
     Sub,
 
@@ -23,7 +23,7 @@ enum class OpCodeID : uint8_t
     And,
     Not,
 
-    // Terminator instructions
+    // Terminator instructions, they are contiguous for TerminatorInstruction::classof
     Ret,
     RetIMM,
     JmpAddr,
@@ -47,7 +47,7 @@ public:
     void setTypeName(const unknown::StringRef &TypeName);
 
     // Get/Set the id of the type
-    TypeID getTypeID() const;
+    TypeID getTypeID() const { return mTypeID; }
     void setTypeID(TypeID TypeID);
 
     // Get/Set the bits of the type
@@ -110,13 +110,18 @@ public:
 class IntegerType : public Type
 {
 public:
-    explicit IntegerType(Context &C, const char *TypeName, uint32_t TypeSizeInBits);
+    explicit IntegerType(Context &C, const unknown::StringRef &TypeName, uint32_t TypeSizeInBits);
     virtual ~IntegerType();
 
 public:
     // Static
     // Get or create an IntegerType instance.
     static IntegerType *get(Context &C, uint32_t NumBits);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Type *T) { return T->getTypeID() == IntegerTyID; }
 };
 
 class PointerType : public Type
@@ -125,7 +130,7 @@ private:
     Type *mElementType;
 
 public:
-    explicit PointerType(Context &C, Type *ElementType, const char *TypeName);
+    explicit PointerType(Context &C, Type *ElementType, const unknown::StringRef &TypeName);
     virtual ~PointerType();
 
 public:
@@ -136,6 +141,11 @@ public:
 public:
     // Static
     static PointerType *get(Context &C, Type *ElementType);
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Type *T) { return T->getTypeID() == PointerTyID; }
 };
 
 } // namespace uir
@@ -16,3 +16,5 @@
 #include <UnknownIR/Argument.h>
 #include <UnknownIR/FunctionContext.h>
 #include <UnknownIR/OverloadStream.h>
+#include <UnknownIR/ModuleWriter.h>
+#include <UnknownIR/ModuleReader.h>
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+namespace uir {
+
+class Value;
+class User;
+
+// A use of a value by a user.
+// The uses of a value are linked intrusively, so a value does not allocate anything for its users.
+class Use
+{
+    friend class Value;
+
+private:
+    Value *mVal;
+    Use *mNext;
+    Use **mPrev;
+    User *mParent;
+
+public:
+    Use();
+    explicit Use(User *Parent);
+    Use(const Use &) = delete;
+    Use &operator=(const Use &) = delete;
+    ~Use();
+
+public:
+    // Get/Set
+    // Get the value of this use
+    Value *get() const { return mVal; }
+    operator Value *() const { return mVal; }
+    Value *operator->() const { return mVal; }
+
+    // Get/Set the user of this use
+    User *getUser() const { return mParent; }
+    void setUser(User *Parent) { mParent = Parent; }
+
+    // Get the next use of the same value
+    Use *getNext() const { return mNext; }
+
+    // Is this use linked into the use list of its value?
+    bool isLinked() const { return mPrev != nullptr; }
+
+    // Set the value and link this use into the use list of the value
+    void set(Value *V);
+
+    // Set the value without linking this use into the use list of the value
+    void setUnlinked(Value *V);
+
+    // Unlink this use from the use list of its value, but keep the value
+    void drop();
+
+    // Take the value of another use and its place in the use list
+    void moveFrom(Use &Other);
+};
+
+} // namespace uir
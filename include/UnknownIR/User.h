@@ -6,10 +6,61 @@ namespace uir {
 class User : public Value
 {
 public:
-    using OperandListType = std::vector<Value *>;
+    // The number of operands stored inline in the user, larger lists are moved to the heap
+    static constexpr uint32_t NumInlineOperands = 2;
+
+    // Iterate the values of the operands
+    class op_iterator_impl
+    {
+    private:
+        const Use *mUse = nullptr;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Value *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value **;
+        using reference = Value *;
+
+        op_iterator_impl() = default;
+        explicit op_iterator_impl(const Use *U) : mUse(U) {}
+
+        Value *operator*() const { return mUse->get(); }
+        op_iterator_impl &operator++()
+        {
+            ++mUse;
+            return *this;
+        }
+        op_iterator_impl operator++(int)
+        {
+            auto Tmp = *this;
+            ++mUse;
+            return Tmp;
+        }
+        op_iterator_impl &operator--()
+        {
+            --mUse;
+            return *this;
+        }
+        op_iterator_impl &operator+=(difference_type N)
+        {
+            mUse += N;
+            return *this;
+        }
+        op_iterator_impl operator+(difference_type N) const { return op_iterator_impl(mUse + N); }
+        difference_type operator-(const op_iterator_impl &RHS) const { return mUse - RHS.mUse; }
+        bool operator==(const op_iterator_impl &RHS) const { return mUse == RHS.mUse; }
+        bool operator!=(const op_iterator_impl &RHS) const { return mUse != RHS.mUse; }
+
+        // Get the use of this iterator
+        const Use &getUse() const { return *mUse; }
+    };
 
 private:
-    OperandListType mOperandList;
+    Use *mOperandList;
+    uint32_t mNumOperands;
+    uint32_t mOperandCapacity;
+    Use mInlineOperands[NumInlineOperands];
 
 public:
     User();
@@ -19,13 +70,16 @@ public:
 public:
     // OperandList
     // Returns the list of operands for this instruction.
-    OperandListType &getOperandList();
-    const OperandListType &getOperandList() const;
+    Use *getOperandList() { return mOperandList; }
+    const Use *getOperandList() const { return mOperandList; }
+
+    // Is the use one of the operands of this user?
+    bool isOperandUse(const Use *U) const;
 
 public:
     // Iterator
-    using op_iterator = OperandListType::iterator;
-    using const_op_iterator = OperandListType::const_iterator;
+    using op_iterator = op_iterator_impl;
+    using const_op_iterator = op_iterator_impl;
     op_iterator op_begin();
     const_op_iterator op_begin() const;
     op_iterator op_end();
@@ -39,6 +93,10 @@ public:
     bool op_empty() const;
     void op_clear();
 
+private:
+    // Append a new empty operand, the operand list grows if needed
+    Use &allocateOperand();
+
 public:
     // Virtual functions
     // Replaces all references to the "From" definition with references to the "To"
@@ -75,6 +133,11 @@ public:
 
     // Drop all references to operands.
     void dropAllReferences();
+
+public:
+    // RTTI
+    // Methods for support type inquiry through isa, cast, and dyn_cast
+    static bool classof(const Value *) { return true; }
 };
 
 } // namespace uir
\ No newline at end of file
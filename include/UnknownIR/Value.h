@@ -1,9 +1,15 @@
 #pragma once
 #include <UnknownIR/Object.h>
 #include <UnknownIR/Type.h>
+#include <UnknownIR/Use.h>
 
 #include <UnknownUtils/unknown/Support/raw_ostream.h>
 #include <UnknownUtils/unknown/ADT/StringRef.h>
+#include <UnknownUtils/unknown/ADT/Twine.h>
+#include <UnknownUtils/unknown/Support/Casting.h>
+#include <UnknownUtils/unknown/Support/Allocator.h>
+
+#include <iterator>
 
 namespace uir {
 
@@ -13,38 +19,88 @@ class User;
 class Value : public Object
 {
 public:
-    using UsersListType = std::unordered_set<User *>;
     using ExtraInfoListType = std::vector<std::string>;
 
+    // The extra info and comment of a value, most values have neither
+    struct AnnotationType
+    {
+        ExtraInfoListType ExtraInfoList;
+        std::string Comment;
+    };
+
+    // The concrete subclass of the value, it is used by isa/cast/dyn_cast instead of the C++ RTTI.
+    // The subclasses of LocalVariable are kept at the end so that it can be checked by a range.
+    enum ValueID : uint8_t
+    {
+        ConstantVal,
+        ConstantIntVal,
+        ArgumentVal,
+        BasicBlockVal,
+        FunctionVal,
+        FunctionContextVal,
+        GlobalVariableVal,
+        LocalVariableVal,
+        FlagsVariableVal,
+        InstructionVal,
+    };
+
 protected:
     Type *mType;
-    std::string mValueName;
+    ValueID mValueID;
+
+    // The name is interned in the context, an anonymous local variable is named lazily when it is printed
+    mutable unknown::StringRef mValueName;
 
 protected:
-    UsersListType mUsers;
+    // The head of the intrusive list of the uses of this value
+    Use *mUseList;
+
+    // The value is uniqued by the context and its uses may be updated by several threads
+    bool mIsShared;
 
 protected:
-    ExtraInfoListType mExtraInfoList;
-    std::string mComment;
+    // Allocated when the first extra info or comment is added
+    std::unique_ptr<AnnotationType> mAnnotation;
 
 public:
     Value();
     explicit Value(Type *Ty, const unknown::StringRef &ValueName);
     virtual ~Value();
 
+public:
+    // Allocation
+    // Allocate the value on the heap, or in the arena if it is not nullptr.
+    // A word in front of the value records the arena, the memory of a value in an arena is released with the arena.
+    static void *operator new(size_t Size);
+    static void *operator new(size_t Size, unknown::BumpPtrAllocator *Arena);
+    static void operator delete(void *Ptr);
+    static void operator delete(void *Ptr, unknown::BumpPtrAllocator *Arena);
+
 public:
     // Context
     Context &getContext() const;
 
 public:
-    // User
-    const UsersListType &getUsers() const;
-    UsersListType &getUsers();
+    // Use
+    // Get the first use of this value
+    Use *getUseList() const { return mUseList; }
+
+    // Link the use into the use list of this value
+    void addUse(Use &U);
+
+    // Unlink the use from the use list of this value
+    void removeUse(Use &U);
+
+    // Replace the use From by the use To in the use list of this value
+    void replaceUse(Use &From, Use &To);
 
 public:
     // Get/Set the name of the value
     bool hasName() const;
-    void setName(const char *ValueName);
+    virtual void setName(const unknown::Twine &ValueName);
+
+    // Get the interned name of the value, it is empty if the value is anonymous
+    unknown::StringRef getNameRef() const { return mValueName; }
 
     // Get/Set the type of the value
     Type *getType() const;
@@ -54,6 +110,12 @@ public:
     uint32_t getValueBits() const;
     uint32_t getValueSize() const;
 
+    // Is the value shared by threads?
+    bool isShared() const;
+
+    // Get the id of the value
+    ValueID getValueID() const { return mValueID; }
+
     // Get the extra info of this object
     const ExtraInfoListType &getExtraInfoList() const;
 
@@ -66,6 +128,13 @@ public:
     // Set the comment of this object
     void setComment(const unknown::StringRef &Comment);
 
+protected:
+    // Get the annotation of this object, it is allocated if it doesn't exist
+    AnnotationType &getOrCreateAnnotation();
+
+    // Intern the name in the context of the type
+    static unknown::StringRef internName(Type *Ty, const unknown::Twine &ValueName);
+
 public:
     // Add/Remove
     // Add extra info to this object
@@ -79,19 +148,52 @@ public:
 
 public:
     // Iterator
-    using user_iterator = UsersListType::iterator;
-    using const_user_iterator = UsersListType::const_iterator;
+    // A user appears once for every use of this value
+    template <typename UserTy>
+    class user_iterator_impl
+    {
+    private:
+        Use *mUse = nullptr;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = UserTy *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = UserTy **;
+        using reference = UserTy *;
+
+        user_iterator_impl() = default;
+        explicit user_iterator_impl(Use *U) : mUse(U) {}
+
+        UserTy *operator*() const { return mUse->getUser(); }
+        user_iterator_impl &operator++()
+        {
+            mUse = mUse->getNext();
+            return *this;
+        }
+        user_iterator_impl operator++(int)
+        {
+            auto Tmp = *this;
+            ++*this;
+            return Tmp;
+        }
+        bool operator==(const user_iterator_impl &RHS) const { return mUse == RHS.mUse; }
+        bool operator!=(const user_iterator_impl &RHS) const { return mUse != RHS.mUse; }
+
+        // Get the use of this iterator
+        Use &getUse() const { return *mUse; }
+    };
+
+    using user_iterator = user_iterator_impl<User>;
+    using const_user_iterator = user_iterator_impl<const User>;
     user_iterator user_begin();
     const_user_iterator user_begin() const;
     user_iterator user_end();
     const_user_iterator user_end() const;
     bool user_empty() const;
-    bool user_contains(User *U) const;
+    bool user_contains(const User *U) const;
     size_t user_size() const;
-    size_t user_count(User *U) const;
-    void user_insert(User *U);
-    void user_erase(User *U);
-    void user_clear();
+    size_t user_count(const User *U) const;
 
 public:
     // Virtual functions
@@ -101,6 +203,9 @@ public:
     // Get the readable name of the value
     virtual std::string getReadableName() const override;
 
+    // Print the readable name of the value, it doesn't build a string
+    virtual void printReadableName(unknown::raw_ostream &OS) const;
+
     // Get the property 'name' of the value
     virtual unknown::StringRef getPropertyName() const;
 
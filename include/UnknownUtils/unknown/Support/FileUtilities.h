@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "unknown/ADT/STLExtras.h"
 #include "unknown/Support/FileSystem.h"
 #include "unknown/Support/Path.h"
 
@@ -75,5 +76,13 @@ public:
     /// will not be removed when the object is destroyed.
     void releaseFile() { DeleteIt = false; }
 };
+
+class raw_ostream;
+
+/// writeFileAtomically - Write the file through a unique temporary file made
+/// from TempPathModel, which is renamed to FinalPath once Writer succeeded.
+/// A reader of FinalPath sees the previous file or the complete new one.
+/// The temporary file is removed on failure.
+bool writeFileAtomically(StringRef TempPathModel, StringRef FinalPath, function_ref<bool(raw_ostream &)> Writer);
 } // namespace unknown
 
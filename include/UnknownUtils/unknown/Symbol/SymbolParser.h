@@ -3,7 +3,9 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <optional>
 
+#include "unknown/ADT/STLExtras.h"
 #include "unknown/ADT/StringRef.h"
 
 namespace unknown {
@@ -46,26 +48,59 @@ public:
         bool hasGuardCF = false;        // function contains CFG checks (and no write checks)
     };
 
+    // A function symbol found by a lookup, the name is a view into the symbol file that lives as long as the parser
+    struct FunctionSymbolRef
+    {
+        StringRef name;
+        uint32_t rva = 0;
+        uint32_t size = 0; // 0 if it is not known
+    };
+
 protected:
     std::vector<CommonSymbol> mCommonSymbols;
     std::vector<FunctionSymbol> mFunctionSymbols;
     uint64_t mImageBase;
 
+    // The directory of the symbol index cache, it is not used if it is empty
+    std::string mIndexCacheDirectory;
+
 public:
     SymbolParser() : mImageBase(0) {}
-    ~SymbolParser() = default;
+    virtual ~SymbolParser() = default;
 
 public:
     // Parser
     virtual bool ParseCommonSymbols(StringRef SymFilePath) = 0;
     virtual bool ParseFunctionSymbols(StringRef SymFilePath) = 0;
 
+public:
+    // Lookup
+    // Open the symbol file for the lookups, the function symbols are not materialized if the format allows it.
+    // By default the function symbols are parsed and the lookups search them.
+    virtual bool OpenFunctionSymbols(StringRef SymFilePath);
+
+    // Find the function symbol beginning at the RVA
+    virtual std::optional<FunctionSymbolRef> FindFunctionSymbolByRVA(uint32_t RVA);
+
+    // Find the function symbol by name
+    virtual std::optional<FunctionSymbolRef> FindFunctionSymbolByName(StringRef Name);
+
+    // Visit the function symbols beginning in [BeginRVA, EndRVA), in the order of their RVA
+    virtual void ForEachFunctionSymbolInRange(
+        uint32_t BeginRVA,
+        uint32_t EndRVA,
+        function_ref<void(const FunctionSymbolRef &)> Callback);
+
 public:
     // Get/Set
     uint64_t getImageBase() const { return mImageBase; }
     void setImageBase(uint64_t imageBase) { mImageBase = imageBase; }
     std::vector<FunctionSymbol> &getFunctionSymbols() { return mFunctionSymbols; }
     std::vector<CommonSymbol> &getAllSymbols() { return mCommonSymbols; }
+
+    // The parsed symbols of a PDB are cached in the directory by the GUID and age of the PDB
+    const std::string &getIndexCacheDirectory() const { return mIndexCacheDirectory; }
+    void setIndexCacheDirectory(StringRef Directory) { mIndexCacheDirectory = Directory.str(); }
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,197 @@
+#include "LiftCache.h"
+#include "Error.h"
+
+#include <unknown/ADT/SmallPtrSet.h>
+#include <unknown/ADT/SmallString.h>
+#include <unknown/ADT/StringExtras.h>
+#include <unknown/Support/Endian.h>
+#include <unknown/Support/Error.h>
+#include <unknown/Support/FileSystem.h>
+#include <unknown/Support/FileUtilities.h>
+#include <unknown/Support/MemoryBuffer.h>
+#include <unknown/Support/Path.h>
+#include <unknown/Support/SHA1.h>
+#include <unknown/Support/raw_ostream.h>
+
+namespace ufrontend {
+
+// Does the value reference a global or a function? The operands of the detached instructions are walked too
+static bool
+referencesModuleValue(const uir::Value *V, unknown::SmallPtrSetImpl<const uir::Value *> &Visited)
+{
+    if (V == nullptr || !Visited.insert(V).second)
+    {
+        return false;
+    }
+
+    if (unknown::isa<uir::GlobalVariable>(V) || unknown::isa<uir::Function>(V))
+    {
+        return true;
+    }
+
+    if (auto I = unknown::dyn_cast<uir::Instruction>(V))
+    {
+        for (auto OpIt = I->op_begin(); OpIt != I->op_end(); ++OpIt)
+        {
+            if (referencesModuleValue(*OpIt, Visited))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+LiftCache::LiftCache(uir::Context &C, const std::string &CacheDirectory) :
+    mContext(C), mCacheDirectory(CacheDirectory)
+{
+    assert(!CacheDirectory.empty());
+
+    if (auto EC = unknown::sys::fs::create_directories(mCacheDirectory))
+    {
+        std::cerr << std::format(UFRONTEND_ERROR_PREFIX "LiftCache: {}: {}", mCacheDirectory, EC.message())
+                  << std::endl;
+    }
+}
+
+LiftCache::~LiftCache()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Key
+// Get the key of the function, its attributes and flags are already set
+std::string
+LiftCache::getKey(unknown::ArrayRef<uint8_t> Bytes, uint64_t Address, const uir::Function &F) const
+{
+    unknown::SHA1 Hasher;
+    auto updateInteger = [&Hasher](uint64_t Value) {
+        uint8_t Data[sizeof(uint64_t)];
+        unknown::support::endian::write64le(Data, Value);
+        Hasher.update(unknown::ArrayRef<uint8_t>(Data));
+    };
+
+    // The addresses of the instructions are in the lifted body, so the address is a part of the key
+    updateInteger(TranslatorVersion);
+    updateInteger(static_cast<uint64_t>(mContext.getArch()));
+    updateInteger(static_cast<uint64_t>(mContext.getMode()));
+    updateInteger(Address);
+    updateInteger(Bytes.size());
+    Hasher.update(Bytes);
+
+    // The attributes of the config and the flags of the symbol
+    updateInteger(F.hasSEH() | F.hasAsyncEH() << 1 | F.hasNaked() << 2);
+    auto &Attributes = F.getFunctionAttributes();
+    updateInteger(Attributes.size());
+    for (auto &Attr : Attributes)
+    {
+        updateInteger(Attr.size());
+        Hasher.update(Attr);
+    }
+
+    return unknown::toHex(Hasher.final(), true);
+}
+
+////////////////////////////////////////////////////////////
+// Load/Store
+// Load the body of the function, false if it is not in the cache
+bool
+LiftCache::load(const std::string &Key, uir::Function *F) const
+{
+    assert(F);
+
+    auto Buffer = unknown::MemoryBuffer::getFile(getEntryPath(Key), -1, false);
+    if (!Buffer)
+    {
+        return false;
+    }
+
+    uir::ModuleReader Reader(mContext, std::move(*Buffer));
+    if (Reader.parse() && Reader.getNumFunctions() == 1 && Reader.materializeFunctionInto(0, F))
+    {
+        return true;
+    }
+
+    // Drop the partial body, the function is lifted again and the entry is overwritten
+    F->clearAllBasicBlock();
+    F->arg_clear();
+    F->fc_clear();
+
+    std::cerr << std::format(UFRONTEND_ERROR_PREFIX "LiftCache: {}: {}", Key, Reader.getErrorMessage()) << std::endl;
+    return false;
+}
+
+// Store the body of the function, a body that references globals or other functions is not stored
+bool
+LiftCache::store(const std::string &Key, const uir::Function &F) const
+{
+    unknown::SmallPtrSet<const uir::Value *, 32> Visited;
+    for (auto BB : F)
+    {
+        for (auto &I : *BB)
+        {
+            if (referencesModuleValue(&I, Visited))
+            {
+                return false;
+            }
+        }
+    }
+
+    // A lift running at the same time may load the entry while it is stored
+    unknown::SmallString<128> TempModel(mCacheDirectory);
+    unknown::sys::path::append(TempModel, "tmp-" + Key + "-%%%%%%");
+    return unknown::writeFileAtomically(TempModel, getEntryPath(Key), [&F](unknown::raw_ostream &OS) {
+        uir::ModuleWriter Writer(F);
+        return Writer.write(OS);
+    });
+}
+
+////////////////////////////////////////////////////////////
+// Pruning
+// Set the pruning policy, see unknown::parseCachePruningPolicy. false if the policy is not valid
+bool
+LiftCache::setPruningPolicy(const std::string &Policy)
+{
+    auto PruningPolicy = unknown::parseCachePruningPolicy(Policy);
+    if (!PruningPolicy)
+    {
+        std::cerr << std::format(
+                         UFRONTEND_ERROR_PREFIX "LiftCache: {}: {}",
+                         Policy,
+                         unknown::toString(PruningPolicy.takeError()))
+                  << std::endl;
+        return false;
+    }
+
+    mPruningPolicy = *PruningPolicy;
+    return true;
+}
+
+// Prune the cache directory by the pruning policy
+void
+LiftCache::prune() const
+{
+    unknown::pruneCache(mCacheDirectory, mPruningPolicy);
+}
+
+////////////////////////////////////////////////////////////
+// Get/Set
+// Get the cache directory
+const std::string &
+LiftCache::getCacheDirectory() const
+{
+    return mCacheDirectory;
+}
+
+// Get the path of the entry, pruneCache only considers the files named "llvmcache-*"
+std::string
+LiftCache::getEntryPath(const std::string &Key) const
+{
+    unknown::SmallString<128> Path(mCacheDirectory);
+    unknown::sys::path::append(Path, "llvmcache-" + Key);
+    return std::string(Path.str());
+}
+
+} // namespace ufrontend
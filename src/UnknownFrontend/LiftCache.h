@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include <UnknownIR/UnknownIR.h>
+
+#include <UnknownUtils/unknown/ADT/ArrayRef.h>
+#include <UnknownUtils/unknown/Support/CachePruning.h>
+
+namespace ufrontend {
+
+// The on-disk cache of the lifted functions. An entry is the binary UIR container of one function, it is keyed by the
+// SHA1 of the bytes and the address of the function, the translator version and the attributes of the function.
+class LiftCache
+{
+public:
+    // Bump it when the lifting of an instruction changes, the entries of the older translators are not hit anymore
+    static constexpr uint32_t TranslatorVersion = 6;
+
+private:
+    uir::Context &mContext;
+    std::string mCacheDirectory;
+    unknown::CachePruningPolicy mPruningPolicy;
+
+public:
+    LiftCache(uir::Context &C, const std::string &CacheDirectory);
+    virtual ~LiftCache();
+
+public:
+    // Key
+    // Get the key of the function, its attributes and flags are already set
+    std::string getKey(unknown::ArrayRef<uint8_t> Bytes, uint64_t Address, const uir::Function &F) const;
+
+public:
+    // Load/Store
+    // Load the body of the function, false if it is not in the cache
+    bool load(const std::string &Key, uir::Function *F) const;
+
+    // Store the body of the function, a body that references globals or other functions is not stored
+    bool store(const std::string &Key, const uir::Function &F) const;
+
+public:
+    // Pruning
+    // Set the pruning policy, see unknown::parseCachePruningPolicy. false if the policy is not valid
+    bool setPruningPolicy(const std::string &Policy);
+
+    // Prune the cache directory by the pruning policy
+    void prune() const;
+
+public:
+    // Get/Set
+    // Get the cache directory
+    const std::string &getCacheDirectory() const;
+
+private:
+    // Get the path of the entry, pruneCache only considers the files named "llvmcache-*"
+    std::string getEntryPath(const std::string &Key) const;
+};
+
+} // namespace ufrontend
@@ -0,0 +1,321 @@
+#include "PEImage.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <UnknownUtils/unknown/Support/Endian.h>
+
+namespace ufrontend {
+
+PEImage::PEImage(const std::string &ImageFilePath) :
+    mImageFilePath(ImageFilePath), mImageBase(0), mIs64Bit(false), mDataDirectories{}
+{
+    assert(!ImageFilePath.empty());
+}
+
+PEImage::~PEImage()
+{
+    //
+}
+
+// Parse
+bool
+PEImage::ParseImage()
+{
+    using namespace unknown::support::endian;
+
+    mSections.clear();
+
+    if (mImageFilePath.empty())
+    {
+        return false;
+    }
+
+    // Map the image once, it is never copied
+    auto BufferOrErr = unknown::MemoryBuffer::getFile(mImageFilePath, -1, false);
+    if (!BufferOrErr)
+    {
+        return false;
+    }
+    mImageBuffer = std::move(*BufferOrErr);
+
+    auto Data = reinterpret_cast<const uint8_t *>(mImageBuffer->getBufferStart());
+    uint64_t DataSize = mImageBuffer->getBufferSize();
+
+    // DOS header
+    if (DataSize < 0x40 || Data[0] != 'M' || Data[1] != 'Z')
+    {
+        return false;
+    }
+
+    // NT headers
+    uint64_t NtOffset = read32le(Data + 0x3C);
+    if (NtOffset + 24 > DataSize || std::memcmp(Data + NtOffset, "PE\0\0", 4) != 0)
+    {
+        return false;
+    }
+
+    // File header
+    const uint8_t *FileHeader = Data + NtOffset + 4;
+    uint32_t NumberOfSections = read16le(FileHeader + 2);
+    uint32_t SizeOfOptionalHeader = read16le(FileHeader + 16);
+
+    // Optional header
+    uint64_t OptionalOffset = NtOffset + 24;
+    if (OptionalOffset + SizeOfOptionalHeader > DataSize || SizeOfOptionalHeader < 2)
+    {
+        return false;
+    }
+
+    const uint8_t *OptionalHeader = Data + OptionalOffset;
+    uint16_t Magic = read16le(OptionalHeader);
+    if (Magic != 0x10B && Magic != 0x20B)
+    {
+        return false;
+    }
+    mIs64Bit = Magic == 0x20B;
+
+    uint32_t NumberOfRvaAndSizesOffset = mIs64Bit ? 108 : 92;
+    if (SizeOfOptionalHeader < NumberOfRvaAndSizesOffset + 4)
+    {
+        return false;
+    }
+    mImageBase = mIs64Bit ? read64le(OptionalHeader + 24) : read32le(OptionalHeader + 28);
+
+    // Data directories
+    uint32_t NumberOfRvaAndSizes = read32le(OptionalHeader + NumberOfRvaAndSizesOffset);
+    NumberOfRvaAndSizes = std::min<uint32_t>(NumberOfRvaAndSizes, NUMBER_OF_DATA_DIRECTORIES);
+    NumberOfRvaAndSizes =
+        std::min<uint32_t>(NumberOfRvaAndSizes, (SizeOfOptionalHeader - NumberOfRvaAndSizesOffset - 4) / 8);
+    for (uint32_t i = 0; i < NumberOfRvaAndSizes; ++i)
+    {
+        const uint8_t *Dir = OptionalHeader + NumberOfRvaAndSizesOffset + 4 + i * 8;
+        mDataDirectories[i].RelativeVirtualAddress = read32le(Dir);
+        mDataDirectories[i].Size = read32le(Dir + 4);
+    }
+
+    // Sections
+    return ParseSections(OptionalOffset + SizeOfOptionalHeader, NumberOfSections);
+}
+
+bool
+PEImage::ParseSections(uint64_t Offset, uint32_t NumberOfSections)
+{
+    using namespace unknown::support::endian;
+
+    auto Data = reinterpret_cast<const uint8_t *>(mImageBuffer->getBufferStart());
+    uint64_t DataSize = mImageBuffer->getBufferSize();
+    if (Offset + NumberOfSections * 40ull > DataSize)
+    {
+        return false;
+    }
+
+    mSections.reserve(NumberOfSections);
+    for (uint32_t i = 0; i < NumberOfSections; ++i)
+    {
+        const uint8_t *Header = Data + Offset + i * 40ull;
+
+        Section Sec{};
+        Sec.Name = unknown::StringRef(reinterpret_cast<const char *>(Header), strnlen((const char *)Header, 8)).str();
+        Sec.VirtualSize = read32le(Header + 8);
+        Sec.VirtualAddress = mImageBase + read32le(Header + 12);
+        Sec.SizeOfRawData = read32le(Header + 16);
+        Sec.PointerToRawData = read32le(Header + 20);
+
+        // Clip the raw data to the mapped file
+        if (Sec.PointerToRawData >= DataSize)
+        {
+            Sec.SizeOfRawData = 0;
+        }
+        else if (Sec.PointerToRawData + static_cast<uint64_t>(Sec.SizeOfRawData) > DataSize)
+        {
+            Sec.SizeOfRawData = static_cast<uint32_t>(DataSize - Sec.PointerToRawData);
+        }
+
+        mSections.push_back(Sec);
+    }
+
+    // The interval table is sorted by virtual address
+    std::sort(mSections.begin(), mSections.end(), [](const Section &LHS, const Section &RHS) {
+        return LHS.VirtualAddress < RHS.VirtualAddress;
+    });
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+// Get/Set
+// Get the image file path
+const std::string &
+PEImage::getImageFilePath() const
+{
+    return mImageFilePath;
+}
+
+// Get the image base
+uint64_t
+PEImage::getImageBase() const
+{
+    return mImageBase;
+}
+
+// Is this a PE32+ image?
+bool
+PEImage::is64Bit() const
+{
+    return mIs64Bit;
+}
+
+// Get the sections sorted by virtual address
+const std::vector<PEImage::Section> &
+PEImage::getSections() const
+{
+    return mSections;
+}
+
+// Get the data directory by index
+const PEImage::DataDirectory &
+PEImage::getDataDirectory(DataDirectoryIndex Index) const
+{
+    assert(Index < NUMBER_OF_DATA_DIRECTORIES);
+    return mDataDirectories[Index];
+}
+
+////////////////////////////////////////////////////////////
+// Address
+// Get the section containing the virtual address
+const PEImage::Section *
+PEImage::getSection(uint64_t Address) const
+{
+    // Find the last section beginning at or before the address
+    auto It = std::upper_bound(
+        mSections.begin(), mSections.end(), Address, [](uint64_t Address, const Section &Sec) {
+            return Address < Sec.VirtualAddress;
+        });
+    if (It == mSections.begin())
+    {
+        return nullptr;
+    }
+    --It;
+
+    uint64_t SectionSize = std::max(It->VirtualSize, It->SizeOfRawData);
+    if (Address >= It->VirtualAddress + SectionSize)
+    {
+        return nullptr;
+    }
+
+    return &*It;
+}
+
+// Get the end virtual address of the raw data of the section containing the virtual address
+uint64_t
+PEImage::getSectionEnd(uint64_t Address) const
+{
+    auto Sec = getSection(Address);
+    if (Sec == nullptr)
+    {
+        return 0;
+    }
+
+    return Sec->VirtualAddress + Sec->SizeOfRawData;
+}
+
+// Get the read-only bytes of [Address, MaxAddress), the range is clipped to the section containing Address
+unknown::ArrayRef<uint8_t>
+PEImage::getBytes(uint64_t Address, uint64_t MaxAddress) const
+{
+    auto Sec = getSection(Address);
+    if (Sec == nullptr)
+    {
+        return {};
+    }
+
+    uint64_t RawEnd = Sec->VirtualAddress + Sec->SizeOfRawData;
+    MaxAddress = std::min(MaxAddress, RawEnd);
+    if (MaxAddress <= Address)
+    {
+        return {};
+    }
+
+    auto Data = reinterpret_cast<const uint8_t *>(mImageBuffer->getBufferStart());
+    return unknown::ArrayRef<uint8_t>(
+        Data + Sec->PointerToRawData + (Address - Sec->VirtualAddress), static_cast<size_t>(MaxAddress - Address));
+}
+
+// Get the read-only bytes of [Address, Address + Size) without clipping
+unknown::ArrayRef<uint8_t>
+PEImage::getBytesExact(uint64_t Address, uint64_t Size) const
+{
+    auto Bytes = getBytes(Address, Address + Size);
+    if (Bytes.size() != Size)
+    {
+        return {};
+    }
+
+    return Bytes;
+}
+
+// Get the read-only bytes of the data directory
+unknown::ArrayRef<uint8_t>
+PEImage::getDataDirectoryBytes(DataDirectoryIndex Index) const
+{
+    auto &Dir = getDataDirectory(Index);
+    if (Dir.RelativeVirtualAddress == 0 || Dir.Size == 0)
+    {
+        return {};
+    }
+
+    return getBytesExact(mImageBase + Dir.RelativeVirtualAddress, Dir.Size);
+}
+
+////////////////////////////////////////////////////////////
+// Exception
+// Get the RUNTIME_FUNCTION entries of a PE32+ image sorted by BeginAddress, empty if there is no .pdata
+std::vector<PEImage::RuntimeFunction>
+PEImage::getRuntimeFunctions() const
+{
+    using namespace unknown::support::endian;
+
+    // The exception table of a PE32 image is not made of RUNTIME_FUNCTION
+    if (!mIs64Bit)
+    {
+        return {};
+    }
+
+    auto Bytes = getDataDirectoryBytes(EXCEPTION_TABLE);
+    std::vector<RuntimeFunction> RuntimeFunctions;
+    RuntimeFunctions.reserve(Bytes.size() / 12);
+    for (size_t Offset = 0; Offset + 12 <= Bytes.size(); Offset += 12)
+    {
+        RuntimeFunction RF{};
+        RF.BeginAddress = read32le(Bytes.data() + Offset);
+        RF.EndAddress = read32le(Bytes.data() + Offset + 4);
+        RF.UnwindInfoAddress = read32le(Bytes.data() + Offset + 8);
+        if (RF.BeginAddress == 0 || RF.EndAddress <= RF.BeginAddress)
+        {
+            continue;
+        }
+
+        // UNWIND_INFO: Version:3, Flags:5, UNW_FLAG_CHAININFO is 0x4
+        if ((RF.UnwindInfoAddress & 1) == 0)
+        {
+            auto UnwindInfo = getBytesExact(mImageBase + RF.UnwindInfoAddress, 1);
+            RF.Chained = !UnwindInfo.empty() && ((UnwindInfo[0] >> 3) & 0x4);
+        }
+
+        RuntimeFunctions.push_back(RF);
+    }
+
+    // The linker sorts the table, but it is not trusted
+    auto ByBeginAddress = [](const RuntimeFunction &LHS, const RuntimeFunction &RHS) {
+        return LHS.BeginAddress < RHS.BeginAddress;
+    };
+    if (!std::is_sorted(RuntimeFunctions.begin(), RuntimeFunctions.end(), ByBeginAddress))
+    {
+        std::sort(RuntimeFunctions.begin(), RuntimeFunctions.end(), ByBeginAddress);
+    }
+
+    return RuntimeFunctions;
+}
+
+} // namespace ufrontend
@@ -0,0 +1,120 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <UnknownUtils/unknown/ADT/ArrayRef.h>
+#include <UnknownUtils/unknown/ADT/StringRef.h>
+#include <UnknownUtils/unknown/Support/MemoryBuffer.h>
+
+namespace ufrontend {
+
+// A read-only view of a PE image that is mapped into memory once
+class PEImage
+{
+public:
+    // The index of the data directory
+    enum DataDirectoryIndex : uint32_t
+    {
+        EXPORT_TABLE = 0,
+        IMPORT_TABLE = 1,
+        RESOURCE_TABLE = 2,
+        EXCEPTION_TABLE = 3,
+        CERTIFICATE_TABLE = 4,
+        BASE_RELOCATION_TABLE = 5,
+        DEBUG_DIRECTORY = 6,
+        NUMBER_OF_DATA_DIRECTORIES = 16
+    };
+
+    struct DataDirectory
+    {
+        uint32_t RelativeVirtualAddress = 0;
+        uint32_t Size = 0;
+    };
+
+    struct Section
+    {
+        std::string Name;
+        uint64_t VirtualAddress = 0;
+        uint32_t VirtualSize = 0;
+        uint32_t SizeOfRawData = 0;
+        uint32_t PointerToRawData = 0;
+    };
+
+    // An entry of the x64 exception table, the addresses are relative to the image base
+    struct RuntimeFunction
+    {
+        uint32_t BeginAddress = 0;
+        uint32_t EndAddress = 0;
+        uint32_t UnwindInfoAddress = 0;
+
+        // The unwind info is chained to the one of a previous entry, the entry is a part of that function
+        bool Chained = false;
+    };
+
+private:
+    std::string mImageFilePath;
+    std::unique_ptr<unknown::MemoryBuffer> mImageBuffer;
+    uint64_t mImageBase;
+    bool mIs64Bit;
+    DataDirectory mDataDirectories[NUMBER_OF_DATA_DIRECTORIES];
+
+    // Sorted by VirtualAddress
+    std::vector<Section> mSections;
+
+public:
+    PEImage(const std::string &ImageFilePath);
+    virtual ~PEImage();
+
+public:
+    // Parse
+    bool ParseImage();
+
+private:
+    // Parse
+    bool ParseSections(uint64_t Offset, uint32_t NumberOfSections);
+
+public:
+    // Get/Set
+    // Get the image file path
+    const std::string &getImageFilePath() const;
+
+    // Get the image base
+    uint64_t getImageBase() const;
+
+    // Is this a PE32+ image?
+    bool is64Bit() const;
+
+    // Get the sections sorted by virtual address
+    const std::vector<Section> &getSections() const;
+
+    // Get the data directory by index
+    const DataDirectory &getDataDirectory(DataDirectoryIndex Index) const;
+
+public:
+    // Address
+    // Get the section containing the virtual address
+    const Section *getSection(uint64_t Address) const;
+
+    // Get the end virtual address of the raw data of the section containing the virtual address
+    uint64_t getSectionEnd(uint64_t Address) const;
+
+    // Get the read-only bytes of [Address, MaxAddress), the range is clipped to the section containing Address
+    unknown::ArrayRef<uint8_t> getBytes(uint64_t Address, uint64_t MaxAddress) const;
+
+    // Get the read-only bytes of [Address, Address + Size) without clipping
+    unknown::ArrayRef<uint8_t> getBytesExact(uint64_t Address, uint64_t Size) const;
+
+    // Get the read-only bytes of the data directory
+    unknown::ArrayRef<uint8_t> getDataDirectoryBytes(DataDirectoryIndex Index) const;
+
+public:
+    // Exception
+    // Get the RUNTIME_FUNCTION entries of a PE32+ image sorted by BeginAddress, empty if there is no .pdata
+    std::vector<RuntimeFunction> getRuntimeFunctions() const;
+};
+
+} // namespace ufrontend
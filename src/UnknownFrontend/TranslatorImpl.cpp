@@ -3,6 +3,11 @@
 
 namespace ufrontend {
 
+thread_local unknown::SmallVector<
+    std::pair<const UnknownFrontendTranslatorImpl *, UnknownFrontendTranslatorImpl::LiftingContext *>,
+    2>
+    UnknownFrontendTranslatorImpl::sBoundLiftingContexts;
+
 UnknownFrontendTranslatorImpl::UnknownFrontendTranslatorImpl(
     uir::Context &C,
     const Platform Platform,
@@ -16,10 +21,7 @@ UnknownFrontendTranslatorImpl::UnknownFrontendTranslatorImpl(
     mSymbolFile(SymbolFile),
     mConfigFile(ConfigFile),
     mEnableAnalyzeAllFunctions(AnalyzeAllFunctions),
-    mCapstoneHandle(0),
-    mCurPtrBegin(0),
-    mCurPtrEnd(0),
-    mCurFunction(nullptr)
+    mThreadCount(1)
 {
     switch (C.getArch())
     {
@@ -39,8 +41,75 @@ UnknownFrontendTranslatorImpl::~UnknownFrontendTranslatorImpl()
 {
     closeCapstoneHandle();
 
-    // Clear mVirtualRegisterInfoMap
-    for (auto &Item : mVirtualRegisterInfoMap)
+    // Clear the register state
+    resetLiftingContext(mLiftingContext);
+}
+
+////////////////////////////////////////////////////////////
+// Init
+// Init the translator
+void
+UnknownFrontendTranslatorImpl::initTranslator()
+{
+    initConfig();
+    openCapstoneHandle();
+    initSymbolParser();
+    initBinary();
+    initTranslateInstruction();
+}
+
+////////////////////////////////////////////////////////////
+// Lifting context
+// Get the lifting context of the calling thread
+UnknownFrontendTranslatorImpl::LiftingContext &
+UnknownFrontendTranslatorImpl::getLiftingContext()
+{
+    for (auto &[Owner, LC] : sBoundLiftingContexts)
+    {
+        if (Owner == this)
+        {
+            return *LC;
+        }
+    }
+    return mLiftingContext;
+}
+
+const UnknownFrontendTranslatorImpl::LiftingContext &
+UnknownFrontendTranslatorImpl::getLiftingContext() const
+{
+    return const_cast<UnknownFrontendTranslatorImpl *>(this)->getLiftingContext();
+}
+
+// Bind the lifting context of this translator to the calling thread, nullptr restores mLiftingContext
+void
+UnknownFrontendTranslatorImpl::bindLiftingContext(LiftingContext *LC)
+{
+    auto It = std::find_if(sBoundLiftingContexts.begin(), sBoundLiftingContexts.end(), [this](const auto &Item) {
+        return Item.first == this;
+    });
+
+    if (LC == nullptr)
+    {
+        if (It != sBoundLiftingContexts.end())
+        {
+            sBoundLiftingContexts.erase(It);
+        }
+    }
+    else if (It != sBoundLiftingContexts.end())
+    {
+        It->second = LC;
+    }
+    else
+    {
+        sBoundLiftingContexts.push_back({this, LC});
+    }
+}
+
+// Release the register and basic block state of the lifting context
+void
+UnknownFrontendTranslatorImpl::resetLiftingContext(LiftingContext &LC)
+{
+    for (auto &Item : LC.VirtualRegisterInfoMap)
     {
         auto &VParentRegInfo = Item.second;
 
@@ -53,26 +122,35 @@ UnknownFrontendTranslatorImpl::~UnknownFrontendTranslatorImpl()
                 VRegInfo.RegPtr = nullptr;
             }
 
-            if (VRegInfo.SavedRegVal != nullptr && VRegInfo.SavedRegVal->user_empty())
-            {
-                delete VRegInfo.SavedRegVal;
-                VRegInfo.SavedRegVal = nullptr;
-            }
+            // The saved value is an instruction of a block or a constant, it is not owned by the context
+            VRegInfo.SavedRegVal = nullptr;
         }
     }
+
+    LC.VirtualRegisterInfoMap.clear();
+    LC.RegisterCounterMap.clear();
+
+    LC.FunctionBegin = 0;
+    LC.FunctionEnd = 0;
+    LC.BasicBlockMap.clear();
+    LC.PendingBasicBlocks.clear();
+    LC.TranslatedBasicBlockMap.clear();
+    LC.ExitBasicBlocks.clear();
+    LC.InstructionBegins.clear();
 }
 
-////////////////////////////////////////////////////////////
-// Init
-// Init the translator
+// Drop the values of the registers saved in the previous basic block, the next one loads them again
 void
-UnknownFrontendTranslatorImpl::initTranslator()
+UnknownFrontendTranslatorImpl::dropSavedRegisterValues()
 {
-    initConfig();
-    openCapstoneHandle();
-    initSymbolParser();
-    initBinary();
-    initTranslateInstruction();
+    for (auto &Item : getLiftingContext().VirtualRegisterInfoMap)
+    {
+        for (auto &VRegInfoItem : Item.second)
+        {
+            VRegInfoItem.second.SavedRegVal = nullptr;
+            VRegInfoItem.second.IsUpdated = false;
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////
@@ -130,56 +208,56 @@ UnknownFrontendTranslatorImpl::getConfigFile() const
 csh
 UnknownFrontendTranslatorImpl::getCapstoneHandle() const
 {
-    return mCapstoneHandle;
+    return getLiftingContext().CapstoneHandle;
 }
 
 // Set the capstone handle
 void
 UnknownFrontendTranslatorImpl::setCapstoneHandle(csh CapstoneHandle)
 {
-    mCapstoneHandle = CapstoneHandle;
+    getLiftingContext().CapstoneHandle = CapstoneHandle;
 }
 
 // Get the begin of current pointer
 const uint64_t
 UnknownFrontendTranslatorImpl::getCurPtrBegin() const
 {
-    return mCurPtrBegin;
+    return getLiftingContext().CurPtrBegin;
 }
 
 // Get the end of current pointer
 const uint64_t
 UnknownFrontendTranslatorImpl::getCurPtrEnd() const
 {
-    return mCurPtrEnd;
+    return getLiftingContext().CurPtrEnd;
 }
 
 // Set the begin of current pointer
 void
 UnknownFrontendTranslatorImpl::setCurPtrBegin(uint64_t Ptr)
 {
-    mCurPtrBegin = Ptr;
+    getLiftingContext().CurPtrBegin = Ptr;
 }
 
 // Set the end of current pointer
 void
 UnknownFrontendTranslatorImpl::setCurPtrEnd(uint64_t Ptr)
 {
-    mCurPtrEnd = Ptr;
+    getLiftingContext().CurPtrEnd = Ptr;
 }
 
 // Get the current function
 const uir::Function *
 UnknownFrontendTranslatorImpl::getCurFunction() const
 {
-    return mCurFunction;
+    return getLiftingContext().CurFunction;
 }
 
 // Set the current function
 void
 UnknownFrontendTranslatorImpl::setCurFunction(uir::Function *Function)
 {
-    mCurFunction = Function;
+    getLiftingContext().CurFunction = Function;
 }
 
 // Get the platform
@@ -210,6 +288,58 @@ UnknownFrontendTranslatorImpl::setEnableAnalyzeAllFunctions(bool Set)
     mEnableAnalyzeAllFunctions = Set;
 }
 
+// Get the number of threads used by translateBinary
+const uint32_t
+UnknownFrontendTranslatorImpl::getThreadCount() const
+{
+    return mThreadCount;
+}
+
+// Set the number of threads used by translateBinary
+void
+UnknownFrontendTranslatorImpl::setThreadCount(uint32_t ThreadCount)
+{
+    mThreadCount = ThreadCount;
+}
+
+// Get the directory of the lift cache
+const std::string &
+UnknownFrontendTranslatorImpl::getLiftCacheDirectory() const
+{
+    return mLiftCacheDirectory;
+}
+
+// Set the directory of the lift cache and its pruning policy
+void
+UnknownFrontendTranslatorImpl::setLiftCacheDirectory(const std::string &CacheDirectory, const std::string &PruningPolicy)
+{
+    mLiftCacheDirectory = CacheDirectory;
+    mLiftCache.reset();
+
+    if (!CacheDirectory.empty())
+    {
+        mLiftCache = std::make_unique<LiftCache>(getContext(), CacheDirectory);
+        if (!PruningPolicy.empty())
+        {
+            mLiftCache->setPruningPolicy(PruningPolicy);
+        }
+    }
+}
+
+// Get the directory of the PDB symbol index
+const std::string &
+UnknownFrontendTranslatorImpl::getSymbolIndexDirectory() const
+{
+    return mSymbolIndexDirectory;
+}
+
+// Set the directory of the PDB symbol index
+void
+UnknownFrontendTranslatorImpl::setSymbolIndexDirectory(const std::string &IndexDirectory)
+{
+    mSymbolIndexDirectory = IndexDirectory;
+}
+
 ////////////////////////////////////////////////////////////
 // Register
 // Get the register name with index by register id
@@ -238,7 +368,7 @@ UnknownFrontendTranslatorImpl::getRegisterNameWithIndex(unknown::StringRef RegNa
 std::string
 UnknownFrontendTranslatorImpl::getRegisterNameWithIndexByDefault(uint32_t RegID)
 {
-    return getRegisterNameWithIndex(RegID, mRegisterCounterMap[RegID]++);
+    return getRegisterNameWithIndex(RegID, getLiftingContext().RegisterCounterMap[RegID]++);
 }
 
 // Get the register name with index by default by name
@@ -246,7 +376,7 @@ std::string
 UnknownFrontendTranslatorImpl::getRegisterNameWithIndexByDefault(unknown::StringRef RegName)
 {
     auto RegID = getRegisterID(RegName.str());
-    return getRegisterNameWithIndex(RegName, mRegisterCounterMap[RegID]++);
+    return getRegisterNameWithIndex(RegName, getLiftingContext().RegisterCounterMap[RegID]++);
 }
 
 // Get the virtual register information by register id
@@ -281,8 +411,9 @@ UnknownFrontendTranslatorImpl::getVirtualRegisterInfo(uint32_t RegID)
             Map.insert({VRegInfo.VirtualRegID, VRegInfo});
         };
 
-    auto ItFindParentRegID = mVirtualRegisterInfoMap.find(ParentRegID);
-    if (ItFindParentRegID != mVirtualRegisterInfoMap.end())
+    auto &VirtualRegisterInfoMap = getLiftingContext().VirtualRegisterInfoMap;
+    auto ItFindParentRegID = VirtualRegisterInfoMap.find(ParentRegID);
+    if (ItFindParentRegID != VirtualRegisterInfoMap.end())
     {
         // Already exists
         auto ItFindVRegID = ItFindParentRegID->second.find(VRegID);
@@ -299,10 +430,10 @@ UnknownFrontendTranslatorImpl::getVirtualRegisterInfo(uint32_t RegID)
         // [ParentID, [VRegID, VRegInfo]]
         std::unordered_map<uint32_t, VirtualRegisterInfo> VMap;
         insertVRegInfo2Map(RegID, VRegID, VMap);
-        mVirtualRegisterInfoMap.insert({ParentRegID, VMap});
+        VirtualRegisterInfoMap.insert({ParentRegID, VMap});
     }
 
-    return &mVirtualRegisterInfoMap[ParentRegID];
+    return &VirtualRegisterInfoMap[ParentRegID];
 }
 
 } // namespace ufrontend
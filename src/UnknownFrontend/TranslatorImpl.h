@@ -1,11 +1,17 @@
 #pragma once
 #include <capstone/capstone.h>
 
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include <UnknownUtils/unknown/ADT/SmallVector.h>
 #include <UnknownUtils/unknown/Target/Target.h>
 
 #include <UnknownFrontend/UnknownFrontend.h>
 
 #include "ConfigReader.h"
+#include "LiftCache.h"
 
 namespace ufrontend {
 
@@ -22,11 +28,48 @@ protected:
         uir::Value *RegPtr = nullptr;
         uir::Value *SavedRegVal = nullptr;
     };
-    // [ParentID, [VRegID, VRegInfo]]
-    std::unordered_map<uint32_t, std::unordered_map<uint32_t, VirtualRegisterInfo>> mVirtualRegisterInfoMap;
+    // The state of lifting one function, every worker of translateBinary owns one
+    struct LiftingContext
+    {
+        // [ParentID, [VRegID, VRegInfo]]
+        std::unordered_map<uint32_t, std::unordered_map<uint32_t, VirtualRegisterInfo>> VirtualRegisterInfoMap;
+
+        // [RegID, Counter]
+        std::unordered_map<uint32_t, uint32_t> RegisterCounterMap;
+
+        // The capstone handle and the instruction reused by cs_disasm_iter
+        csh CapstoneHandle = 0;
+        cs_insn *CapstoneInsn = nullptr;
+
+        uint64_t CurPtrBegin = 0;
+        uint64_t CurPtrEnd = 0;
+
+        uir::Function *CurFunction = nullptr;
+
+        // The basic blocks of the current function by their begin address, the pending ones are not translated yet.
+        // Only the branch targets in [FunctionBegin, FunctionEnd) get a basic block
+        uint64_t FunctionBegin = 0;
+        uint64_t FunctionEnd = 0;
+        std::map<uint64_t, uir::BasicBlock *> BasicBlockMap;
+        std::vector<uir::BasicBlock *> PendingBasicBlocks;
+
+        // The translated basic blocks by their begin address, a pending block is split from the one containing it
+        std::map<uint64_t, uir::BasicBlock *> TranslatedBasicBlockMap;
+
+        // The blocks jumping out of the function for the conditional branches with one target in it
+        std::vector<uir::BasicBlock *> ExitBasicBlocks;
+
+        // Does a translated instruction begin at FunctionBegin + Index? A block is only split at one
+        std::vector<bool> InstructionBegins;
+    };
+
+    // The lifting context of the calling thread if no worker context is bound
+    LiftingContext mLiftingContext;
 
-    // [RegID, Counter]
-    std::unordered_map<uint32_t, uint32_t> mRegisterCounterMap;
+    // The lifting contexts bound to the calling worker thread by their translators, a worker lifting for one translator
+    // can call into another one
+    static thread_local unknown::SmallVector<std::pair<const UnknownFrontendTranslatorImpl *, LiftingContext *>, 2>
+        sBoundLiftingContexts;
 
 protected:
     Platform mPlatform;
@@ -35,21 +78,19 @@ protected:
     std::string mSymbolFile;
     std::string mConfigFile;
     bool mEnableAnalyzeAllFunctions;
-
-protected:
-    csh mCapstoneHandle;
-
-protected:
-    uint64_t mCurPtrBegin;
-    uint64_t mCurPtrEnd;
-
-protected:
-    uir::Function *mCurFunction;
+    uint32_t mThreadCount;
 
 protected:
     std::unique_ptr<unknown::Target> mTarget;
     std::unique_ptr<ufrontend::ConfigReader> mConfigReader;
 
+    // The lifted functions are loaded from the cache if their bytes and attributes didn't change
+    std::string mLiftCacheDirectory;
+    std::unique_ptr<ufrontend::LiftCache> mLiftCache;
+
+    // The parsed symbols of the PDB are loaded from the index if the PDB didn't change
+    std::string mSymbolIndexDirectory;
+
 public:
     UnknownFrontendTranslatorImpl(
         uir::Context &C,
@@ -67,9 +108,25 @@ public:
 
 protected:
     // Capstone
+    // Open/Close the capstone handle of the current lifting context
     virtual void openCapstoneHandle() {}
     virtual void closeCapstoneHandle() {}
 
+protected:
+    // Lifting context
+    // Get the lifting context of the calling thread
+    LiftingContext &getLiftingContext();
+    const LiftingContext &getLiftingContext() const;
+
+    // Bind the lifting context of this translator to the calling thread, nullptr restores mLiftingContext
+    void bindLiftingContext(LiftingContext *LC);
+
+    // Release the register and basic block state of the lifting context
+    void resetLiftingContext(LiftingContext &LC);
+
+    // Drop the values of the registers saved in the previous basic block, the next one loads them again
+    void dropSavedRegisterValues();
+
 protected:
     // Symbol Parser
     virtual void initSymbolParser() {}
@@ -168,6 +225,25 @@ public:
     // Set EnableAnalyzeAllFunctions
     virtual void setEnableAnalyzeAllFunctions(bool Set) override;
 
+    // Get the number of threads used by translateBinary
+    virtual const uint32_t getThreadCount() const override;
+
+    // Set the number of threads used by translateBinary
+    virtual void setThreadCount(uint32_t ThreadCount) override;
+
+    // Get the directory of the lift cache
+    virtual const std::string &getLiftCacheDirectory() const override;
+
+    // Set the directory of the lift cache and its pruning policy
+    virtual void
+    setLiftCacheDirectory(const std::string &CacheDirectory, const std::string &PruningPolicy = "") override;
+
+    // Get the directory of the PDB symbol index
+    virtual const std::string &getSymbolIndexDirectory() const override;
+
+    // Set the directory of the PDB symbol index
+    virtual void setSymbolIndexDirectory(const std::string &IndexDirectory) override;
+
 protected:
     // Register
     // Get the register name by register id
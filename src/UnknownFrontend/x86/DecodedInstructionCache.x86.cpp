@@ -0,0 +1,142 @@
+#include "DecodedInstructionCache.x86.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace ufrontend {
+
+DecodedInstructionCacheX86::DecodedInstructionCacheX86(size_t MemoryBudget) :
+    mMemoryBudget(MemoryBudget), mMemoryUsed(0)
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Lookup/Insert
+// Restore the instruction decoded at the address into Insn, false if it is not in the cache or its bytes differ
+bool
+DecodedInstructionCacheX86::lookup(uint64_t Address, unknown::ArrayRef<uint8_t> Bytes, cs_insn *Insn) const
+{
+    assert(Insn);
+
+    const DecodedInstruction *Record = nullptr;
+    {
+        auto &S = getShard(Address);
+        std::shared_lock<std::shared_mutex> Lock(S.Mutex);
+        auto It = S.Map.find(Address);
+        if (It == S.Map.end())
+        {
+            return false;
+        }
+        Record = It->second;
+    }
+
+    // The records are never changed or freed, the bytes tell if the same instruction is decoded at the address
+    if (Bytes.size() < Record->Size || std::memcmp(Bytes.data(), Record->Bytes, Record->Size) != 0)
+    {
+        return false;
+    }
+
+    Insn->id = Record->Id;
+    Insn->address = Address;
+    Insn->size = Record->Size;
+    std::memcpy(Insn->bytes, Record->Bytes, Record->Size);
+    std::memcpy(Insn->mnemonic, Record->Mnemonic, std::strlen(Record->Mnemonic) + 1);
+    std::memcpy(Insn->op_str, Record->OpStr, std::strlen(Record->OpStr) + 1);
+
+    if (Insn->detail)
+    {
+        Insn->detail->regs_read_count = 0;
+        Insn->detail->regs_write_count = 0;
+        Insn->detail->groups_count = 0;
+        std::memcpy(&Insn->detail->x86, Record + 1, Record->DetailSize);
+    }
+
+    return true;
+}
+
+// Insert the decoded instruction, the record of other bytes at its address is replaced.
+// False if it is already in the cache or the memory budget is used up
+bool
+DecodedInstructionCacheX86::insert(const cs_insn *Insn)
+{
+    assert(Insn);
+
+    if (Insn->size > sizeof(DecodedInstruction::Bytes))
+    {
+        return false;
+    }
+
+    // Only the operands in use are kept
+    size_t DetailSize = 0;
+    if (Insn->detail)
+    {
+        DetailSize = offsetof(cs_x86, operands) + Insn->detail->x86.op_count * sizeof(cs_x86_op);
+    }
+
+    size_t MnemonicSize = std::strlen(Insn->mnemonic) + 1;
+    size_t OpStrSize = std::strlen(Insn->op_str) + 1;
+    size_t RecordSize = sizeof(DecodedInstruction) + DetailSize + MnemonicSize + OpStrSize;
+
+    if (mMemoryUsed.fetch_add(RecordSize) + RecordSize > mMemoryBudget)
+    {
+        mMemoryUsed -= RecordSize;
+        return false;
+    }
+
+    auto &S = getShard(Insn->address);
+    std::unique_lock<std::shared_mutex> Lock(S.Mutex);
+
+    // The bytes at the address change if the code is patched or the cache outlives the image
+    auto &Slot = S.Map[Insn->address];
+    if (Slot != nullptr && Slot->Size == Insn->size && std::memcmp(Slot->Bytes, Insn->bytes, Insn->size) == 0)
+    {
+        mMemoryUsed -= RecordSize;
+        return false;
+    }
+
+    auto Memory = static_cast<uint8_t *>(S.Arena.Allocate(RecordSize, alignof(DecodedInstruction)));
+    auto Record = new (Memory) DecodedInstruction();
+    Record->Id = Insn->id;
+    Record->Size = Insn->size;
+    Record->DetailSize = static_cast<uint16_t>(DetailSize);
+    std::memcpy(Record->Bytes, Insn->bytes, Insn->size);
+
+    auto Detail = Memory + sizeof(DecodedInstruction);
+    if (DetailSize)
+    {
+        std::memcpy(Detail, &Insn->detail->x86, DetailSize);
+    }
+
+    auto Mnemonic = reinterpret_cast<char *>(Detail + DetailSize);
+    std::memcpy(Mnemonic, Insn->mnemonic, MnemonicSize);
+    Record->Mnemonic = Mnemonic;
+
+    auto OpStr = Mnemonic + MnemonicSize;
+    std::memcpy(OpStr, Insn->op_str, OpStrSize);
+    Record->OpStr = OpStr;
+
+    Slot = Record;
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+// Get/Set
+// Get the memory budget of the records
+size_t
+DecodedInstructionCacheX86::getMemoryBudget() const
+{
+    return mMemoryBudget;
+}
+
+// Get the memory used by the records
+size_t
+DecodedInstructionCacheX86::getMemoryUsed() const
+{
+    return mMemoryUsed;
+}
+
+} // namespace ufrontend
@@ -0,0 +1,82 @@
+#pragma once
+#include <capstone/capstone.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+
+#include <UnknownUtils/unknown/ADT/ArrayRef.h>
+#include <UnknownUtils/unknown/ADT/DenseMap.h>
+#include <UnknownUtils/unknown/Support/Allocator.h>
+
+namespace ufrontend {
+
+// The x86 instructions decoded by capstone with their details, shared by the lifting threads of one binary and keyed by
+// their address. A record only keeps the used operands of the details and is restored into a cs_insn, the implicit
+// registers and the groups are not kept. The records live in the arenas of the shards as long as the cache, a replaced
+// one too, so a lookup can read it without the lock. Nothing is inserted once the memory budget is used up.
+class DecodedInstructionCacheX86
+{
+public:
+    static constexpr size_t DefaultMemoryBudget = 64 * 1024 * 1024;
+
+private:
+    // A decoded instruction, it is followed by DetailSize bytes of its cs_x86, the mnemonic and the operand string
+    struct DecodedInstruction
+    {
+        uint32_t Id = 0;
+        uint16_t Size = 0;
+        uint16_t DetailSize = 0;
+        uint8_t Bytes[16] = {};
+        const char *Mnemonic = nullptr;
+        const char *OpStr = nullptr;
+    };
+
+    struct Shard
+    {
+        mutable std::shared_mutex Mutex;
+        unknown::DenseMap<uint64_t, const DecodedInstruction *> Map;
+        unknown::BumpPtrAllocator Arena;
+    };
+    static constexpr size_t NumShards = 16;
+    std::array<Shard, NumShards> mShards;
+
+    size_t mMemoryBudget;
+    std::atomic<size_t> mMemoryUsed;
+
+public:
+    explicit DecodedInstructionCacheX86(size_t MemoryBudget = DefaultMemoryBudget);
+
+public:
+    // Lookup/Insert
+    // Restore the instruction decoded at the address into Insn, false if it is not in the cache or its bytes differ
+    bool lookup(uint64_t Address, unknown::ArrayRef<uint8_t> Bytes, cs_insn *Insn) const;
+
+    // Insert the decoded instruction, the record of other bytes at its address is replaced.
+    // False if it is already in the cache or the memory budget is used up
+    bool insert(const cs_insn *Insn);
+
+public:
+    // Get/Set
+    // Get the memory budget of the records
+    size_t getMemoryBudget() const;
+
+    // Get the memory used by the records
+    size_t getMemoryUsed() const;
+
+private:
+    Shard &getShard(uint64_t Address) { return mShards[getShardIndex(Address)]; }
+    const Shard &getShard(uint64_t Address) const { return mShards[getShardIndex(Address)]; }
+
+    // The neighboring instructions are decoded by different threads, so they are spread over the shards
+    static size_t getShardIndex(uint64_t Address)
+    {
+        Address ^= Address >> 33;
+        Address *= 0xff51afd7ed558ccdULL;
+        Address ^= Address >> 33;
+        return static_cast<size_t>(Address % NumShards);
+    }
+};
+
+} // namespace ufrontend
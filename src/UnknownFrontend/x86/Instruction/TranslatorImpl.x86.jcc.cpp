@@ -8,15 +8,85 @@ namespace ufrontend {
 bool
 UnknownFrontendTranslatorImplX86::translateJccInstruction(const cs_insn *Insn, uir::BasicBlock *BB)
 {
-    if (Insn->id != X86_INS_JAE && Insn->id != X86_INS_JA && Insn->id != X86_INS_JBE && Insn->id != X86_INS_JB &&
-        Insn->id != X86_INS_JE && Insn->id != X86_INS_JGE && Insn->id != X86_INS_JG && Insn->id != X86_INS_JLE &&
-        Insn->id != X86_INS_JL && Insn->id != X86_INS_JNE && Insn->id != X86_INS_JNO && Insn->id != X86_INS_JNP &&
-        Insn->id != X86_INS_JNS && Insn->id != X86_INS_JO && Insn->id != X86_INS_JP && Insn->id != X86_INS_JS)
+    // The flags tested by the condition
+    auto FlagsVar = std::unique_ptr<uir::FlagsVariable>(uir::FlagsVariable::get(getContext()));
+    switch (Insn->id)
     {
+    case X86_INS_JO:
+    case X86_INS_JNO:
+        FlagsVar->setOverflowFlag();
+        break;
+    case X86_INS_JB:
+    case X86_INS_JAE:
+        FlagsVar->setCarryFlag();
+        break;
+    case X86_INS_JE:
+    case X86_INS_JNE:
+        FlagsVar->setZeroFlag();
+        break;
+    case X86_INS_JBE:
+    case X86_INS_JA:
+        FlagsVar->setCarryFlag();
+        FlagsVar->setZeroFlag();
+        break;
+    case X86_INS_JS:
+    case X86_INS_JNS:
+        FlagsVar->setSignFlag();
+        break;
+    case X86_INS_JP:
+    case X86_INS_JNP:
+        FlagsVar->setParityFlag();
+        break;
+    case X86_INS_JL:
+    case X86_INS_JGE:
+        FlagsVar->setSignFlag();
+        FlagsVar->setOverflowFlag();
+        break;
+    case X86_INS_JLE:
+    case X86_INS_JG:
+        FlagsVar->setZeroFlag();
+        FlagsVar->setSignFlag();
+        FlagsVar->setOverflowFlag();
+        break;
+    default:
         return false;
     }
 
-    return true;
+    auto &X86Info = Insn->detail->x86;
+    if (X86Info.op_count != 1 || X86Info.operands[0].type != X86_OP_IMM)
+    {
+        return false;
+    }
+
+    uir::IRBuilder IRB(BB);
+
+    auto Target = static_cast<uint64_t>(X86Info.operands[0].imm.imm);
+    auto Normal = Insn->address + Insn->size;
+
+    // The targets in the function are queued, a target out of it gets a block jumping there.
+    // The fall through is translated even if the branch leaves the function
+    auto TargetBB = getBasicBlockAt(Target);
+    auto NormalBB = getBasicBlockAt(Normal);
+    if (TargetBB || NormalBB)
+    {
+        if (TargetBB == NormalBB)
+        {
+            // A branch to the next instruction always continues there
+            return IRB.createJmpBB(NormalBB, Insn->address) != nullptr;
+        }
+
+        TargetBB = TargetBB ? TargetBB : getExitBasicBlock(Target, Insn->address);
+        NormalBB = NormalBB ? NormalBB : getExitBasicBlock(Normal, Insn->address);
+        return IRB.createJccBB(TargetBB, NormalBB, FlagsVar.release(), Insn->address) != nullptr;
+    }
+
+    auto TypeBits = getContext().getModeBits();
+    auto AddrTy = uir::Type::getIntNTy(getContext(), TypeBits);
+    return IRB.createJccAddr(
+               uir::ConstantInt::get(AddrTy, unknown::APInt(TypeBits, Target)),
+               uir::ConstantInt::get(AddrTy, unknown::APInt(TypeBits, Normal)),
+               FlagsVar.release(),
+               Insn->address) != nullptr;
 }
 
 } // namespace ufrontend
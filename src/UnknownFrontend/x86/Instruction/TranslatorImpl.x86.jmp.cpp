@@ -0,0 +1,38 @@
+#include <x86/TranslatorImpl.x86.h>
+
+#include <unknown/ADT/ScopeExit.h>
+
+namespace ufrontend {
+
+// Jmp
+bool
+UnknownFrontendTranslatorImplX86::translateJmpInstruction(const cs_insn *Insn, uir::BasicBlock *BB)
+{
+    if (Insn->id != X86_INS_JMP)
+    {
+        return false;
+    }
+
+    auto &X86Info = Insn->detail->x86;
+    if (X86Info.op_count != 1 || X86Info.operands[0].type != X86_OP_IMM)
+    {
+        // jmp reg/mem, the target is not known
+        return translateUnknownX86Instruction(Insn, BB);
+    }
+
+    uir::IRBuilder IRB(BB);
+
+    // jmp imm, the target out of the function is a tail call
+    auto Target = static_cast<uint64_t>(X86Info.operands[0].imm.imm);
+    if (auto TargetBB = getBasicBlockAt(Target))
+    {
+        return IRB.createJmpBB(TargetBB, Insn->address) != nullptr;
+    }
+
+    auto TypeBits = getContext().getModeBits();
+    return IRB.createJmpAddr(
+               uir::ConstantInt::get(uir::Type::getIntNTy(getContext(), TypeBits), unknown::APInt(TypeBits, Target)),
+               Insn->address) != nullptr;
+}
+
+} // namespace ufrontend
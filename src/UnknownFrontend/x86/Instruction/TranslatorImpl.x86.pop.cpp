@@ -1,16 +0,0 @@
-#include <x86/TranslatorImpl.x86.h>
-
-#include <unknown/ADT/ScopeExit.h>
-
-namespace ufrontend {
-
-// Pop
-bool
-UnknownFrontendTranslatorImplX86::translatePopInstruction(const cs_insn *Insn, uir::BasicBlock *BB)
-{
-    // TODO
-
-    return true;
-}
-
-} // namespace ufrontend
@@ -1,16 +0,0 @@
-#include <x86/TranslatorImpl.x86.h>
-
-#include <unknown/ADT/ScopeExit.h>
-
-namespace ufrontend {
-
-// Push
-bool
-UnknownFrontendTranslatorImplX86::translatePushInstruction(const cs_insn *Insn, uir::BasicBlock *BB)
-{
-    // TODO
-
-    return true;
-}
-
-} // namespace ufrontend
@@ -0,0 +1,193 @@
+#include <x86/TranslatorImpl.x86.h>
+#include <x86/InstructionSemantics.x86.h>
+
+namespace ufrontend {
+
+// Get the flags variable of the flags defined by the instruction, nullptr if it defines none
+static uir::FlagsVariable *
+getSemanticsFlagsVariable(uir::Context &C, uint8_t Flags)
+{
+    if (Flags == X86FlagsNone)
+    {
+        return nullptr;
+    }
+
+    auto FlagsVar = uir::FlagsVariable::get(C);
+    FlagsVar->setCarryFlag(Flags & X86FlagCF);
+    FlagsVar->setParityFlag(Flags & X86FlagPF);
+    FlagsVar->setAuxParityFlag(Flags & X86FlagAF);
+    FlagsVar->setZeroFlag(Flags & X86FlagZF);
+    FlagsVar->setSignFlag(Flags & X86FlagSF);
+    FlagsVar->setOverflowFlag(Flags & X86FlagOF);
+    return FlagsVar;
+}
+
+// Create the binary operator of the entry
+template <X86SemanticsOp Op>
+static uir::Instruction *
+createSemanticsBinaryOperator(
+    uir::IRBuilder &IRB,
+    uir::Value *LHS,
+    uir::Value *RHS,
+    uir::FlagsVariable *FlagsVar,
+    uint64_t Address)
+{
+    if constexpr (Op == X86SemanticsOp::Add)
+    {
+        return IRB.createAdd(LHS, RHS, FlagsVar, Address);
+    }
+    else if constexpr (Op == X86SemanticsOp::Sub)
+    {
+        return IRB.createSub(LHS, RHS, FlagsVar, Address);
+    }
+    else if constexpr (Op == X86SemanticsOp::And)
+    {
+        return IRB.createAnd(LHS, RHS, FlagsVar, Address);
+    }
+    else if constexpr (Op == X86SemanticsOp::Or)
+    {
+        return IRB.createOr(LHS, RHS, FlagsVar, Address);
+    }
+    else
+    {
+        static_assert(Op == X86SemanticsOp::Xor, "The entry has no binary operator");
+        return IRB.createXor(LHS, RHS, FlagsVar, Address);
+    }
+}
+
+// Add/Sub/And/Or/Xor/Cmp/Test/Inc/Dec/Mov
+template <size_t Index>
+bool
+UnknownFrontendTranslatorImplX86::translateSemanticsInstruction(const cs_insn *Insn, uir::BasicBlock *BB)
+{
+    constexpr auto &Semantics = X86SemanticsTable[Index];
+    constexpr auto OperandCount = getX86SemanticsOperandCount(Semantics);
+
+    assert(Insn->id == Semantics.Id);
+
+    // The forms out of the table, e.g. the memory operands, are kept as unknown instructions
+    auto &X86Info = Insn->detail->x86;
+    if (X86Info.op_count != OperandCount)
+    {
+        return translateUnknownX86Instruction(Insn, BB);
+    }
+    for (size_t i = 0; i < OperandCount; ++i)
+    {
+        if (!isSemanticsOperandSupported(X86Info.operands[i]))
+        {
+            return translateUnknownX86Instruction(Insn, BB);
+        }
+    }
+
+    auto &Dst = X86Info.operands[0];
+    if constexpr (Semantics.WritesResult)
+    {
+        if (Dst.type != X86_OP_REG)
+        {
+            return translateUnknownX86Instruction(Insn, BB);
+        }
+    }
+
+    uint32_t TypeBits = Dst.size * 8;
+    uint64_t Address = Insn->address;
+    uir::IRBuilder IRB(BB);
+
+    if constexpr (Semantics.Kind == X86SemanticsKind::Binary)
+    {
+        // dst = dst op src
+        auto LHS = readSemanticsOperand(Dst, TypeBits, Address, BB);
+        uir::Value *RHS = nullptr;
+        if constexpr (Semantics.SourceIsOne)
+        {
+            RHS = uir::ConstantInt::get(uir::Type::getIntNTy(getContext(), TypeBits), unknown::APInt(TypeBits, 1));
+        }
+        else
+        {
+            RHS = readSemanticsOperand(X86Info.operands[1], TypeBits, Address, BB);
+        }
+
+        if (LHS == nullptr || RHS == nullptr)
+        {
+            return false;
+        }
+
+        auto Result = createSemanticsBinaryOperator<Semantics.Op>(
+            IRB, LHS, RHS, getSemanticsFlagsVariable(getContext(), Semantics.Flags), Address);
+        if constexpr (Semantics.WritesResult)
+        {
+            return writeRegister(Dst.reg, Result, Address, BB);
+        }
+        return Result != nullptr;
+    }
+    else
+    {
+        // dst = src
+        static_assert(Semantics.Kind == X86SemanticsKind::Move, "The entry has no translator");
+        auto Val = readSemanticsOperand(X86Info.operands[1], TypeBits, Address, BB);
+        if (Val == nullptr)
+        {
+            return false;
+        }
+
+        return writeRegister(Dst.reg, Val, Address, BB);
+    }
+}
+
+// Register the translators of X86SemanticsTable
+template <size_t... Indices>
+void
+UnknownFrontendTranslatorImplX86::initSemanticsInstructionTranslators(std::index_sequence<Indices...>)
+{
+    ((mX86InstructionTranslatorTable[X86SemanticsTable[Indices].Id] =
+          {&UnknownFrontendTranslatorImplX86::translateSemanticsInstruction<Indices>, false}),
+     ...);
+}
+
+void
+UnknownFrontendTranslatorImplX86::initSemanticsInstructionTranslators()
+{
+    initSemanticsInstructionTranslators(std::make_index_sequence<X86SemanticsTable.size()>());
+}
+
+// Is the operand lifted by the translators of X86SemanticsTable? The IR can't address memory yet
+bool
+UnknownFrontendTranslatorImplX86::isSemanticsOperandSupported(const cs_x86_op &Op) const
+{
+    if (Op.size == 0)
+    {
+        return false;
+    }
+
+    if (Op.type == X86_OP_IMM)
+    {
+        return true;
+    }
+
+    return Op.type == X86_OP_REG && getRegisterParentID(Op.reg) != X86_REG_INVALID;
+}
+
+// Read the register or immediate operand, nullptr if it is not supported
+uir::Value *
+UnknownFrontendTranslatorImplX86::readSemanticsOperand(
+    const cs_x86_op &Op,
+    uint32_t TypeBits,
+    uint64_t Address,
+    uir::BasicBlock *BB)
+{
+    if (Op.type == X86_OP_IMM)
+    {
+        // The immediate is sign-extended to the size of the destination
+        return uir::ConstantInt::get(
+            uir::Type::getIntNTy(getContext(), TypeBits),
+            unknown::APInt(TypeBits, static_cast<uint64_t>(Op.imm.imm), true));
+    }
+
+    if (Op.type == X86_OP_REG)
+    {
+        return loadRegister(Op.reg, Address, BB).value_or(nullptr);
+    }
+
+    return nullptr;
+}
+
+} // namespace ufrontend
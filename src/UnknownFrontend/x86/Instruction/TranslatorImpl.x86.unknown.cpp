@@ -22,7 +22,15 @@ UnknownFrontendTranslatorImplX86::translateUnknownX86Instruction(const cs_insn *
     }
 
     uir::IRBuilder IRB(BB);
-    return IRB.createUnknown(InstStr, Insn->address) != nullptr;
+    if (IRB.createUnknown(InstStr, Insn->address) == nullptr)
+    {
+        return false;
+    }
+
+    // The registers it writes are not known, the decoded instruction cache doesn't keep regs_write. Every register is
+    // loaded again by the next instruction reading it
+    dropSavedRegisterValues();
+    return true;
 }
 
 } // namespace ufrontend
@@ -0,0 +1,116 @@
+#pragma once
+#include <capstone/capstone.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ufrontend {
+
+// The semantics of the x86 instruction families lifted by a table, every entry is expanded into its own translator
+enum class X86SemanticsKind : uint8_t
+{
+    // dst = dst op src, the binary operator is the Op of the entry
+    Binary,
+
+    // dst = src
+    Move
+};
+
+// The binary operator of the IR computing the result
+enum class X86SemanticsOp : uint8_t
+{
+    None,
+    Add,
+    Sub,
+    And,
+    Or,
+    Xor
+};
+
+// The flags defined by the instruction
+enum X86SemanticsFlags : uint8_t
+{
+    X86FlagsNone = 0,
+    X86FlagCF = 1 << 0,
+    X86FlagPF = 1 << 1,
+    X86FlagAF = 1 << 2,
+    X86FlagZF = 1 << 3,
+    X86FlagSF = 1 << 4,
+    X86FlagOF = 1 << 5,
+
+    // add/sub/cmp
+    X86FlagsArith = X86FlagCF | X86FlagPF | X86FlagAF | X86FlagZF | X86FlagSF | X86FlagOF,
+
+    // inc/dec leave the carry alone
+    X86FlagsIncDec = X86FlagPF | X86FlagAF | X86FlagZF | X86FlagSF | X86FlagOF,
+
+    // and/or/xor/test clear CF and OF, AF is undefined
+    X86FlagsLogic = X86FlagCF | X86FlagPF | X86FlagZF | X86FlagSF | X86FlagOF,
+};
+
+struct X86Semantics
+{
+    x86_insn Id;
+    X86SemanticsKind Kind;
+    X86SemanticsOp Op;
+    uint8_t Flags;
+
+    // cmp/test only define the flags
+    bool WritesResult;
+
+    // inc/dec have no source operand, the source is 1
+    bool SourceIsOne;
+};
+
+// push/pop are kept as unknown instructions, the slot of a pop can't be matched with its push until the stack pointer
+// offsets are tracked
+// clang-format off
+inline constexpr std::array<X86Semantics, 10> X86SemanticsTable = {{
+    //  Id              Kind                         Op                         Flags            WritesResult  SourceIsOne
+    {   X86_INS_ADD,    X86SemanticsKind::Binary,    X86SemanticsOp::Add,       X86FlagsArith,   true,         false },
+    {   X86_INS_SUB,    X86SemanticsKind::Binary,    X86SemanticsOp::Sub,       X86FlagsArith,   true,         false },
+    {   X86_INS_AND,    X86SemanticsKind::Binary,    X86SemanticsOp::And,       X86FlagsLogic,   true,         false },
+    {   X86_INS_OR,     X86SemanticsKind::Binary,    X86SemanticsOp::Or,        X86FlagsLogic,   true,         false },
+    {   X86_INS_XOR,    X86SemanticsKind::Binary,    X86SemanticsOp::Xor,       X86FlagsLogic,   true,         false },
+    {   X86_INS_CMP,    X86SemanticsKind::Binary,    X86SemanticsOp::Sub,       X86FlagsArith,   false,        false },
+    {   X86_INS_TEST,   X86SemanticsKind::Binary,    X86SemanticsOp::And,       X86FlagsLogic,   false,        false },
+    {   X86_INS_INC,    X86SemanticsKind::Binary,    X86SemanticsOp::Add,       X86FlagsIncDec,  true,         true  },
+    {   X86_INS_DEC,    X86SemanticsKind::Binary,    X86SemanticsOp::Sub,       X86FlagsIncDec,  true,         true  },
+    {   X86_INS_MOV,    X86SemanticsKind::Move,      X86SemanticsOp::None,      X86FlagsNone,    true,         false },
+}};
+// clang-format on
+
+// The number of the operands read by the entry
+constexpr size_t
+getX86SemanticsOperandCount(const X86Semantics &Semantics)
+{
+    switch (Semantics.Kind)
+    {
+    case X86SemanticsKind::Binary:
+        return Semantics.SourceIsOne ? 1 : 2;
+    case X86SemanticsKind::Move:
+        return 2;
+    }
+    return 0;
+}
+
+// Every instruction has one entry at most, the dispatch table is indexed by the id
+constexpr bool
+hasUniqueX86SemanticsIds()
+{
+    for (size_t i = 0; i < X86SemanticsTable.size(); ++i)
+    {
+        for (size_t j = i + 1; j < X86SemanticsTable.size(); ++j)
+        {
+            if (X86SemanticsTable[i].Id == X86SemanticsTable[j].Id)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(hasUniqueX86SemanticsIds(), "An x86 instruction has several semantics");
+
+} // namespace ufrontend
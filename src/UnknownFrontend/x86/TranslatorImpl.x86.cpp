@@ -2,6 +2,11 @@
 #include "Error.h"
 
 #include <unknown/ADT/ScopeExit.h>
+#include <unknown/Support/ThreadPool.h>
+#include <unknown/Support/Threading.h>
+
+#include <algorithm>
+#include <atomic>
 
 namespace ufrontend {
 
@@ -12,7 +17,8 @@ UnknownFrontendTranslatorImplX86::UnknownFrontendTranslatorImplX86(
     const std::string &SymbolFile,
     const std::string &ConfigFile,
     bool AnalyzeAllFunctions) :
-    UnknownFrontendTranslatorImpl(C, Platform, BinaryFile, SymbolFile, ConfigFile, AnalyzeAllFunctions), mUsePDB(false)
+    UnknownFrontendTranslatorImpl(C, Platform, BinaryFile, SymbolFile, ConfigFile, AnalyzeAllFunctions),
+    mUsePDB(false)
 {
     //
 }
@@ -42,13 +48,25 @@ UnknownFrontendTranslatorImplX86::openCapstoneHandle()
 
     cs_option(CapstoneHandle, CS_OPT_DETAIL, CS_OPT_ON);
 
-    mCapstoneHandle = CapstoneHandle;
+    auto &LC = getLiftingContext();
+    LC.CapstoneHandle = CapstoneHandle;
+
+    // Allocate the instruction reused by cs_disasm_iter
+    LC.CapstoneInsn = cs_malloc(CapstoneHandle);
+    assert(LC.CapstoneInsn);
 }
 
 void
 UnknownFrontendTranslatorImplX86::closeCapstoneHandle()
 {
-    auto CapstoneHandle = mCapstoneHandle;
+    auto &LC = getLiftingContext();
+    if (LC.CapstoneInsn)
+    {
+        cs_free(LC.CapstoneInsn, 1);
+        LC.CapstoneInsn = nullptr;
+    }
+
+    auto CapstoneHandle = LC.CapstoneHandle;
     if (CapstoneHandle != 0)
     {
         if (cs_close(&CapstoneHandle) != CS_ERR_OK)
@@ -57,7 +75,7 @@ UnknownFrontendTranslatorImplX86::closeCapstoneHandle()
             return;
         }
 
-        mCapstoneHandle = 0;
+        LC.CapstoneHandle = 0;
     }
 }
 
@@ -88,6 +106,8 @@ UnknownFrontendTranslatorImplX86::initSymbolParser()
     mSymbolParser = unknown::CreateSymbolParserForPE(UsePDB);
     assert(mSymbolParser);
 
+    mSymbolParser->setIndexCacheDirectory(getSymbolIndexDirectory());
+
     if (!mSymbolParser->ParseFunctionSymbols(getSymbolFile()))
     {
         std::cerr << UFRONTEND_ERROR_PREFIX "ParseFunctionSymbols failed" << std::endl;
@@ -102,8 +122,108 @@ UnknownFrontendTranslatorImplX86::initBinary()
 {
     assert(!getBinaryFile().empty());
 
-    mBinary = LIEF::PE::Parser::parse(getBinaryFile());
-    assert(mBinary);
+    // Map the image, only the headers and the section table are parsed
+    mImage = std::make_unique<PEImage>(getBinaryFile());
+    if (!mImage->ParseImage())
+    {
+        std::cerr << UFRONTEND_ERROR_PREFIX "ParseImage failed" << std::endl;
+        std::abort();
+    }
+
+    // The symbols of a MAP file have no size, they would be lifted to the end of their section
+    fixupFunctionSymbolSizes();
+
+    mDecodedInstructionCache = std::make_unique<DecodedInstructionCacheX86>();
+}
+
+// Get the read-only bytes of [Address, MaxAddress) from the section containing Address
+unknown::ArrayRef<uint8_t>
+UnknownFrontendTranslatorImplX86::getBinaryBytes(uint64_t Address, uint64_t MaxAddress) const
+{
+    return mImage->getBytes(Address, MaxAddress);
+}
+
+// Fall back to the end of the section if the end of current pointer is not valid
+void
+UnknownFrontendTranslatorImplX86::fixupCurPtrEnd()
+{
+    if (getCurPtrEnd() <= getCurPtrBegin())
+    {
+        auto SectionEnd = mImage->getSectionEnd(getCurPtrBegin());
+        if (SectionEnd)
+        {
+            setCurPtrEnd(SectionEnd);
+        }
+    }
+
+    assert(getCurPtrEnd());
+    assert(getCurPtrEnd() > getCurPtrBegin());
+}
+
+// Derive the sizes of the function symbols which have none from the next symbol and the .pdata
+void
+UnknownFrontendTranslatorImplX86::fixupFunctionSymbolSizes()
+{
+    auto &FunctionSymbols = mSymbolParser->getFunctionSymbols();
+    auto RuntimeFunctions = mImage->getRuntimeFunctions();
+    auto ImageBase = mImage->getImageBase();
+
+    // A function ends at the latest where the next symbol or the next unchained RUNTIME_FUNCTION begins
+    std::vector<uint64_t> Boundaries;
+    Boundaries.reserve(FunctionSymbols.size() + RuntimeFunctions.size());
+    for (auto &Symbol : FunctionSymbols)
+    {
+        Boundaries.push_back(Symbol.rva);
+    }
+    for (auto &RF : RuntimeFunctions)
+    {
+        if (!RF.Chained)
+        {
+            Boundaries.push_back(RF.BeginAddress);
+        }
+    }
+    std::sort(Boundaries.begin(), Boundaries.end());
+    Boundaries.erase(std::unique(Boundaries.begin(), Boundaries.end()), Boundaries.end());
+
+    for (auto &Symbol : FunctionSymbols)
+    {
+        if (Symbol.size != 0)
+        {
+            continue;
+        }
+
+        // Keep the fallback to the end of the section if the symbol is out of the image
+        uint64_t SectionEnd = mImage->getSectionEnd(ImageBase + Symbol.rva);
+        if (SectionEnd <= ImageBase + Symbol.rva)
+        {
+            continue;
+        }
+        uint64_t End = SectionEnd - ImageBase;
+
+        auto BoundaryIt = std::upper_bound(Boundaries.begin(), Boundaries.end(), Symbol.rva);
+        if (BoundaryIt != Boundaries.end())
+        {
+            End = std::min<uint64_t>(End, *BoundaryIt);
+        }
+
+        // The RUNTIME_FUNCTION of the symbol is exact, its chained entries up to the next boundary are a part of it
+        auto RFIt = std::lower_bound(
+            RuntimeFunctions.begin(),
+            RuntimeFunctions.end(),
+            Symbol.rva,
+            [](const PEImage::RuntimeFunction &RF, uint64_t RVA) { return RF.BeginAddress < RVA; });
+        if (RFIt != RuntimeFunctions.end() && RFIt->BeginAddress == Symbol.rva && !RFIt->Chained)
+        {
+            uint64_t RFEnd = RFIt->EndAddress;
+            for (++RFIt; RFIt != RuntimeFunctions.end() && RFIt->Chained && RFIt->BeginAddress < End; ++RFIt)
+            {
+                RFEnd = std::max<uint64_t>(RFEnd, RFIt->EndAddress);
+            }
+            End = std::min(End, RFEnd);
+        }
+
+        Symbol.size = static_cast<uint32_t>(End - Symbol.rva);
+    }
 }
 
 ////////////////////////////////////////////////////////////
@@ -138,36 +258,68 @@ UnknownFrontendTranslatorImplX86::getBasePointerRegisterName() const
 void
 UnknownFrontendTranslatorImplX86::initTranslateInstruction()
 {
-    mX86InstructionTranslatorMap = {
-        // Ret
-        {X86_INS_RET, {&UnknownFrontendTranslatorImplX86::translateRetInstruction, true}},
-
-        // Mov
-        {X86_INS_MOV, {&UnknownFrontendTranslatorImplX86::translateMovInstruction, false}},
-
-        // Push/Pop
-        {X86_INS_PUSH, {&UnknownFrontendTranslatorImplX86::translatePushInstruction, false}},
-        {X86_INS_POP, {&UnknownFrontendTranslatorImplX86::translatePopInstruction, false}},
-
-        // Jcc
-        {X86_INS_JAE, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JA, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JBE, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JB, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JE, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JGE, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JG, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JLE, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JL, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JNE, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JNO, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JNP, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JNS, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JO, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JP, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}},
-        {X86_INS_JS, {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true}}
+    mX86InstructionTranslatorTable.fill({});
+
+    // Ret
+    mX86InstructionTranslatorTable[X86_INS_RET] = {&UnknownFrontendTranslatorImplX86::translateRetInstruction, true};
+
+    // Jcc
+    mX86InstructionTranslatorTable[X86_INS_JAE] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JA] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JBE] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JB] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JE] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JGE] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JG] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JLE] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JL] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JNE] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JNO] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JNP] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JNS] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JO] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JP] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+    mX86InstructionTranslatorTable[X86_INS_JS] = {&UnknownFrontendTranslatorImplX86::translateJccInstruction, true};
+
+    // Jmp
+    mX86InstructionTranslatorTable[X86_INS_JMP] = {&UnknownFrontendTranslatorImplX86::translateJmpInstruction, true};
+
+    // Add/Sub/And/Or/Xor/Cmp/Test/Inc/Dec/Mov/Push/Pop
+    initSemanticsInstructionTranslators();
+}
+
+// Decode the instruction at the begin of the code into Insn and step over it like cs_disasm_iter, the decoded
+// instruction cache is looked up first
+bool
+UnknownFrontendTranslatorImplX86::decodeInstruction(
+    const uint8_t *&Code,
+    size_t &CodeSize,
+    uint64_t &Address,
+    cs_insn *Insn)
+{
+    assert(Code);
+    assert(Insn);
 
-    };
+    if (mDecodedInstructionCache &&
+        mDecodedInstructionCache->lookup(Address, unknown::ArrayRef<uint8_t>(Code, CodeSize), Insn))
+    {
+        Code += Insn->size;
+        CodeSize -= Insn->size;
+        Address += Insn->size;
+        return true;
+    }
+
+    if (!cs_disasm_iter(getCapstoneHandle(), &Code, &CodeSize, &Address, Insn))
+    {
+        return false;
+    }
+
+    if (mDecodedInstructionCache)
+    {
+        mDecodedInstructionCache->insert(Insn);
+    }
+
+    return true;
 }
 
 // Translate the given binary into UnknownIR
@@ -177,14 +329,70 @@ UnknownFrontendTranslatorImplX86::translateBinary(const std::string &ModuleName)
     auto Module = uir::Module::get(getContext(), ModuleName);
     assert(Module);
 
-    for (auto &FunctionSymbol : mSymbolParser->getFunctionSymbols())
-    {
+    auto &FunctionSymbols = mSymbolParser->getFunctionSymbols();
+    std::vector<std::unique_ptr<uir::Function>> Functions(FunctionSymbols.size());
+    std::vector<uint8_t> TransResults(FunctionSymbols.size(), false);
+
+    // Translate the function into UnknownIR
+    auto translateFunctionAt = [&](size_t Index) {
         auto F = std::make_unique<uir::Function>(getContext());
         assert(F);
 
-        // Translate the function into UnknownIR
-        bool TransRes = translateOneFunction(FunctionSymbol, F.get());
-        if (TransRes)
+        // The blocks and instructions of the function are released in bulk with it
+        F->enableArena();
+
+        TransResults[Index] = translateOneFunction(FunctionSymbols[Index], F.get());
+        Functions[Index] = std::move(F);
+
+        // The blocks of the next function must not be allocated in the arena of this one
+        setCurFunction(nullptr);
+    };
+
+    uint32_t ThreadCount = getThreadCount() ? getThreadCount() : unknown::hardware_concurrency();
+    ThreadCount = static_cast<uint32_t>(std::min<size_t>(ThreadCount, FunctionSymbols.size()));
+    if (ThreadCount <= 1)
+    {
+        for (size_t i = 0; i < FunctionSymbols.size(); ++i)
+        {
+            translateFunctionAt(i);
+        }
+    }
+    else
+    {
+        // Every worker owns a lifting context with its own capstone handle and pulls the next symbol
+        std::atomic<size_t> NextIndex(0);
+        unknown::ThreadPool Pool(ThreadCount);
+        for (uint32_t i = 0; i < ThreadCount; ++i)
+        {
+            Pool.async([&]() {
+                LiftingContext LC;
+                bindLiftingContext(&LC);
+                openCapstoneHandle();
+
+                for (size_t Index = NextIndex++; Index < FunctionSymbols.size(); Index = NextIndex++)
+                {
+                    translateFunctionAt(Index);
+                }
+
+                closeCapstoneHandle();
+                resetLiftingContext(LC);
+                bindLiftingContext(nullptr);
+            });
+        }
+        Pool.wait();
+    }
+
+    // Keep the size of the lift cache within its policy
+    if (mLiftCache)
+    {
+        mLiftCache->prune();
+    }
+
+    // Insert the functions into the module in symbol order
+    for (size_t i = 0; i < Functions.size(); ++i)
+    {
+        auto &F = Functions[i];
+        if (TransResults[i])
         {
             if (!F->empty())
             {
@@ -213,20 +421,14 @@ UnknownFrontendTranslatorImplX86::translateOneInstruction(
     assert(Bytes);
     assert(BB);
 
-    cs_insn *Insn = nullptr;
+    cs_insn *Insn = getLiftingContext().CapstoneInsn;
+    assert(Insn);
 
     // Disasm
-    size_t DisasmCount = cs_disasm(getCapstoneHandle(), const_cast<const uint8_t *>(Bytes), Size, Address, 1, &Insn);
-    auto DeferredInsn = unknown::make_scope_exit([&Insn]() {
-        if (Insn)
-        {
-            cs_free(Insn, 1);
-            Insn = nullptr;
-        }
-    });
-
-    bool DisasmRes = DisasmCount == 1;
-    if (!DisasmRes)
+    const uint8_t *Code = Bytes;
+    size_t CodeSize = Size;
+    uint64_t CodeAddress = Address;
+    if (!decodeInstruction(Code, CodeSize, CodeAddress, Insn))
     {
         std::cerr << std::format(UFRONTEND_ERROR_PREFIX "disasm: 0x{:X} failed", Address) << std::endl;
         return false;
@@ -259,24 +461,15 @@ UnknownFrontendTranslatorImplX86::translateOneInstruction(
     {
         // Set the end of current pointer
         setCurPtrEnd(Address + Insn->size);
-        if (getCurPtrEnd() <= getCurPtrBegin())
-        {
-            auto CurSection = mBinary->get_section(getCurPtrBegin());
-            if (CurSection)
-            {
-                setCurPtrEnd(mBinary->imagebase() + CurSection->virtual_address() + CurSection->sizeof_raw_data());
-            }
-        }
-        assert(getCurPtrEnd());
-        assert(getCurPtrEnd() > getCurPtrBegin());
+        fixupCurPtrEnd();
     }
 
     bool TransRes = false;
 
-    auto ItTrans = mX86InstructionTranslatorMap.find(Insn->id);
-    if (ItTrans != mX86InstructionTranslatorMap.end())
+    if (Insn->id < mX86InstructionTranslatorTable.size() &&
+        mX86InstructionTranslatorTable[Insn->id].TranslateFunction != nullptr)
     {
-        auto &TransInfo = ItTrans->second;
+        auto &TransInfo = mX86InstructionTranslatorTable[Insn->id];
         IsBlockTerminatorInsn = TransInfo.IsBlockTerminatorInsn;
         TransRes = (this->*TransInfo.TranslateFunction)(Insn, BB);
     }
@@ -308,65 +501,70 @@ UnknownFrontendTranslatorImplX86::translateOneBasicBlock(
     {
         // Set the end of current pointer
         setCurPtrEnd(MaxAddress);
-        if (getCurPtrEnd() <= getCurPtrBegin())
-        {
-            auto CurSection = mBinary->get_section(getCurPtrBegin());
-            if (CurSection)
-            {
-                setCurPtrEnd(mBinary->imagebase() + CurSection->virtual_address() + CurSection->sizeof_raw_data());
-            }
-        }
-        assert(getCurPtrEnd());
-        assert(getCurPtrEnd() > getCurPtrBegin());
+        fixupCurPtrEnd();
     }
 
-    auto NewBB = std::make_unique<uir::BasicBlock>(getContext(), BlockName, Address, MaxAddress);
+    // The block is allocated in the arena of the current function, so are the instructions built into it
+    auto NewBB = std::unique_ptr<uir::BasicBlock>(
+        uir::BasicBlock::create(getContext(), BlockName, Address, MaxAddress, getLiftingContext().CurFunction));
     assert(NewBB);
 
-    // Translate
-    while (getCurPtrBegin() < getCurPtrEnd())
+    bool EndsWithTerminatorInsn = false;
+    translateBasicBlockInstructions(NewBB.get(), EndsWithTerminatorInsn);
+    if (NewBB->empty())
     {
-        cs_insn *Insn = nullptr;
+        NewBB.reset(nullptr);
+        return nullptr;
+    }
 
-        uint64_t Address = getCurPtrBegin();
-        uint64_t MaxAddress = getCurPtrEnd();
-        size_t Size = MaxAddress - Address;
+    return NewBB.release();
+}
 
-        uint8_t *Bytes = new uint8_t[Size]{};
-        assert(Bytes);
-        auto DeferredBytes = unknown::make_scope_exit([&Bytes]() {
-            if (Bytes)
-            {
-                delete[] Bytes;
-                Bytes = nullptr;
-            }
-        });
+// Translate the instructions from the begin to the end of current pointer into the block until a terminator
+// instruction, false if no instruction is decoded
+bool
+UnknownFrontendTranslatorImplX86::translateBasicBlockInstructions(uir::BasicBlock *BB, bool &EndsWithTerminatorInsn)
+{
+    assert(BB);
 
-        auto Contents = mBinary->get_content_from_virtual_address(Address, Size);
-        assert(!Contents.empty());
-        std::copy(Contents.begin(), Contents.end(), Bytes);
+    EndsWithTerminatorInsn = false;
 
-        // Disasm
-        size_t DisasmCount =
-            cs_disasm(getCapstoneHandle(), const_cast<const uint8_t *>(Bytes), Size, Address, 1, &Insn);
-        auto DeferredInsn = unknown::make_scope_exit([&Insn]() {
-            if (Insn)
-            {
-                cs_free(Insn, 1);
-                Insn = nullptr;
-            }
-        });
+    auto &LC = getLiftingContext();
+    uint64_t BlockBegin = getCurPtrBegin();
 
-        bool DisasmRes = DisasmCount == 1;
-        if (!DisasmRes)
+    // Pin the bytes of the basic block once, decodeInstruction walks them with the reused instruction
+    auto Bytes = getBinaryBytes(getCurPtrBegin(), getCurPtrEnd());
+    const uint8_t *Code = Bytes.data();
+    size_t CodeSize = Bytes.size();
+    uint64_t CodeAddress = getCurPtrBegin();
+
+    cs_insn *Insn = LC.CapstoneInsn;
+    assert(Insn);
+
+    // The block may be entered from other paths, the registers are loaded again
+    dropSavedRegisterValues();
+
+    // Translate
+    while (getCurPtrBegin() < getCurPtrEnd())
+    {
+        uint64_t Address = CodeAddress;
+
+        // Disasm
+        if (!decodeInstruction(Code, CodeSize, CodeAddress, Insn))
         {
             std::cerr << std::format(UFRONTEND_ERROR_PREFIX "disasm: 0x{:X} failed", Address) << std::endl;
             break;
         }
 
+        // Remember where the instruction begins, a branch into it splits the block there
+        if (Address >= LC.FunctionBegin && Address < LC.FunctionEnd)
+        {
+            LC.InstructionBegins[Address - LC.FunctionBegin] = true;
+        }
+
         // Translate one instruction
         bool IsTerminatorInsn = false;
-        bool TransRes = translateOneInstruction(Insn, Address, NewBB.get(), IsTerminatorInsn);
+        bool TransRes = translateOneInstruction(Insn, Address, BB, IsTerminatorInsn);
         if (!TransRes)
         {
             std::cerr << std::format(UFRONTEND_ERROR_PREFIX "translateOneInstruction: 0x{:X} failed", Address)
@@ -375,24 +573,249 @@ UnknownFrontendTranslatorImplX86::translateOneBasicBlock(
         }
 
         // Update ptr
-        setCurPtrBegin(Address + Insn->size);
+        setCurPtrBegin(CodeAddress);
 
         if (IsTerminatorInsn)
         {
+            EndsWithTerminatorInsn = true;
             break;
         }
     }
 
-    if (NewBB->empty())
+    // Update the end address of the basic block
+    BB->setBasicBlockAddressEnd(getCurPtrBegin());
+
+    return getCurPtrBegin() != BlockBegin;
+}
+
+// Get the basic block beginning at the branch target, a pending one is created if there is none yet.
+// nullptr if the target is out of the current function or the blocks of no function are recovered
+uir::BasicBlock *
+UnknownFrontendTranslatorImplX86::getBasicBlockAt(uint64_t Address)
+{
+    auto &LC = getLiftingContext();
+    if (Address < LC.FunctionBegin || Address >= LC.FunctionEnd)
     {
-        NewBB.reset(nullptr);
         return nullptr;
     }
 
-    // Update the end address of the basic block
-    NewBB->setBasicBlockAddressEnd(getCurPtrBegin());
+    auto &BB = LC.BasicBlockMap[Address];
+    if (BB == nullptr)
+    {
+        // The block is translated or split from the translated block containing it later
+        BB = uir::BasicBlock::create(getContext(), "", Address, Address, LC.CurFunction);
+        assert(BB);
 
-    return NewBB.release();
+        LC.PendingBasicBlocks.push_back(BB);
+    }
+
+    return BB;
+}
+
+// Get a block jumping to the branch target out of the current function
+uir::BasicBlock *
+UnknownFrontendTranslatorImplX86::getExitBasicBlock(uint64_t Target, uint64_t InstAddress)
+{
+    auto &LC = getLiftingContext();
+    assert(Target < LC.FunctionBegin || Target >= LC.FunctionEnd);
+
+    // It has no code of its own, it is at the branch and is not a leader
+    auto BB = uir::BasicBlock::create(getContext(), "", InstAddress, InstAddress, LC.CurFunction);
+    assert(BB);
+
+    uir::IRBuilder IRB(BB);
+    auto TypeBits = getContext().getModeBits();
+    IRB.createJmpAddr(
+        uir::ConstantInt::get(uir::Type::getIntNTy(getContext(), TypeBits), unknown::APInt(TypeBits, Target)),
+        InstAddress);
+
+    LC.ExitBasicBlocks.push_back(BB);
+    return BB;
+}
+
+// Move the instructions from the begin of the pending block out of the translated block containing it,
+// false if it is in none
+bool
+UnknownFrontendTranslatorImplX86::splitBasicBlockAt(uir::BasicBlock *PendingBB)
+{
+    assert(PendingBB);
+
+    auto &LC = getLiftingContext();
+    uint64_t Address = PendingBB->getBasicBlockAddressBegin();
+
+    // The last translated block beginning before the pending one is the only one which can contain it, the pending
+    // blocks between them have no instructions yet
+    auto It = LC.TranslatedBasicBlockMap.lower_bound(Address);
+    if (It == LC.TranslatedBasicBlockMap.begin())
+    {
+        return false;
+    }
+
+    auto BB = std::prev(It)->second;
+    if (Address >= BB->getBasicBlockAddressEnd() || !LC.InstructionBegins[Address - LC.FunctionBegin])
+    {
+        // The branch into the middle of an instruction is translated as a block overlapping it
+        return false;
+    }
+
+    auto SplitIt = std::find_if(BB->begin(), BB->end(), [Address](const uir::Instruction &I) {
+        return I.getInstructionAddress() >= Address;
+    });
+    for (auto InstIt = SplitIt; InstIt != BB->end(); ++InstIt)
+    {
+        InstIt->setParent(PendingBB);
+    }
+    PendingBB->getInstList().splice(PendingBB->end(), BB->getInstList(), SplitIt, BB->end());
+
+    PendingBB->setBasicBlockAddressEnd(BB->getBasicBlockAddressEnd());
+    BB->setBasicBlockAddressEnd(Address);
+
+    // The tail is entered by the branch too, the register values it takes from the head are loaded again from the
+    // registers they were loaded from or stored to
+    std::unordered_map<uir::Value *, uir::Value *> ReloadedValues;
+    uir::IRBuilder ReloadIRB(PendingBB, PendingBB->begin());
+    auto reloadValue = [&](uir::Value *V) -> uir::Value * {
+        auto I = unknown::dyn_cast_or_null<uir::Instruction>(V);
+        if (I == nullptr || I->getParent() != BB)
+        {
+            return nullptr;
+        }
+
+        auto &Reloaded = ReloadedValues[V];
+        if (Reloaded)
+        {
+            return Reloaded;
+        }
+
+        // A written value is in the last register it is stored to, unless that register is written again
+        uir::Value *RegisterPtr = nullptr;
+        if (auto LI = unknown::dyn_cast<uir::LoadInstruction>(I))
+        {
+            RegisterPtr = LI->getPointerOperand();
+        }
+        else
+        {
+            for (auto &HeadI : *BB)
+            {
+                auto SI = unknown::dyn_cast<uir::StoreInstruction>(&HeadI);
+                if (SI && SI->getValueOperand() == V)
+                {
+                    RegisterPtr = SI->getPointerOperand();
+                }
+                else if (SI && SI->getPointerOperand() == RegisterPtr)
+                {
+                    RegisterPtr = nullptr;
+                }
+            }
+        }
+
+        if (RegisterPtr)
+        {
+            Reloaded = ReloadIRB.createLoad(RegisterPtr, Address);
+        }
+        return Reloaded;
+    };
+
+    for (auto &I : *PendingBB)
+    {
+        for (size_t Index = 0; Index < I.op_count(); ++Index)
+        {
+            if (auto Reloaded = reloadValue(I.getOperand(Index)))
+            {
+                I.setOperandAndUpdateUsers(Index, Reloaded);
+            }
+        }
+    }
+
+    // The head falls through into the tail
+    uir::IRBuilder IRB(BB);
+    IRB.createJmpBB(PendingBB, Address);
+
+    LC.TranslatedBasicBlockMap[Address] = PendingBB;
+    return true;
+}
+
+// Translate the basic blocks of the current function reachable from its begin by following the branches
+bool
+UnknownFrontendTranslatorImplX86::translateReachableBasicBlocks(uir::Function *F)
+{
+    assert(F);
+
+    auto &LC = getLiftingContext();
+    LC.FunctionBegin = getCurPtrBegin();
+    LC.FunctionEnd = getCurPtrEnd();
+    LC.InstructionBegins.assign(LC.FunctionEnd - LC.FunctionBegin, false);
+
+    // The leaders are the begin of the function and the targets of the branches, every leader is translated until a
+    // terminator instruction or the next leader
+    getBasicBlockAt(LC.FunctionBegin);
+    while (!LC.PendingBasicBlocks.empty())
+    {
+        auto BB = LC.PendingBasicBlocks.back();
+        LC.PendingBasicBlocks.pop_back();
+
+        if (splitBasicBlockAt(BB))
+        {
+            continue;
+        }
+
+        uint64_t Address = BB->getBasicBlockAddressBegin();
+        auto NextIt = LC.BasicBlockMap.upper_bound(Address);
+        uint64_t MaxAddress = NextIt != LC.BasicBlockMap.end() ? NextIt->first : LC.FunctionEnd;
+
+        setCurPtrBegin(Address);
+        setCurPtrEnd(MaxAddress);
+
+        uir::IRBuilder IRB(BB);
+        LC.TranslatedBasicBlockMap[Address] = BB;
+
+        bool EndsWithTerminatorInsn = false;
+        if (!translateBasicBlockInstructions(BB, EndsWithTerminatorInsn))
+        {
+            // The branches into it are kept
+            IRB.createUnknown("invalid", Address);
+            continue;
+        }
+
+        // The block runs into the next leader
+        if (!EndsWithTerminatorInsn && NextIt != LC.BasicBlockMap.end() && getCurPtrBegin() == MaxAddress)
+        {
+            IRB.createJmpBB(NextIt->second, MaxAddress);
+        }
+    }
+
+    // Insert the blocks in the address order, the predecessors are linked from the successors of the terminators
+    for (auto &Item : LC.BasicBlockMap)
+    {
+        F->insertBasicBlock(Item.second);
+    }
+
+    for (auto BB : LC.ExitBasicBlocks)
+    {
+        F->insertBasicBlock(BB);
+    }
+
+    for (auto &Item : LC.BasicBlockMap)
+    {
+        auto BB = Item.second;
+        if (auto Terminator = BB->getTerminator())
+        {
+            for (auto Successor : Terminator->getSuccessorsList())
+            {
+                Successor->predecessor_push(BB);
+            }
+        }
+    }
+
+    // The branches translated out of a function don't get a basic block
+    LC.FunctionBegin = 0;
+    LC.FunctionEnd = 0;
+    LC.BasicBlockMap.clear();
+    LC.TranslatedBasicBlockMap.clear();
+    LC.ExitBasicBlocks.clear();
+    LC.InstructionBegins.clear();
+
+    return !F->empty();
 }
 
 // Translate one function into UnknownIR
@@ -412,8 +835,8 @@ UnknownFrontendTranslatorImplX86::translateOneFunction(
         return true;
     }
 
-    // Clear mRegisterCounterMap
-    mRegisterCounterMap.clear();
+    // Every function starts with a fresh register state
+    resetLiftingContext(getLiftingContext());
 
     // Set the current function
     setCurFunction(F);
@@ -422,40 +845,24 @@ UnknownFrontendTranslatorImplX86::translateOneFunction(
     setCurPtrBegin(Address ? Address : F->getFunctionBeginAddress());
     setCurPtrEnd(Size ? Address + Size : F->getFunctionEndAddress());
 
-    // Update the end pointer if it's not valid
-    if (getCurPtrEnd() <= getCurPtrBegin())
-    {
-        auto CurSection = mBinary->get_section(getCurPtrBegin());
-        if (CurSection)
-        {
-            setCurPtrEnd(mBinary->imagebase() + CurSection->virtual_address() + CurSection->sizeof_raw_data());
-        }
-    }
-
     assert(getCurPtrBegin());
-    assert(getCurPtrEnd());
-    assert(getCurPtrEnd() > getCurPtrBegin());
 
-    while (getCurPtrBegin() < getCurPtrEnd())
-    {
-        // Translate a basic block
-        auto BB = translateOneBasicBlock("", getCurPtrBegin(), getCurPtrEnd());
-        if (BB == nullptr)
-        {
-            break;
-        }
+    // Update the end pointer if it's not valid
+    fixupCurPtrEnd();
 
-        // Insert a basic block into the function
-        if (!BB->empty())
+    // The body is loaded from the lift cache if the same bytes were lifted with the same attributes, nothing is decoded
+    std::string CacheKey;
+    if (mLiftCache)
+    {
+        CacheKey = mLiftCache->getKey(getBinaryBytes(getCurPtrBegin(), getCurPtrEnd()), getCurPtrBegin(), *F);
+        if (mLiftCache->load(CacheKey, F))
         {
-            F->insertBasicBlock(BB);
+            return true;
         }
-
-        // Update ptr
-        setCurPtrBegin(BB->getBasicBlockAddressEnd());
     }
 
-    if (F->empty())
+    // Only the code reachable from the begin of the function is translated
+    if (!translateReachableBasicBlocks(F))
     {
         return false;
     }
@@ -463,6 +870,11 @@ UnknownFrontendTranslatorImplX86::translateOneFunction(
     // Update function context
     UpdateFunctionContext(F);
 
+    if (mLiftCache)
+    {
+        mLiftCache->store(CacheKey, *F);
+    }
+
     return true;
 }
 
@@ -645,14 +1057,16 @@ UnknownFrontendTranslatorImplX86::loadRegister(uint32_t RegID, uint64_t Address,
             uir::IRBuilder IRB(BB);
             auto SavedRegVal = IRB.createLoad(RegisterPtr.value(), Address);
 
-            // Set new name
-            SavedRegVal->setName(getRegisterNameWithIndexByDefault(RegisterPtr.value()->getName()).c_str());
+            // Set new name, it is formatted straight into the name pool of the context
+            auto RegName = RegisterPtr.value()->getNameRef();
+            if (!RegName.empty())
+            {
+                auto RegIndex = getLiftingContext().RegisterCounterMap[getRegisterID(RegName.str())]++;
+                SavedRegVal->setName(RegName + unknown::Twine(RegIndex));
+            }
 
-            // Save SavedRegVal
+            // Save SavedRegVal, it is the value in the register until the register is written
             VRegInfoMap[VRegID].SavedRegVal = SavedRegVal;
-
-            // Set IsUpdated = true
-            VRegInfoMap[VRegID].IsUpdated = true;
         }
     }
 
@@ -676,6 +1090,59 @@ UnknownFrontendTranslatorImplX86::storeRegister(
     }
 }
 
+// Write the value to the register, false if the register has no pointer
+bool
+UnknownFrontendTranslatorImplX86::writeRegister(uint32_t RegID, uir::Value *Val, uint64_t Address, uir::BasicBlock *BB)
+{
+    assert(Val);
+    assert(BB);
+
+    auto RegisterPtr = getRegisterPtr(RegID);
+    if (!RegisterPtr)
+    {
+        return false;
+    }
+
+    uir::IRBuilder IRB(BB);
+    IRB.createStore(Val, RegisterPtr.value(), Address);
+
+    // Writing a 32-bit register clears the upper half of its 64-bit parent
+    auto TypeBits = getRegisterTypeBits(RegID);
+    if (TypeBits == 32 && getContext().getModeBits() == 64)
+    {
+        auto ParentRegPtr = getParentRegisterPtr(RegID);
+        if (!ParentRegPtr)
+        {
+            return false;
+        }
+
+        auto Ptr = ParentRegPtr.value();
+        auto Int32Ty = uir::Type::getIntNTy(getContext(), 32);
+        auto HighPtr = IRB.createGetBitPtr(
+            uir::Type::getIntNPtrTy(getContext(), 32),
+            Ptr,
+            uir::ConstantInt::get(
+                uir::Type::getIntNTy(getContext(), Ptr->getValueBits()),
+                unknown::APInt(Ptr->getValueBits(), 32)),
+            Address);
+        IRB.createStore(uir::ConstantInt::get(Int32Ty, unknown::APInt(32, 0)), HighPtr, Address);
+    }
+
+    // The values loaded from the overlapping registers are stale, the written one is the value of the register
+    auto VRegInfoMapOp = getVirtualRegisterInfo(RegID);
+    if (VRegInfoMapOp)
+    {
+        auto VRegID = getVirtualRegisterID(RegID);
+        for (auto &[ID, VRegInfo] : *VRegInfoMapOp.value())
+        {
+            VRegInfo.SavedRegVal = ID == VRegID ? Val : nullptr;
+            VRegInfo.IsUpdated = false;
+        }
+    }
+
+    return true;
+}
+
 // Get register ptr
 std::optional<uir::Value *>
 UnknownFrontendTranslatorImplX86::getRegisterPtr(uint32_t RegID)
@@ -809,7 +1276,7 @@ UnknownFrontendTranslatorImplX86::UpdateFunctionAttributes(
 {
     assert(F);
 
-    auto FunctionAddress = FunctionSymbol.rva + mBinary->imagebase();
+    auto FunctionAddress = FunctionSymbol.rva + mImage->getImageBase();
     auto FunctionSize = FunctionSymbol.size;
 
     F->setFunctionName(FunctionSymbol.name);
@@ -1,10 +1,15 @@
 #pragma once
 
-#include <LIEF/PE.hpp>
+#include <array>
+#include <utility>
 
+#include <UnknownUtils/unknown/ADT/ArrayRef.h>
 #include <UnknownUtils/unknown/Symbol/SymbolParser.h>
 
 #include <TranslatorImpl.h>
+#include <PEImage.h>
+
+#include "DecodedInstructionCache.x86.h"
 
 namespace ufrontend {
 
@@ -12,7 +17,10 @@ class UnknownFrontendTranslatorImplX86 : public UnknownFrontendTranslatorImpl
 {
 private:
     std::unique_ptr<unknown::SymbolParser> mSymbolParser;
-    std::unique_ptr<LIEF::PE::Binary> mBinary;
+    std::unique_ptr<PEImage> mImage;
+
+    // The instructions decoded by any lifting thread, a function or a pass decoding them again skips capstone
+    std::unique_ptr<DecodedInstructionCacheX86> mDecodedInstructionCache;
 
 private:
     bool mUsePDB;
@@ -40,6 +48,15 @@ protected:
     // Binary
     virtual void initBinary() override;
 
+    // Get the read-only bytes of [Address, MaxAddress) from the section containing Address
+    unknown::ArrayRef<uint8_t> getBinaryBytes(uint64_t Address, uint64_t MaxAddress) const;
+
+    // Fall back to the end of the section if the end of current pointer is not valid
+    void fixupCurPtrEnd();
+
+    // Derive the sizes of the function symbols which have none from the next symbol and the .pdata
+    void fixupFunctionSymbolSizes();
+
 protected:
     // x86-specific pointer
     const uint32_t getStackPointerRegister() const;
@@ -53,6 +70,28 @@ protected:
     // Init the instruction translator
     virtual void initTranslateInstruction() override;
 
+    // Decode the instruction at the begin of the code into Insn and step over it like cs_disasm_iter, the decoded
+    // instruction cache is looked up first
+    bool decodeInstruction(const uint8_t *&Code, size_t &CodeSize, uint64_t &Address, cs_insn *Insn);
+
+    // Translate the instructions from the begin to the end of current pointer into the block until a terminator
+    // instruction, false if no instruction is decoded
+    bool translateBasicBlockInstructions(uir::BasicBlock *BB, bool &EndsWithTerminatorInsn);
+
+    // Get the basic block beginning at the branch target, a pending one is created if there is none yet.
+    // nullptr if the target is out of the current function or the blocks of no function are recovered
+    uir::BasicBlock *getBasicBlockAt(uint64_t Address);
+
+    // Get a block jumping to the branch target out of the current function
+    uir::BasicBlock *getExitBasicBlock(uint64_t Target, uint64_t InstAddress);
+
+    // Move the instructions from the begin of the pending block out of the translated block containing it,
+    // false if it is in none
+    bool splitBasicBlockAt(uir::BasicBlock *PendingBB);
+
+    // Translate the basic blocks of the current function reachable from its begin by following the branches
+    bool translateReachableBasicBlocks(uir::Function *F);
+
 public:
     // Translate
     // Translate the given binary into UnknownIR
@@ -121,6 +160,9 @@ protected:
     // Store register
     virtual void storeRegister(const VirtualRegisterInfo &VRegInfo, uint64_t Address, uir::BasicBlock *BB) override;
 
+    // Write the value to the register, false if the register has no pointer
+    bool writeRegister(uint32_t RegID, uir::Value *Val, uint64_t Address, uir::BasicBlock *BB);
+
     // Get register ptr
     virtual std::optional<uir::Value *> getRegisterPtr(uint32_t RegID) override;
 
@@ -148,22 +190,35 @@ private:
     // Ret
     bool translateRetInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
 
-    // Mov
-    bool translateMovInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
+    // The families of X86SemanticsTable, add/sub/and/or/xor/cmp/test/inc/dec/mov.
+    // Every entry is instantiated into its own translator
+    template <size_t Index>
+    bool translateSemanticsInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
 
-    // Push/Pop
-    bool translatePushInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
-    bool translatePopInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
+    // Register the translators of X86SemanticsTable
+    template <size_t... Indices>
+    void initSemanticsInstructionTranslators(std::index_sequence<Indices...>);
+    void initSemanticsInstructionTranslators();
+
+    // Is the operand lifted by the translators of X86SemanticsTable? The IR can't address memory yet
+    bool isSemanticsOperandSupported(const cs_x86_op &Op) const;
+
+    // Read the register or immediate operand, nullptr if it is not supported
+    uir::Value *readSemanticsOperand(const cs_x86_op &Op, uint32_t TypeBits, uint64_t Address, uir::BasicBlock *BB);
 
     // Jcc
     bool translateJccInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
 
+    // Jmp
+    bool translateJmpInstruction(const cs_insn *Insn, uir::BasicBlock *BB);
+
     struct InstructionInfo
     {
         decltype(&translateUnknownX86Instruction) TranslateFunction = nullptr;
         bool IsBlockTerminatorInsn = false;
     };
-    std::unordered_map<uint32_t, InstructionInfo> mX86InstructionTranslatorMap;
+    // Indexed by x86_insn, the instructions without a translator are unknown
+    std::array<InstructionInfo, X86_INS_ENDING> mX86InstructionTranslatorTable;
 };
 
 } // namespace ufrontend
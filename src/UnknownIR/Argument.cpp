@@ -5,6 +5,7 @@
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
 
 namespace uir {
 
@@ -14,8 +15,7 @@ namespace uir {
 Argument::Argument(Type *Ty, const unknown::StringRef &ArgName, Function *F, uint32_t ArgNo) :
     Constant(Ty, ArgName), mParent(F), mArgNo(ArgNo)
 {
-    //
-    //
+    mValueID = ArgumentVal;
 }
 
 Argument::~Argument()
@@ -125,9 +125,8 @@ Argument::getPropertyArgNo() const
 void
 Argument::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the arg
@@ -138,33 +137,36 @@ Argument::print(unknown::XMLPrinter &Printer) const
 
     // name
     {
-        Printer.PushAttribute(getPropertyName().data(), getReadableName().c_str());
+        unknown::SmallString<64> Name;
+        unknown::raw_svector_ostream OSName(Name);
+        printReadableName(OSName);
+        Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     }
 
     // argno
     {
-        Printer.PushAttribute(getPropertyArgNo().data(), std::format("{}", getArgNo()).c_str());
+        Printer.PushAttribute(getPropertyArgNo().data(), getArgNo());
     }
 
     // extra
     {
-        std::string Extra("");
-        unknown::raw_string_ostream OSExtra(Extra);
+        unknown::SmallString<128> Extra;
+        unknown::raw_svector_ostream OSExtra(Extra);
         printExtraInfo(OSExtra);
-        if (!OSExtra.str().empty())
+        if (!Extra.empty())
         {
-            Printer.PushAttribute(getPropertyExtra().data(), OSExtra.str().c_str());
+            Printer.PushAttribute(getPropertyExtra().data(), Extra.c_str());
         }
     }
 
     // comment
     {
-        std::string Comment("");
-        unknown::raw_string_ostream OSComment(Comment);
+        unknown::SmallString<128> Comment;
+        unknown::raw_svector_ostream OSComment(Comment);
         printCommentInfo(OSComment);
-        if (!OSComment.str().empty())
+        if (!Comment.empty())
         {
-            Printer.PushAttribute(getPropertyComment().data(), OSComment.str().c_str());
+            Printer.PushAttribute(getPropertyComment().data(), Comment.c_str());
         }
     }
 
@@ -176,7 +178,7 @@ Argument::print(unknown::XMLPrinter &Printer) const
 Argument *
 Argument::get(Type *Ty, const unknown::StringRef &ArgName, Function *F, uint32_t ArgNo)
 {
-    return new Argument(Ty, ArgName, F, ArgNo);
+    return new (F ? F->getArena() : nullptr) Argument(Ty, ArgName, F, ArgNo);
 }
 
 } // namespace uir
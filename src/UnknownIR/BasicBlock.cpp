@@ -6,13 +6,16 @@
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
+
+#include <unknown/Support/Format.h>
 
 namespace uir {
 
 ////////////////////////////////////////////////////////////
 //     BasicBlock
 //
-BasicBlock::BasicBlock(Context &C) : BasicBlock(C, BasicBlock::generateOrderedBasicBlockName(C), 0, 0)
+BasicBlock::BasicBlock(Context &C) : BasicBlock(C, "", 0, 0)
 {
     //
 }
@@ -27,11 +30,15 @@ BasicBlock::BasicBlock(
     mBasicBlockName(BasicBlockName),
     mBasicBlockAddressBegin(BasicBlockAddressBegin),
     mBasicBlockAddressEnd(BasicBlockAddressEnd),
-    mParent(Parent)
+    mParent(Parent),
+    mLinked(false)
 {
-    if (mBasicBlockName.empty())
+    mValueID = BasicBlockVal;
+
+    // An anonymous block is numbered by its function, a block without one is numbered when it joins one
+    if (mBasicBlockName.empty() && Parent)
     {
-        mBasicBlockName = BasicBlock::generateOrderedBasicBlockName(C);
+        mBasicBlockName = std::to_string(Parent->nextBlockNameIndex());
     }
 }
 
@@ -150,6 +157,10 @@ void
 BasicBlock::setParent(Function *F)
 {
     mParent = F;
+    if (mBasicBlockName.empty() && F)
+    {
+        mBasicBlockName = std::to_string(F->nextBlockNameIndex());
+    }
 }
 
 // Get the begin address of this block
@@ -196,13 +207,7 @@ BasicBlock::getTerminator()
         return nullptr;
     }
 
-    auto Inst = *rbegin();
-    if (Inst == nullptr)
-    {
-        return nullptr;
-    }
-
-    return dynamic_cast<TerminatorInstruction *>(Inst);
+    return unknown::dyn_cast<TerminatorInstruction>(&back());
 }
 
 // Get the terminator instruction of this block
@@ -214,13 +219,7 @@ BasicBlock::getTerminator() const
         return nullptr;
     }
 
-    auto Inst = *rbegin();
-    if (Inst == nullptr)
-    {
-        return nullptr;
-    }
-
-    return dynamic_cast<const TerminatorInstruction *>(Inst);
+    return unknown::dyn_cast<TerminatorInstruction>(&back());
 }
 
 // Get the first predecessor of this block
@@ -248,12 +247,14 @@ BasicBlock::removeFromParent()
         return;
     }
 
-    if (mParent->getBasicBlockList().empty())
+    // The parent doesn't hold the block yet, there is nothing to unlink
+    if (!mLinked)
     {
+        mParent = nullptr;
         return;
     }
 
-    mParent->getBasicBlockList().remove(this);
+    mParent->erase(mParentIt);
 }
 
 // Remove the block from the its parent and delete it.
@@ -265,47 +266,29 @@ BasicBlock::eraseFromParent()
         return;
     }
 
-    if (mParent->getBasicBlockList().empty())
-    {
-        return;
-    }
-
-    for (auto It = mParent->getBasicBlockList().begin(); It != mParent->getBasicBlockList().end(); ++It)
-    {
-        if (*It == this)
-        {
-            mParent->getBasicBlockList().erase(It);
-            this->setParent(nullptr);
-            --It;
-        }
-    }
+    removeFromParent();
+    delete this;
 }
 
 // Insert an unlinked BasicBlock into a function immediately before/after the specified BasicBlock.
 void
 BasicBlock::insertBeforeOrAfter(BasicBlock *InsertPos, bool Before)
 {
-    if (InsertPos->getParent() == nullptr)
+    auto F = InsertPos->getParent();
+    if (F == nullptr || !InsertPos->mLinked)
     {
         return;
     }
 
-    auto InsertPosIt = InsertPos->getParent()->getBasicBlockList().begin();
-    for (; InsertPosIt != InsertPos->getParent()->getBasicBlockList().end(); ++InsertPosIt)
-    {
-        if (*InsertPosIt == InsertPos)
-        {
-            if (!Before)
-            {
-                ++InsertPosIt;
-            }
+    assert(!mLinked && "The block is already linked!");
 
-            break;
-        }
+    auto InsertPosIt = InsertPos->mParentIt;
+    if (!Before)
+    {
+        ++InsertPosIt;
     }
 
-    InsertPos->getParent()->getBasicBlockList().insert(InsertPosIt, this);
-    this->setParent(InsertPos->getParent());
+    F->insert(InsertPosIt, this);
 }
 
 // Insert an unlinked BasicBlock into a function immediately before the specified BasicBlock.
@@ -326,7 +309,7 @@ BasicBlock::insertAfter(BasicBlock *InsertPos)
 void
 BasicBlock::insertInst(Instruction *I)
 {
-    push(I);
+    push_back(I);
     I->setParent(this);
 }
 
@@ -339,13 +322,9 @@ BasicBlock::dropAllReferences()
         return;
     }
 
-    for (auto InstIt = begin(); InstIt != end(); ++InstIt)
+    for (auto &Inst : *this)
     {
-        auto Inst = *InstIt;
-        if (Inst)
-        {
-            Inst->dropAllReferences();
-        }
+        Inst.dropAllReferences();
     }
 }
 
@@ -362,45 +341,32 @@ BasicBlock::clearAllInstructions()
     dropAllReferences();
 
     // Clear all operands
-    for (auto InstIt = begin(); InstIt != end(); ++InstIt)
+    for (auto &Inst : *this)
     {
-        auto Inst = *InstIt;
-        if (Inst)
-        {
-            Inst->clearAllOperands();
-        }
+        Inst.clearAllOperands();
     }
 
-    // Free all instructions
-    std::vector<Instruction *> FreeInstList;
-    for (auto InstIt = begin(); InstIt != end(); ++InstIt)
+    // Unlink and free all instructions, an instruction is linked at most once
+    while (!empty())
     {
-        auto Inst = *InstIt;
-        if (Inst && Inst->user_empty())
+        auto &Inst = front();
+        pop_front();
+        Inst.setParent(nullptr);
+        if (Inst.user_empty())
         {
-            if (std::find(FreeInstList.begin(), FreeInstList.end(), Inst) == FreeInstList.end())
-            {
-                FreeInstList.push_back(Inst);
-                delete Inst;
-            }
+            delete &Inst;
         }
     }
-
-    // Clear instruction list
-    clear();
 }
 
 ////////////////////////////////////////////////////////////
 // Virtual functions
-// Get the readable name of this object
-std::string
-BasicBlock::getReadableName() const
+// Print the readable name of this object
+void
+BasicBlock::printReadableName(unknown::raw_ostream &OS) const
 {
     // block-bbname
-    std::string ReadableName = UIR_BLOCK_VARIABLE_NAME_PREFIX;
-    ReadableName += mBasicBlockName;
-
-    return ReadableName;
+    OS << UIR_BLOCK_VARIABLE_NAME_PREFIX << mBasicBlockName;
 }
 
 // Get the property 'bb' of the value
@@ -414,9 +380,8 @@ BasicBlock::getPropertyBB() const
 void
 BasicBlock::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the BasicBlock
@@ -427,47 +392,47 @@ BasicBlock::print(unknown::XMLPrinter &Printer) const
 
     // name
     {
-        Printer.PushAttribute(getPropertyName().data(), getReadableName().c_str());
+        unknown::SmallString<64> Name;
+        unknown::raw_svector_ostream OSName(Name);
+        printReadableName(OSName);
+        Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     }
 
     // range
     {
-        auto Range =
-            std::format("0x{:X}", getBasicBlockAddressBegin()) + "-" + std::format("0x{:X}", getBasicBlockAddressEnd());
+        unknown::SmallString<64> Range;
+        unknown::raw_svector_ostream OSRange(Range);
+        OSRange << unknown::format_hex(getBasicBlockAddressBegin(), 0, true) << "-"
+                << unknown::format_hex(getBasicBlockAddressEnd(), 0, true);
         Printer.PushAttribute(getPropertyRange().data(), Range.c_str());
     }
 
     // extra
     {
-        std::string Extra("");
-        unknown::raw_string_ostream OSExtra(Extra);
+        unknown::SmallString<128> Extra;
+        unknown::raw_svector_ostream OSExtra(Extra);
         printExtraInfo(OSExtra);
-        if (!OSExtra.str().empty())
+        if (!Extra.empty())
         {
-            Printer.PushAttribute(getPropertyExtra().data(), OSExtra.str().c_str());
+            Printer.PushAttribute(getPropertyExtra().data(), Extra.c_str());
         }
     }
 
     // comment
     {
-        std::string Comment("");
-        unknown::raw_string_ostream OSComment(Comment);
+        unknown::SmallString<128> Comment;
+        unknown::raw_svector_ostream OSComment(Comment);
         printCommentInfo(OSComment);
-        if (!OSComment.str().empty())
+        if (!Comment.empty())
         {
-            Printer.PushAttribute(getPropertyComment().data(), OSComment.str().c_str());
+            Printer.PushAttribute(getPropertyComment().data(), Comment.c_str());
         }
     }
 
     // inst
-    for (auto Inst : *this)
+    for (auto &Inst : *this)
     {
-        if (Inst == nullptr)
-        {
-            continue;
-        }
-
-        Inst->print(Printer);
+        Inst.print(Printer);
     }
 
     Printer.CloseElement();
@@ -475,14 +440,6 @@ BasicBlock::print(unknown::XMLPrinter &Printer) const
 
 ////////////////////////////////////////////////////////////
 // Static
-// Generate a new block name by order
-std::string
-BasicBlock::generateOrderedBasicBlockName(Context &C)
-{
-    auto CurIdx = C.mImpl->mOrderedBlockNameIndex++;
-    return std::to_string(CurIdx);
-}
-
 // Creates a new BasicBlock.
 BasicBlock *
 BasicBlock::get(Context &C)
@@ -506,7 +463,8 @@ BasicBlock::get(
     uint64_t BasicBlockAddressEnd,
     Function *Parent)
 {
-    return new BasicBlock(C, BasicBlockName, BasicBlockAddressBegin, BasicBlockAddressEnd, Parent);
+    return new (Parent ? Parent->getArena() : nullptr)
+        BasicBlock(C, BasicBlockName, BasicBlockAddressBegin, BasicBlockAddressEnd, Parent);
 }
 
 // Creates a new BasicBlock.
@@ -7,6 +7,7 @@
 #include <Internal/InternalConfig/InternalConfig.h>
 
 #include <unknown/ADT/StringExtras.h>
+#include <unknown/ADT/SmallString.h>
 
 namespace uir {
 ////////////////////////////////////////////////////////////
@@ -36,10 +37,11 @@ Constant::get(Type *Ty, const unknown::StringRef &ConstantName)
 ////////////////////////////////////////////////////////////
 //     ConstantInt
 //
-ConstantInt::ConstantInt(Type *Ty, const unknown::APInt &Val) : Constant(Ty, "0x" + Val.toString(16, false)), mVal(Val)
+ConstantInt::ConstantInt(Type *Ty, const unknown::APInt &Val) : Constant(Ty, ""), mVal(Val)
 {
-    //
-    //
+    mValueID = ConstantIntVal;
+    // ConstantInt is uniqued by the context
+    mIsShared = true;
 }
 
 ConstantInt::~ConstantInt()
@@ -84,16 +86,35 @@ ConstantInt::getBitWidth() const
 
 ////////////////////////////////////////////////////////////
 // Virtual functions
-// Get the readable name of this object
+// Get the name of this object, it is formatted when it is needed
 std::string
-ConstantInt::getReadableName() const
+ConstantInt::getName() const
 {
-    // 0x7b i32
-    std::string ReadableName = getName();
-    ReadableName += " ";
-    ReadableName += mType->getTypeName();
+    // 0x7b
+    if (!mValueName.empty())
+    {
+        return mValueName.str();
+    }
+
+    return "0x" + mVal.toString(16, false);
+}
 
-    return ReadableName;
+// Print the readable name of this object
+void
+ConstantInt::printReadableName(unknown::raw_ostream &OS) const
+{
+    // 0x7b i32
+    if (!mValueName.empty())
+    {
+        OS << mValueName;
+    }
+    else
+    {
+        unknown::SmallString<32> Hex;
+        mVal.toString(Hex, 16, false);
+        OS << "0x" << Hex;
+    }
+    OS << " " << mType->getTypeName();
 }
 
 ////////////////////////////////////////////////////////////
@@ -103,13 +124,7 @@ ConstantInt *
 ConstantInt::get(Context &Context, const unknown::APInt &Val)
 {
     ContextImpl *Impl = Context.mImpl;
-    ConstantInt *Slot = Impl->mIntConstants[Val];
-    if (Slot == nullptr)
-    {
-        // Get the corresponding integer type for the bit width of the value.
-        IntegerType *IntTy = IntegerType::get(Context, Val.getBitWidth());
-        Slot = new ConstantInt(IntTy, Val);
-    }
+    ConstantInt *Slot = Impl->getIntConstant(Val);
     assert(Slot->getType() == IntegerType::get(Context, Val.getBitWidth()));
     return Slot;
 }
@@ -91,4 +91,13 @@ Context::getModeBits()
     return 64;
 }
 
+////////////////////////////////////////////////////////////
+// Statistics
+// Get the number of ConstantInt allocated by this context
+uint64_t
+Context::getNumIntConstantsAllocated() const
+{
+    return mImpl->mNumIntConstantsAllocated;
+}
+
 } // namespace uir
@@ -1,10 +1,14 @@
 #include "ContextImpl.h"
 #include <Context.h>
+#include <Constant.h>
 #include <Type.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
 #include <Internal/InternalErrors/InternalErrors.h>
 
+#include <UnknownUtils/unknown/ADT/SmallString.h>
+#include <UnknownUtils/unknown/ADT/Twine.h>
+
 namespace uir {
 
 ContextImpl::ContextImpl(Context &C) :
@@ -12,7 +16,6 @@ ContextImpl::ContextImpl(Context &C) :
     mOrderedLocalVarNameIndex(0),
     mOrderedGlobalVarNameIndex(0),
     mOrderedFunctionNameIndex(0),
-    mOrderedBlockNameIndex(0),
     mVoidTy(C, "void", Type::VoidTyID, 0),
     mFloatTy(C, "float", Type::FloatTyID, 32),
     mDoubleTy(C, "double", Type::DoubleTyID, 64),
@@ -23,45 +26,63 @@ ContextImpl::ContextImpl(Context &C) :
     mInt16Ty(C, "i16", 16),
     mInt32Ty(C, "i32", 32),
     mInt64Ty(C, "i64", 64),
-    mInt128Ty(C, "i128", 128)
+    mInt128Ty(C, "i128", 128),
+    mIntegerTypeTable{},
+    mIntPointerTypeTable{},
+    mSmallIntConstants{},
+    mAllOnesIntConstants{},
+    mNumIntConstantsAllocated(0)
 {
+    // The built-in integer types
+    for (auto IntTy : {&mInt1Ty, &mInt8Ty, &mInt16Ty, &mInt32Ty, &mInt64Ty, &mInt128Ty})
+    {
+        mIntegerTypeTable[IntTy->getTypeBits()] = IntTy;
+    }
+
+    initSmallIntConstants();
 }
 
 ContextImpl::~ContextImpl()
 {
     clearOrderedNameIndex();
 
-    for (auto &IntTy : mIntegerTypes)
+    for (uint32_t NumBits = 0; NumBits < NumDenseIntBits; ++NumBits)
     {
-        if (IntTy.second)
-        {
-            delete IntTy.second;
-        }
+        delete mIntPointerTypeTable[NumBits].load();
 
-        IntTy.second = nullptr;
-    }
-
-    for (auto &PtrTy : mPointerTypes)
-    {
-        if (PtrTy.second)
+        // The built-in integer types are members
+        IntegerType *IntTy = mIntegerTypeTable[NumBits];
+        auto WidthIndex = getSmallIntWidthIndex(NumBits);
+        if (WidthIndex < 0 || IntTy != getSmallIntType(WidthIndex))
         {
-            delete PtrTy.second;
+            delete IntTy;
         }
-
-        PtrTy.second = nullptr;
     }
 
-    for (auto &CI : mIntConstants)
+    mIntegerTypes.clear([](IntegerType *IntTy) { delete IntTy; });
+    mPointerTypes.clear([](PointerType *PtrTy) { delete PtrTy; });
+    mIntConstants.clear([](ConstantInt *CI) { delete CI; });
+    mWideIntConstants.clear([](ConstantInt *CI) { delete CI; });
+
+    for (uint32_t WidthIndex = 0; WidthIndex < NumSmallIntWidths; ++WidthIndex)
     {
-        if (CI.second)
+        for (uint32_t Value = 0; Value < NumSmallIntValues; ++Value)
         {
-            delete CI.second;
+            if (mSmallIntConstants[WidthIndex][Value] == mAllOnesIntConstants[WidthIndex])
+            {
+                // Deleted with the all-ones constant
+                continue;
+            }
+
+            delete mSmallIntConstants[WidthIndex][Value];
         }
 
-        CI.second = nullptr;
+        delete mAllOnesIntConstants[WidthIndex];
     }
 }
 
+////////////////////////////////////////////////////////////
+// Ordered index
 // Clear all the name index.
 void
 ContextImpl::clearOrderedNameIndex()
@@ -69,7 +90,229 @@ ContextImpl::clearOrderedNameIndex()
     mOrderedLocalVarNameIndex = 0;
     mOrderedGlobalVarNameIndex = 0;
     mOrderedFunctionNameIndex = 0;
-    mOrderedBlockNameIndex = 0;
+}
+
+// Get the next name index, then increase it.
+uint64_t
+ContextImpl::nextOrderedLocalVarNameIndex()
+{
+    return mOrderedLocalVarNameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t
+ContextImpl::nextOrderedGlobalVarNameIndex()
+{
+    return mOrderedGlobalVarNameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t
+ContextImpl::nextOrderedFunctionNameIndex()
+{
+    return mOrderedFunctionNameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////
+// Name pool
+// Intern the name, the returned string lives as long as the context
+unknown::StringRef
+ContextImpl::internName(unknown::StringRef Name)
+{
+    if (Name.empty())
+    {
+        return unknown::StringRef();
+    }
+
+    auto &Shard = mNamePool[unknown::hash_value(Name) % NumNamePoolShards];
+    std::lock_guard<std::mutex> Lock(Shard.Mutex);
+    return Shard.Saver.save(Name);
+}
+
+////////////////////////////////////////////////////////////
+// Types
+// Get or create the uniqued IntegerType of the width
+IntegerType *
+ContextImpl::getIntegerType(uint32_t NumBits)
+{
+    if (NumBits >= NumDenseIntBits)
+    {
+        return mIntegerTypes.getOrCreate(NumBits, [this, NumBits]() { return createIntegerType(NumBits); });
+    }
+
+    auto &Slot = mIntegerTypeTable[NumBits];
+    IntegerType *IntTy = Slot.load(std::memory_order_acquire);
+    if (IntTy)
+    {
+        return IntTy;
+    }
+
+    // Publish the new type, the loser of a race frees its own
+    IntegerType *NewIntTy = createIntegerType(NumBits);
+    if (!Slot.compare_exchange_strong(IntTy, NewIntTy, std::memory_order_acq_rel))
+    {
+        delete NewIntTy;
+        return IntTy;
+    }
+
+    return NewIntTy;
+}
+
+// Get or create the uniqued PointerType of the element type
+PointerType *
+ContextImpl::getPointerType(Type *ElementType)
+{
+    assert(ElementType);
+
+    uint32_t NumBits = ElementType->getTypeBits();
+    if (!ElementType->isIntegerTy() || NumBits >= NumDenseIntBits ||
+        mIntegerTypeTable[NumBits].load(std::memory_order_acquire) != ElementType)
+    {
+        return mPointerTypes.getOrCreate(ElementType, [this, ElementType]() {
+            return createPointerType(ElementType);
+        });
+    }
+
+    auto &Slot = mIntPointerTypeTable[NumBits];
+    PointerType *PtrTy = Slot.load(std::memory_order_acquire);
+    if (PtrTy)
+    {
+        return PtrTy;
+    }
+
+    // Publish the new type, the loser of a race frees its own
+    PointerType *NewPtrTy = createPointerType(ElementType);
+    if (!Slot.compare_exchange_strong(PtrTy, NewPtrTy, std::memory_order_acq_rel))
+    {
+        delete NewPtrTy;
+        return PtrTy;
+    }
+
+    return NewPtrTy;
+}
+
+// Allocate a new IntegerType/PointerType
+IntegerType *
+ContextImpl::createIntegerType(uint32_t NumBits)
+{
+    // i256/i512
+    unknown::SmallString<16> TypeName;
+    ("i" + unknown::Twine(NumBits)).toVector(TypeName);
+    return new IntegerType(mContext, TypeName, NumBits);
+}
+
+PointerType *
+ContextImpl::createPointerType(Type *ElementType)
+{
+    // i8*/i16*/i32*/i64*
+    unknown::SmallString<16> TypeName(ElementType->getTypeName());
+    TypeName += UIR_PTR_TYPE_NAME_SUFFIX;
+    return new PointerType(mContext, ElementType, TypeName);
+}
+
+////////////////////////////////////////////////////////////
+// IntConstants
+// Get or create the uniqued ConstantInt of the value
+ConstantInt *
+ContextImpl::getIntConstant(const unknown::APInt &Val)
+{
+    uint32_t BitWidth = Val.getBitWidth();
+
+    // The small immediates don't take any lock
+    auto WidthIndex = getSmallIntWidthIndex(BitWidth);
+    if (WidthIndex >= 0)
+    {
+        if (Val.isAllOnesValue())
+        {
+            return mAllOnesIntConstants[WidthIndex];
+        }
+
+        if (Val.getActiveBits() <= 8)
+        {
+            return mSmallIntConstants[WidthIndex][Val.getZExtValue()];
+        }
+    }
+
+    if (BitWidth <= 64)
+    {
+        return mIntConstants.getOrCreate(
+            IntConstantKey{BitWidth, Val.getZExtValue()}, [this, &Val]() { return createIntConstant(Val); });
+    }
+
+    return mWideIntConstants.getOrCreate(Val, [this, &Val]() { return createIntConstant(Val); });
+}
+
+// Get the index of the preallocated width, -1 if it isn't preallocated
+int32_t
+ContextImpl::getSmallIntWidthIndex(uint32_t BitWidth)
+{
+    switch (BitWidth)
+    {
+    case 1:
+        return 0;
+    case 8:
+        return 1;
+    case 16:
+        return 2;
+    case 32:
+        return 3;
+    case 64:
+        return 4;
+    case 128:
+        return 5;
+    default:
+        return -1;
+    }
+}
+
+// Get the IntegerType of the preallocated width
+IntegerType *
+ContextImpl::getSmallIntType(uint32_t WidthIndex)
+{
+    IntegerType *SmallIntTypes[NumSmallIntWidths] = {&mInt1Ty, &mInt8Ty, &mInt16Ty, &mInt32Ty, &mInt64Ty, &mInt128Ty};
+    return SmallIntTypes[WidthIndex];
+}
+
+// Preallocate the small immediates
+void
+ContextImpl::initSmallIntConstants()
+{
+    for (uint32_t WidthIndex = 0; WidthIndex < NumSmallIntWidths; ++WidthIndex)
+    {
+        IntegerType *IntTy = getSmallIntType(WidthIndex);
+        uint32_t BitWidth = IntTy->getTypeBits();
+
+        mAllOnesIntConstants[WidthIndex] = new ConstantInt(IntTy, unknown::APInt::getAllOnesValue(BitWidth));
+        ++mNumIntConstantsAllocated;
+
+        for (uint64_t Value = 0; Value < NumSmallIntValues; ++Value)
+        {
+            unknown::APInt Val(BitWidth, Value);
+            if (Val.getZExtValue() != Value)
+            {
+                // The width can't hold the value
+                break;
+            }
+
+            if (Val.isAllOnesValue())
+            {
+                mSmallIntConstants[WidthIndex][Value] = mAllOnesIntConstants[WidthIndex];
+                continue;
+            }
+
+            mSmallIntConstants[WidthIndex][Value] = new ConstantInt(IntTy, Val);
+            ++mNumIntConstantsAllocated;
+        }
+    }
+}
+
+// Allocate a new ConstantInt
+ConstantInt *
+ContextImpl::createIntConstant(const unknown::APInt &Val)
+{
+    ++mNumIntConstantsAllocated;
+
+    // Get the corresponding integer type for the bit width of the value.
+    IntegerType *IntTy = IntegerType::get(mContext, Val.getBitWidth());
+    return new ConstantInt(IntTy, Val);
 }
 
 } // namespace uir
@@ -1,12 +1,18 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <map>
 #include <unordered_map>
 
 #include <Type.h>
+#include <ContextImpl/ShardedUniqueMap.h>
 
 #include <UnknownUtils/unknown/ADT/APInt.h>
+#include <UnknownUtils/unknown/ADT/Hashing.h>
+#include <UnknownUtils/unknown/Support/StringSaver.h>
 
 namespace uir {
 
@@ -18,12 +24,54 @@ class ContextImpl
 private:
     Context &mContext;
 
-public:
+private:
     // Ordered index
-    uint64_t mOrderedLocalVarNameIndex;
-    uint64_t mOrderedGlobalVarNameIndex;
-    uint64_t mOrderedFunctionNameIndex;
-    uint64_t mOrderedBlockNameIndex;
+    // The indexes are shared by all threads, the blocks and locals of a function are numbered by the function
+    std::atomic<uint64_t> mOrderedLocalVarNameIndex;
+    std::atomic<uint64_t> mOrderedGlobalVarNameIndex;
+    std::atomic<uint64_t> mOrderedFunctionNameIndex;
+
+private:
+    // Name pool
+    // The names of values are interned in shards, so that the lifting threads rarely wait for each other
+    struct NamePoolShard
+    {
+        std::mutex Mutex;
+        unknown::BumpPtrAllocator Allocator;
+        unknown::UniqueStringSaver Saver{Allocator};
+    };
+    static constexpr size_t NumNamePoolShards = 16;
+    std::array<NamePoolShard, NumNamePoolShards> mNamePool;
+
+public:
+    // The key of a ConstantInt no wider than 64 bits
+    struct IntConstantKey
+    {
+        uint32_t BitWidth;
+        uint64_t Value;
+
+        bool operator==(const IntConstantKey &RHS) const { return BitWidth == RHS.BitWidth && Value == RHS.Value; }
+    };
+
+    struct IntConstantKeyHash
+    {
+        size_t operator()(const IntConstantKey &Key) const { return unknown::hash_combine(Key.BitWidth, Key.Value); }
+    };
+
+    struct APIntHash
+    {
+        size_t operator()(const unknown::APInt &Val) const { return unknown::hash_value(Val); }
+    };
+
+    struct APIntEqual
+    {
+        bool operator()(const unknown::APInt &LHS, const unknown::APInt &RHS) const
+        {
+            return LHS.getBitWidth() == RHS.getBitWidth() && LHS == RHS;
+        }
+    };
+
+public:
 
     // Basic type instances
     Type mVoidTy;
@@ -40,22 +88,81 @@ public:
     IntegerType mInt64Ty;
     IntegerType mInt128Ty;
 
-    // IntegerTypes map
-    std::unordered_map<uint32_t, IntegerType *> mIntegerTypes;
+    // IntegerType/PointerType tables indexed by the bit width of the integer type
+    static constexpr uint32_t NumDenseIntBits = 1024;
+    std::atomic<IntegerType *> mIntegerTypeTable[NumDenseIntBits];
+    std::atomic<PointerType *> mIntPointerTypeTable[NumDenseIntBits];
 
-    // PointerType map
-    std::unordered_map<Type *, PointerType *> mPointerTypes;
+    // IntegerTypes map for the widths out of the table
+    ShardedUniqueMap<uint32_t, IntegerType> mIntegerTypes;
+
+    // PointerType map for the element types out of the table
+    ShardedUniqueMap<Type *, PointerType> mPointerTypes;
 
     // IntConstants map
-    std::map<unknown::APInt, ConstantInt *> mIntConstants;
+    ShardedUniqueMap<IntConstantKey, ConstantInt, IntConstantKeyHash> mIntConstants;
+    ShardedUniqueMap<unknown::APInt, ConstantInt, APIntHash, APIntEqual> mWideIntConstants;
+
+    // The preallocated small immediates 0..255 and -1 of i1/i8/i16/i32/i64/i128
+    static constexpr uint32_t NumSmallIntWidths = 6;
+    static constexpr uint32_t NumSmallIntValues = 256;
+    ConstantInt *mSmallIntConstants[NumSmallIntWidths][NumSmallIntValues];
+    ConstantInt *mAllOnesIntConstants[NumSmallIntWidths];
+
+    // The number of ConstantInt allocated by this context
+    std::atomic<uint64_t> mNumIntConstantsAllocated;
 
 public:
     explicit ContextImpl(Context &C);
     ~ContextImpl();
 
 public:
+    // Ordered index
     // Clear all the name index.
     void clearOrderedNameIndex();
+
+    // Get the next name index, then increase it.
+    uint64_t nextOrderedLocalVarNameIndex();
+    uint64_t nextOrderedGlobalVarNameIndex();
+    uint64_t nextOrderedFunctionNameIndex();
+
+public:
+    // Name pool
+    // Intern the name, the returned string lives as long as the context
+    unknown::StringRef internName(unknown::StringRef Name);
+
+public:
+    // Types
+    // Get or create the uniqued IntegerType of the width
+    IntegerType *getIntegerType(uint32_t NumBits);
+
+    // Get or create the uniqued PointerType of the element type
+    PointerType *getPointerType(Type *ElementType);
+
+private:
+    // Types
+    // Allocate a new IntegerType/PointerType
+    IntegerType *createIntegerType(uint32_t NumBits);
+    PointerType *createPointerType(Type *ElementType);
+
+public:
+    // IntConstants
+    // Get or create the uniqued ConstantInt of the value
+    ConstantInt *getIntConstant(const unknown::APInt &Val);
+
+private:
+    // IntConstants
+    // Get the index of the preallocated width, -1 if it isn't preallocated
+    static int32_t getSmallIntWidthIndex(uint32_t BitWidth);
+
+    // Get the IntegerType of the preallocated width
+    IntegerType *getSmallIntType(uint32_t WidthIndex);
+
+    // Preallocate the small immediates
+    void initSmallIntConstants();
+
+    // Allocate a new ConstantInt
+    ConstantInt *createIntConstant(const unknown::APInt &Val);
 };
 
 } // namespace uir
\ No newline at end of file
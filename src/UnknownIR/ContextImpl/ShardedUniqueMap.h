@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace uir {
+
+// A uniquing map split into independently locked shards.
+// Lookups of existing entries only take the shared lock of one shard.
+template <
+    typename KeyT,
+    typename ValueT,
+    typename HashT = std::hash<KeyT>,
+    typename EqualT = std::equal_to<KeyT>,
+    size_t NumShards = 16>
+class ShardedUniqueMap
+{
+private:
+    struct Shard
+    {
+        mutable std::shared_mutex Mutex;
+        std::unordered_map<KeyT, ValueT *, HashT, EqualT> Map;
+    };
+    std::array<Shard, NumShards> mShards;
+
+public:
+    ShardedUniqueMap() = default;
+    ShardedUniqueMap(const ShardedUniqueMap &) = delete;
+    ShardedUniqueMap &operator=(const ShardedUniqueMap &) = delete;
+
+public:
+    // Get the value of the key, it is created by CreateFn if it doesn't exist
+    template <typename CreateFnT>
+    ValueT *getOrCreate(const KeyT &Key, CreateFnT &&CreateFn)
+    {
+        auto &S = getShard(Key);
+        {
+            std::shared_lock<std::shared_mutex> Lock(S.Mutex);
+            auto It = S.Map.find(Key);
+            if (It != S.Map.end())
+            {
+                return It->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> Lock(S.Mutex);
+        auto &Slot = S.Map[Key];
+        if (Slot == nullptr)
+        {
+            Slot = CreateFn();
+        }
+        return Slot;
+    }
+
+    // Get the value of the key, nullptr if it doesn't exist
+    ValueT *lookup(const KeyT &Key) const
+    {
+        auto &S = getShard(Key);
+        std::shared_lock<std::shared_mutex> Lock(S.Mutex);
+        auto It = S.Map.find(Key);
+        return It != S.Map.end() ? It->second : nullptr;
+    }
+
+    // Get the number of entries
+    size_t size() const
+    {
+        size_t Size = 0;
+        for (auto &S : mShards)
+        {
+            std::shared_lock<std::shared_mutex> Lock(S.Mutex);
+            Size += S.Map.size();
+        }
+        return Size;
+    }
+
+    // Visit and then remove every entry, it must not race with getOrCreate
+    template <typename FnT>
+    void clear(FnT &&Fn)
+    {
+        for (auto &S : mShards)
+        {
+            std::unique_lock<std::shared_mutex> Lock(S.Mutex);
+            for (auto &Item : S.Map)
+            {
+                Fn(Item.second);
+            }
+            S.Map.clear();
+        }
+    }
+
+private:
+    Shard &getShard(const KeyT &Key) { return mShards[getShardIndex(Key)]; }
+    const Shard &getShard(const KeyT &Key) const { return mShards[getShardIndex(Key)]; }
+
+    static size_t getShardIndex(const KeyT &Key)
+    {
+        // Mix the high bits in, pointer hashes are aligned
+        uint64_t Hash = HashT()(Key);
+        Hash ^= Hash >> 33;
+        Hash *= 0xff51afd7ed558ccdULL;
+        Hash ^= Hash >> 33;
+        return static_cast<size_t>(Hash % NumShards);
+    }
+};
+
+} // namespace uir
@@ -12,6 +12,7 @@ namespace uir {
 //
 FlagsVariable::FlagsVariable(Type *Ty) : LocalVariable(Ty, "flags", 0)
 {
+    mValueID = FlagsVariableVal;
     mFlags.FlagsValue = 0;
 }
 
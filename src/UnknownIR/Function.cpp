@@ -8,6 +8,10 @@
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
+
+#include <unknown/Support/Format.h>
+#include <unknown/ADT/SmallPtrSet.h>
 
 namespace uir {
 
@@ -27,13 +31,18 @@ Function::Function(
     mFunctionAddressEnd(FunctionAddressEnd),
     mHasSEH(false),
     mHasAsyncEH(false),
-    mHasNaked(false)
+    mHasNaked(false),
+    mArena(nullptr),
+    mLocalVarNameIndex(0),
+    mBlockNameIndex(0)
 {
-    // Clear ordered block name index.
-    C.mImpl->mOrderedBlockNameIndex = 0;
+    mValueID = FunctionVal;
 
-    // Clear ordered local variable name index.
-    C.mImpl->mOrderedLocalVarNameIndex = 0;
+    // The functions of a module with an arena get their own arena
+    if (Parent && Parent->getArena())
+    {
+        enableArena();
+    }
 }
 
 Function::~Function()
@@ -81,7 +90,18 @@ Function::getFunctionEndAddress() const
 void
 Function::setFunctionBeginAddress(uint64_t FunctionBeginAddress)
 {
+    // Keep the address index of the parent in sync
+    if (mParent)
+    {
+        mParent->removeFunctionFromIndex(this);
+    }
+
     mFunctionAddressBegin = FunctionBeginAddress;
+
+    if (mParent)
+    {
+        mParent->addFunctionToIndex(this);
+    }
 }
 
 // Set the end address of this function
@@ -116,7 +136,9 @@ Function::getFunctionName() const
 void
 Function::setFunctionName(const unknown::StringRef &FunctionName)
 {
+    // The printed name and the indexed name are the same
     mFunctionName = FunctionName;
+    setName(FunctionName);
 }
 
 // Get the attributes of this function
@@ -175,6 +197,59 @@ Function::setNaked(bool HasNaked)
     mHasNaked = HasNaked;
 }
 
+////////////////////////////////////////////////////////////
+// Arena
+// Enable the arena of this function
+void
+Function::enableArena()
+{
+    if (!mArena)
+    {
+        mArena = std::make_unique<unknown::BumpPtrAllocator>();
+    }
+}
+
+// Get the arena of this function, nullptr if it is not enabled
+unknown::BumpPtrAllocator *
+Function::getArena() const
+{
+    return mArena.get();
+}
+
+////////////////////////////////////////////////////////////
+// Local names
+// Number the anonymous local variables of this function in print order, every instruction before its operands.
+void
+Function::numberLocals() const
+{
+    auto numberLocal = [this](const Value *V) {
+        auto LV = unknown::dyn_cast_or_null<LocalVariable>(V);
+        if (LV && !LV->hasName())
+        {
+            LV->setOrderedName(mLocalVarNameIndex++);
+        }
+    };
+
+    for (auto BB : *this)
+    {
+        for (auto &I : *BB)
+        {
+            numberLocal(&I);
+            for (auto OpIt = I.op_begin(); OpIt != I.op_end(); ++OpIt)
+            {
+                numberLocal(*OpIt);
+            }
+        }
+    }
+}
+
+// Get the next index of the anonymous blocks of this function, then increase it.
+uint64_t
+Function::nextBlockNameIndex()
+{
+    return mBlockNameIndex++;
+}
+
 ////////////////////////////////////////////////////////////
 // Function Attribute
 // Add function attribute to this function.
@@ -223,12 +298,7 @@ Function::removeFromParent()
         return;
     }
 
-    if (mParent->getFunctionList().empty())
-    {
-        return;
-    }
-
-    mParent->getFunctionList().remove(this);
+    mParent->removeFunction(this);
 }
 
 // Remove the function from the its parent and delete it.
@@ -240,20 +310,39 @@ Function::eraseFromParent()
         return;
     }
 
-    if (mParent->getFunctionList().empty())
-    {
-        return;
-    }
+    mParent->removeFunction(this);
+}
+
+// Insert the block before InsertPos, the block becomes a block of this function
+Function::iterator
+Function::insert(iterator InsertPos, BasicBlock *BB)
+{
+    assert(BB && !BB->mLinked);
+    BB->mParentIt = mBasicBlocksList.insert(InsertPos, BB);
+    BB->mLinked = true;
+    BB->setParent(this);
+    return BB->mParentIt;
+}
 
-    for (auto It = mParent->getFunctionList().begin(); It != mParent->getFunctionList().end(); ++It)
+// Unlink the block at It from this function, but does not delete it
+Function::iterator
+Function::erase(iterator It)
+{
+    (*It)->mParent = nullptr;
+    (*It)->mLinked = false;
+    return mBasicBlocksList.erase(It);
+}
+
+// Unlink all blocks from this function, but does not delete them
+void
+Function::clear()
+{
+    for (auto BB : mBasicBlocksList)
     {
-        if (*It == this)
-        {
-            mParent->getFunctionList().erase(It);
-            this->setParent(nullptr);
-            --It;
-        }
+        BB->mParent = nullptr;
+        BB->mLinked = false;
     }
+    mBasicBlocksList.clear();
 }
 
 // Insert a new basic block to this function
@@ -261,7 +350,6 @@ void
 Function::insertBasicBlock(BasicBlock *BB)
 {
     push_back(BB);
-    BB->setParent(this);
 }
 
 // Insert a new arg to this function
@@ -328,6 +416,18 @@ Function::clearAllBasicBlock()
     // Drop all blocks in this function
     dropAllReferences();
 
+    // Clear all operands first, an operand may be an instruction of another block
+    for (auto BB : *this)
+    {
+        if (BB)
+        {
+            for (auto &Inst : *BB)
+            {
+                Inst.clearAllOperands();
+            }
+        }
+    }
+
     // Clear all basic blocks
     for (auto BB : *this)
     {
@@ -338,53 +438,44 @@ Function::clearAllBasicBlock()
     }
 
     // Free all basic blocks
-    std::vector<BasicBlock *> FreeBBList;
+    unknown::SmallPtrSet<BasicBlock *, 16> FreeBBList;
     for (auto BB : *this)
     {
-        if (BB && BB->user_empty())
+        if (BB && BB->user_empty() && FreeBBList.insert(BB).second)
         {
-            if (std::find(FreeBBList.begin(), FreeBBList.end(), BB) == FreeBBList.end())
-            {
-                FreeBBList.push_back(BB);
-                delete BB;
-            }
+            delete BB;
         }
     }
 
     // Free all args
-    std::vector<Argument *> FreeArgsList;
+    unknown::SmallPtrSet<Argument *, 8> FreeArgsList;
     for (auto ArgIt = arg_begin(); ArgIt != arg_end(); ++ArgIt)
     {
         auto Arg = *ArgIt;
-        if (Arg && Arg->user_empty())
+        if (Arg && Arg->user_empty() && FreeArgsList.insert(Arg).second)
         {
-            if (std::find(FreeArgsList.begin(), FreeArgsList.end(), Arg) == FreeArgsList.end())
-            {
-                FreeArgsList.push_back(Arg);
-                delete Arg;
-            }
+            delete Arg;
         }
     }
 
     // Free all FCs
-    std::vector<FunctionContext *> FreeFCsList;
+    unknown::SmallPtrSet<FunctionContext *, 8> FreeFCsList;
     for (auto FCIt = fc_begin(); FCIt != fc_end(); ++FCIt)
     {
         auto FC = *FCIt;
-        if (FC && FC->user_empty())
+        if (FC && FC->user_empty() && FreeFCsList.insert(FC).second)
         {
-            if (std::find(FreeFCsList.begin(), FreeFCsList.end(), FC) == FreeFCsList.end())
-            {
-                FreeFCsList.push_back(FC);
-                delete FC;
-            }
+            delete FC;
         }
     }
 
-    // Clear list
-    clear();
+    // Clear list, the freed blocks are not unlinked one by one
+    mBasicBlocksList.clear();
     arg_clear();
     fc_clear();
+
+    // The anonymous local variables are numbered from 0 again
+    mLocalVarNameIndex = 0;
 }
 
 ////////////////////////////////////////////////////////////
@@ -393,21 +484,35 @@ Function::clearAllBasicBlock()
 std::string
 Function::generateOrderedFunctionName(Context &C)
 {
-    auto CurIdx = C.mImpl->mOrderedFunctionNameIndex++;
+    auto CurIdx = C.mImpl->nextOrderedFunctionNameIndex();
     return std::to_string(CurIdx);
 }
 
 ////////////////////////////////////////////////////////////
 // Virtual functions
-// Get the readable name of this object
-std::string
-Function::getReadableName() const
+// Set the name of the value, the name index of the parent is kept in sync
+void
+Function::setName(const unknown::Twine &ValueName)
 {
-    // function.func1
-    std::string ReadableName = UIR_FUNCTION_VARIABLE_NAME_PREFIX;
-    ReadableName += mFunctionName;
+    if (mParent)
+    {
+        mParent->removeFunctionFromIndex(this);
+    }
+
+    Value::setName(ValueName);
+
+    if (mParent)
+    {
+        mParent->addFunctionToIndex(this);
+    }
+}
 
-    return ReadableName;
+// Print the readable name of this object
+void
+Function::printReadableName(unknown::raw_ostream &OS) const
+{
+    // function.func1
+    OS << UIR_FUNCTION_VARIABLE_NAME_PREFIX << mFunctionName;
 }
 
 // Get the property 'f' of the value
@@ -442,69 +547,75 @@ Function::getPropertyContext() const
 void
 Function::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the function
 void
 Function::print(unknown::XMLPrinter &Printer) const
 {
+    numberLocals();
     Printer.OpenElement(getPropertyFunction().data());
 
     // name
     {
-        Printer.PushAttribute(getPropertyName().data(), getReadableName().c_str());
+        unknown::SmallString<64> Name;
+        unknown::raw_svector_ostream OSName(Name);
+        printReadableName(OSName);
+        Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     }
 
     // range
     {
-        auto Range =
-            std::format("0x{:X}", getFunctionBeginAddress()) + "-" + std::format("0x{:X}", getFunctionEndAddress());
+        unknown::SmallString<64> Range;
+        unknown::raw_svector_ostream OSRange(Range);
+        OSRange << unknown::format_hex(getFunctionBeginAddress(), 0, true) << "-"
+                << unknown::format_hex(getFunctionEndAddress(), 0, true);
         Printer.PushAttribute(getPropertyRange().data(), Range.c_str());
     }
 
     // attributes
     {
-        std::stringstream SS;
+        unknown::SmallString<128> Attributes;
+        unknown::raw_svector_ostream OSAttributes(Attributes);
         for (auto It = attr_begin(); It != attr_end(); ++It)
         {
-            auto Attr = *It;
+            auto &Attr = *It;
             if (Attr.empty())
             {
                 continue;
             }
 
-            SS << Attr;
+            OSAttributes << Attr;
             if (Attr != attr_back())
             {
-                SS << UIR_SEPARATOR;
+                OSAttributes << UIR_SEPARATOR;
             }
         }
 
-        Printer.PushAttribute(getPropertyAttributes().data(), SS.str().c_str());
+        Printer.PushAttribute(getPropertyAttributes().data(), Attributes.c_str());
     }
 
     // extra
     {
-        std::string Extra("");
-        unknown::raw_string_ostream OSExtra(Extra);
+        unknown::SmallString<128> Extra;
+        unknown::raw_svector_ostream OSExtra(Extra);
         printExtraInfo(OSExtra);
-        if (!OSExtra.str().empty())
+        if (!Extra.empty())
         {
-            Printer.PushAttribute(getPropertyExtra().data(), OSExtra.str().c_str());
+            Printer.PushAttribute(getPropertyExtra().data(), Extra.c_str());
         }
     }
 
     // comment
     {
-        std::string Comment("");
-        unknown::raw_string_ostream OSComment(Comment);
+        unknown::SmallString<128> Comment;
+        unknown::raw_svector_ostream OSComment(Comment);
         printCommentInfo(OSComment);
-        if (!OSComment.str().empty())
+        if (!Comment.empty())
         {
-            Printer.PushAttribute(getPropertyComment().data(), OSComment.str().c_str());
+            Printer.PushAttribute(getPropertyComment().data(), Comment.c_str());
         }
     }
 
@@ -554,7 +665,8 @@ Function::get(
     uint64_t FunctionAddressBegin,
     uint64_t FunctionAddressEnd)
 {
-    return new Function(C, FunctionName, Parent, FunctionAddressBegin, FunctionAddressEnd);
+    return new (Parent ? Parent->getArena() : nullptr)
+        Function(C, FunctionName, Parent, FunctionAddressBegin, FunctionAddressEnd);
 }
 
 } // namespace uir
@@ -5,6 +5,7 @@
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
 
 namespace uir {
 
@@ -14,8 +15,7 @@ namespace uir {
 FunctionContext::FunctionContext(Type *Ty, const unknown::StringRef &CtxName, Function *F, uint32_t CtxNo) :
     Constant(Ty, CtxName), mParent(F), mCtxNo(CtxNo)
 {
-    //
-    //
+    mValueID = FunctionContextVal;
 }
 
 FunctionContext::~FunctionContext()
@@ -124,9 +124,8 @@ FunctionContext::getPropertyFCNo() const
 void
 FunctionContext::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the fc
@@ -137,33 +136,36 @@ FunctionContext::print(unknown::XMLPrinter &Printer) const
 
     // name
     {
-        Printer.PushAttribute(getPropertyName().data(), getReadableName().c_str());
+        unknown::SmallString<64> Name;
+        unknown::raw_svector_ostream OSName(Name);
+        printReadableName(OSName);
+        Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     }
 
     // ctxno
     {
-        Printer.PushAttribute(getPropertyFCNo().data(), std::format("{}", mCtxNo).c_str());
+        Printer.PushAttribute(getPropertyFCNo().data(), mCtxNo);
     }
 
     // extra
     {
-        std::string Extra("");
-        unknown::raw_string_ostream OSExtra(Extra);
+        unknown::SmallString<128> Extra;
+        unknown::raw_svector_ostream OSExtra(Extra);
         printExtraInfo(OSExtra);
-        if (!OSExtra.str().empty())
+        if (!Extra.empty())
         {
-            Printer.PushAttribute(getPropertyExtra().data(), OSExtra.str().c_str());
+            Printer.PushAttribute(getPropertyExtra().data(), Extra.c_str());
         }
     }
 
     // comment
     {
-        std::string Comment("");
-        unknown::raw_string_ostream OSComment(Comment);
+        unknown::SmallString<128> Comment;
+        unknown::raw_svector_ostream OSComment(Comment);
         printCommentInfo(OSComment);
-        if (!OSComment.str().empty())
+        if (!Comment.empty())
         {
-            Printer.PushAttribute(getPropertyComment().data(), OSComment.str().c_str());
+            Printer.PushAttribute(getPropertyComment().data(), Comment.c_str());
         }
     }
 
@@ -175,7 +177,7 @@ FunctionContext::print(unknown::XMLPrinter &Printer) const
 FunctionContext *
 FunctionContext::get(Type *Ty, const unknown::StringRef &CtxName, Function *F, uint32_t CtxNo)
 {
-    return new FunctionContext(Ty, CtxName, F, CtxNo);
+    return new (F ? F->getArena() : nullptr) FunctionContext(Ty, CtxName, F, CtxNo);
 }
 
 } // namespace uir
@@ -5,6 +5,9 @@
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
+
+#include <unknown/Support/Format.h>
 
 namespace uir {
 
@@ -24,8 +27,7 @@ GlobalVariable::GlobalVariable(
     Module *Parent) :
     Constant(Ty, GlobalVariableName), mGlobalVariableAddress(GlobalVariableAddress), mParent(Parent)
 {
-    //
-    //
+    mValueID = GlobalVariableVal;
 }
 
 GlobalVariable::~GlobalVariable()
@@ -47,7 +49,44 @@ GlobalVariable::getGlobalVariableAddress() const
 void
 GlobalVariable::setGlobalVariableAddress(uint64_t GlobalVariableAddress)
 {
+    // Keep the address index of the parent in sync
+    if (mParent)
+    {
+        mParent->removeGlobalVariableFromIndex(this);
+    }
+
     mGlobalVariableAddress = GlobalVariableAddress;
+
+    if (mParent)
+    {
+        mParent->addGlobalVariableToIndex(this);
+    }
+}
+
+// Get the size of the data of this global variable
+uint64_t
+GlobalVariable::getGlobalVariableSize() const
+{
+    if (auto PtrTy = unknown::dyn_cast<PointerType>(getType()))
+    {
+        return PtrTy->getElementType()->getTypeSize();
+    }
+
+    return getValueSize();
+}
+
+// Is this global variable a GlobalArray?
+bool
+GlobalVariable::isGlobalArray() const
+{
+    return false;
+}
+
+// Get the bytes of the elements of the global array, they are empty if it has no serializable elements
+unknown::ArrayRef<uint8_t>
+GlobalVariable::getGlobalArrayData() const
+{
+    return {};
 }
 
 // Get parent module
@@ -74,12 +113,7 @@ GlobalVariable::removeFromParent()
         return;
     }
 
-    if (mParent->getGlobalVariableList().empty())
-    {
-        return;
-    }
-
-    mParent->getGlobalVariableList().remove(this);
+    mParent->removeGlobalVariable(this);
 }
 
 // Erase this global variable from its parent module
@@ -91,35 +125,34 @@ GlobalVariable::eraseFromParent()
         return;
     }
 
-    if (mParent->getGlobalVariableList().empty())
+    mParent->removeGlobalVariable(this);
+}
+
+////////////////////////////////////////////////////////////
+// Virtual functions
+// Set the name of the value, the name index of the parent is kept in sync
+void
+GlobalVariable::setName(const unknown::Twine &ValueName)
+{
+    if (mParent)
     {
-        return;
+        mParent->removeGlobalVariableFromIndex(this);
     }
 
-    for (auto It = mParent->getGlobalVariableList().begin(); It != mParent->getGlobalVariableList().end(); ++It)
+    Value::setName(ValueName);
+
+    if (mParent)
     {
-        if (*It == this)
-        {
-            mParent->getGlobalVariableList().erase(It);
-            this->setParent(nullptr);
-            --It;
-        }
+        mParent->addGlobalVariableToIndex(this);
     }
 }
 
-////////////////////////////////////////////////////////////
-// Virtual functions
-// Get the readable name of this object
-std::string
-GlobalVariable::getReadableName() const
+// Print the readable name of this object
+void
+GlobalVariable::printReadableName(unknown::raw_ostream &OS) const
 {
     // %global i32
-    std::string ReadableName = UIR_GLOBAL_VARIABLE_NAME_PREFIX;
-    ReadableName += mValueName;
-    ReadableName += " ";
-    ReadableName += mType->getTypeName();
-
-    return ReadableName;
+    OS << UIR_GLOBAL_VARIABLE_NAME_PREFIX << mValueName << " " << mType->getTypeName();
 }
 
 // Get the property 'gv' of the value
@@ -133,9 +166,8 @@ GlobalVariable::getPropertyGV() const
 void
 GlobalVariable::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the gv
@@ -146,33 +178,39 @@ GlobalVariable::print(unknown::XMLPrinter &Printer) const
 
     // name
     {
-        Printer.PushAttribute(getPropertyName().data(), getReadableName().c_str());
+        unknown::SmallString<64> Name;
+        unknown::raw_svector_ostream OSName(Name);
+        printReadableName(OSName);
+        Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     }
 
     // addr
     {
-        Printer.PushAttribute(getPropertyAddr().data(), std::format("0x{:X}", getGlobalVariableAddress()).c_str());
+        unknown::SmallString<32> Addr;
+        unknown::raw_svector_ostream OSAddr(Addr);
+        OSAddr << unknown::format_hex(getGlobalVariableAddress(), 0, true);
+        Printer.PushAttribute(getPropertyAddr().data(), Addr.c_str());
     }
 
     // extra
     {
-        std::string Extra("");
-        unknown::raw_string_ostream OSExtra(Extra);
+        unknown::SmallString<128> Extra;
+        unknown::raw_svector_ostream OSExtra(Extra);
         printExtraInfo(OSExtra);
-        if (!OSExtra.str().empty())
+        if (!Extra.empty())
         {
-            Printer.PushAttribute(getPropertyExtra().data(), OSExtra.str().c_str());
+            Printer.PushAttribute(getPropertyExtra().data(), Extra.c_str());
         }
     }
 
     // comment
     {
-        std::string Comment("");
-        unknown::raw_string_ostream OSComment(Comment);
+        unknown::SmallString<128> Comment;
+        unknown::raw_svector_ostream OSComment(Comment);
         printCommentInfo(OSComment);
-        if (!OSComment.str().empty())
+        if (!Comment.empty())
         {
-            Printer.PushAttribute(getPropertyComment().data(), OSComment.str().c_str());
+            Printer.PushAttribute(getPropertyComment().data(), Comment.c_str());
         }
     }
 
@@ -185,7 +223,7 @@ GlobalVariable::print(unknown::XMLPrinter &Printer) const
 std::string
 GlobalVariable::generateOrderedGlobalVarName(Context &C)
 {
-    auto CurIdx = C.mImpl->mOrderedGlobalVarNameIndex++;
+    auto CurIdx = C.mImpl->nextOrderedGlobalVarNameIndex();
     return std::to_string(CurIdx);
 }
 
@@ -18,9 +18,9 @@ IRBuilderDefaultInserter::InsertHelper(
 
     if (BB)
     {
-        BB->getInstList().insert(InsertPt, I);
         if (I)
         {
+            BB->insert(InsertPt, I);
             I->setParent(BB);
         }
     }
@@ -54,6 +54,18 @@ IRBuilderBase::getInsertPoint() const
     return mInsertPt;
 }
 
+// Get the arena of the function of the insert block, nullptr if there is none
+unknown::BumpPtrAllocator *
+IRBuilderBase::getArena() const
+{
+    if (mBB == nullptr || mBB->getParent() == nullptr)
+    {
+        return nullptr;
+    }
+
+    return mBB->getParent()->getArena();
+}
+
 ////////////////////////////////////////////////////////////
 // Insertion Point
 // Clear the insertion point
@@ -82,15 +94,7 @@ IRBuilderBase::setInsertPoint(Instruction *I)
     assert(BB != nullptr && "BB != nullptr");
 
     mBB = BB;
-
-    for (auto It = BB->begin(); It != BB->end(); ++It)
-    {
-        if ((*It) == I)
-        {
-            mInsertPt = It;
-            return;
-        }
-    }
+    mInsertPt = I->getIterator();
 }
 
 void
@@ -128,54 +132,102 @@ IRBuilder::IRBuilder(BasicBlock *BB, BasicBlock::iterator IT) : IRBuilder(BB->ge
 UnknownInstruction *
 IRBuilder::createUnknown(unknown::StringRef UnknownStr, uint64_t InstAddress)
 {
-    return insert(UnknownInstruction::get(getContext(), UnknownStr), InstAddress);
+    return insert(new (getArena()) UnknownInstruction(getContext(), UnknownStr), InstAddress);
 }
 
 // Return
 ReturnInstruction *
 IRBuilder::createRetVoid(uint64_t InstAddress)
 {
-    return insert(ReturnInstruction::get(getContext()), InstAddress);
+    return insert(new (getArena()) ReturnInstruction(getContext()), InstAddress);
 }
 
 ReturnImmInstruction *
 IRBuilder::createRetImm(ConstantInt *ImmConstantInt, uint64_t InstAddress)
 {
-    return insert(ReturnImmInstruction::get(getContext(), ImmConstantInt), InstAddress);
+    return insert(new (getArena()) ReturnImmInstruction(getContext(), ImmConstantInt), InstAddress);
 }
 
 // Jmp
 JmpAddrInstruction *
 IRBuilder::createJmpAddr(ConstantInt *JmpDest, uint64_t InstAddress)
 {
-    return insert(JmpAddrInstruction::get(getContext(), JmpDest), InstAddress);
+    return insert(new (getArena()) JmpAddrInstruction(getContext(), JmpDest), InstAddress);
 }
 
 JmpBBInstruction *
 IRBuilder::createJmpBB(BasicBlock *DestBB, uint64_t InstAddress)
 {
-    return insert(JmpBBInstruction::get(getContext(), DestBB), InstAddress);
+    return insert(new (getArena()) JmpBBInstruction(getContext(), DestBB), InstAddress);
+}
+
+// Jcc
+JccAddrInstruction *
+IRBuilder::createJccAddr(ConstantInt *JccDest, ConstantInt *JccNormal, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) JccAddrInstruction(getContext(), JccDest, JccNormal, FlagsVar), InstAddress);
+}
+
+JccBBInstruction *
+IRBuilder::createJccBB(BasicBlock *JccDestBB, BasicBlock *JccNormalBB, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) JccBBInstruction(getContext(), JccDestBB, JccNormalBB, FlagsVar), InstAddress);
 }
 
 // Load
 LoadInstruction *
 IRBuilder::createLoad(Value *Ptr, uint64_t InstAddress)
 {
-    return insert(LoadInstruction::get(Ptr), InstAddress);
+    return insert(new (getArena()) LoadInstruction(Ptr), InstAddress);
 }
 
 // Store
 StoreInstruction *
 IRBuilder::createStore(Value *Val, Value *Ptr, uint64_t InstAddress)
 {
-    return insert(StoreInstruction::get(getContext(), Val, Ptr, false), InstAddress);
+    return insert(new (getArena()) StoreInstruction(getContext(), Val, Ptr, false), InstAddress);
 }
 
 // GetBitPtr
 GetBitPtrInstruction *
 IRBuilder::createGetBitPtr(PointerType *ResType, Value *Ptr, Value *BitIndex, uint64_t InstAddress)
 {
-    return insert(GetBitPtrInstruction::get(ResType, Ptr, BitIndex), InstAddress);
+    return insert(new (getArena()) GetBitPtrInstruction(ResType, Ptr, BitIndex), InstAddress);
+}
+
+// Add
+AddInstruction *
+IRBuilder::createAdd(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) AddInstruction(LHS, RHS, FlagsVar), InstAddress);
+}
+
+// Sub
+SubInstruction *
+IRBuilder::createSub(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) SubInstruction(LHS, RHS, FlagsVar), InstAddress);
+}
+
+// Xor
+XorInstruction *
+IRBuilder::createXor(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) XorInstruction(LHS, RHS, FlagsVar), InstAddress);
+}
+
+// Or
+OrInstruction *
+IRBuilder::createOr(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) OrInstruction(LHS, RHS, FlagsVar), InstAddress);
+}
+
+// And
+AndInstruction *
+IRBuilder::createAnd(Value *LHS, Value *RHS, FlagsVariable *FlagsVar, uint64_t InstAddress)
+{
+    return insert(new (getArena()) AndInstruction(LHS, RHS, FlagsVar), InstAddress);
 }
 
 } // namespace uir
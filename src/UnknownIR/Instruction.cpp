@@ -8,8 +8,11 @@
 
 #include <Internal/InternalErrors/InternalErrors.h>
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
 
+#include <unknown/Support/Format.h>
 #include <unknown/ADT/StringExtras.h>
+#include <unknown/ADT/SmallPtrSet.h>
 
 namespace uir {
 ////////////////////////////////////////////////////////////
@@ -32,30 +35,18 @@ Instruction::Instruction(OpCodeID OpCodeId, Type *Ty) :
     mParent(nullptr),
     mFlagsVariable(nullptr),
     mStackVariable(nullptr),
+    mFlagsVariableUse(this),
+    mStackVariableUse(this),
     mEnablePrintOp(false)
 {
-    if (mFlagsVariable)
-    {
-        mFlagsVariable->user_insert(this);
-    }
-
-    if (mStackVariable)
-    {
-        mStackVariable->user_insert(this);
-    }
+    mValueID = InstructionVal;
 }
 
 Instruction::~Instruction()
 {
-    if (mFlagsVariable)
-    {
-        mFlagsVariable->user_erase(this);
-    }
-
-    if (mStackVariable)
-    {
-        mStackVariable->user_erase(this);
-    }
+    // Unlink the uses before the variables are freed
+    mFlagsVariableUse.set(nullptr);
+    mStackVariableUse.set(nullptr);
 }
 
 ////////////////////////////////////////////////////////////
@@ -120,9 +111,8 @@ Instruction::getPropertyOpCode() const
 void
 Instruction::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the full instruction
@@ -133,36 +123,39 @@ Instruction::print(unknown::XMLPrinter &Printer) const
 
     // addr
     {
-        Printer.PushAttribute(getPropertyAddr().data(), std::format("0x{:X}", getInstructionAddress()).c_str());
+        unknown::SmallString<32> Addr;
+        unknown::raw_svector_ostream OSAddr(Addr);
+        OSAddr << unknown::format_hex(getInstructionAddress(), 0, true);
+        Printer.PushAttribute(getPropertyAddr().data(), Addr.c_str());
     }
 
     // name
     {
-        std::string Name("");
-        unknown::raw_string_ostream OSName(Name);
+        unknown::SmallString<128> Name;
+        unknown::raw_svector_ostream OSName(Name);
         printInst(OSName);
-        Printer.PushAttribute(getPropertyName().data(), OSName.str().c_str());
+        Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     }
 
     // extra
     {
-        std::string Extra("");
-        unknown::raw_string_ostream OSExtra(Extra);
+        unknown::SmallString<128> Extra;
+        unknown::raw_svector_ostream OSExtra(Extra);
         printExtraInfo(OSExtra);
-        if (!OSExtra.str().empty())
+        if (!Extra.empty())
         {
-            Printer.PushAttribute(getPropertyExtra().data(), OSExtra.str().c_str());
+            Printer.PushAttribute(getPropertyExtra().data(), Extra.c_str());
         }
     }
 
     // comment
     {
-        std::string Comment("");
-        unknown::raw_string_ostream OSComment(Comment);
+        unknown::SmallString<128> Comment;
+        unknown::raw_svector_ostream OSComment(Comment);
         printCommentInfo(OSComment);
-        if (!OSComment.str().empty())
+        if (!Comment.empty())
         {
-            Printer.PushAttribute(getPropertyComment().data(), OSComment.str().c_str());
+            Printer.PushAttribute(getPropertyComment().data(), Comment.c_str());
         }
     }
 
@@ -192,15 +185,23 @@ Instruction::printOp(unknown::XMLPrinter &Printer) const
 
     for (uint32_t i = 0; i < getDefaultNumberOfOperands(); ++i)
     {
+        unknown::SmallString<64> OpName;
+        unknown::raw_svector_ostream OSOpName(OpName);
+        getOperand(i)->printReadableName(OSOpName);
+
         Printer.OpenElement(getPropertyOp().data());
-        Printer.PushAttribute(getPropertyName().data(), getOperand(i)->getReadableName().c_str());
+        Printer.PushAttribute(getPropertyName().data(), OpName.c_str());
         Printer.CloseElement();
     }
 
     if (hasResult())
     {
+        unknown::SmallString<64> ResName;
+        unknown::raw_svector_ostream OSResName(ResName);
+        printReadableName(OSResName);
+
         Printer.OpenElement(getPropertyOpRes().data());
-        Printer.PushAttribute(getPropertyName().data(), getReadableName().c_str());
+        Printer.PushAttribute(getPropertyName().data(), ResName.c_str());
         Printer.CloseElement();
     }
 }
@@ -242,13 +243,6 @@ Instruction::setParent(BasicBlock *BB)
     mParent = BB;
 }
 
-// Get the opcode of this instruction
-const OpCodeID
-Instruction::getOpCodeID() const
-{
-    return mOpCodeID;
-}
-
 // Set the opcode of this instruction
 void
 Instruction::setOpCodeID(OpCodeID OpCodeId)
@@ -274,6 +268,7 @@ Instruction::getFlagsVariable()
 void
 Instruction::setFlagsVariable(std::unique_ptr<FlagsVariable> &&FV)
 {
+    mFlagsVariableUse.set(nullptr);
     mFlagsVariable = std::move(FV);
 }
 
@@ -293,21 +288,11 @@ Instruction::setFlagsVariableAndUpdateUsers(FlagsVariable *FV)
         return;
     }
 
-    auto OldFlagsVariable = mFlagsVariable.get();
-
-    // Set the new flags variable
+    // Set the new flags variable, the use of the old one is unlinked
     setFlagsVariable(FV);
 
     // Update its users
-    if (OldFlagsVariable)
-    {
-        OldFlagsVariable->user_erase(this);
-    }
-
-    if (FV)
-    {
-        FV->user_insert(this);
-    }
+    mFlagsVariableUse.set(FV);
 }
 
 // Get the stack variable of this instruction
@@ -328,6 +313,7 @@ Instruction::getStackVariable()
 void
 Instruction::setStackVariable(std::unique_ptr<LocalVariable> &&SV)
 {
+    mStackVariableUse.set(nullptr);
     mStackVariable = std::move(SV);
 }
 
@@ -347,21 +333,11 @@ Instruction::setStackVariableAndUpdateUsers(LocalVariable *SV)
         return;
     }
 
-    auto OldStackVariable = mStackVariable.get();
-
-    // Set the new variable
+    // Set the new variable, the use of the old one is unlinked
     setStackVariable(SV);
 
     // Update its users
-    if (OldStackVariable)
-    {
-        OldStackVariable->user_erase(this);
-    }
-
-    if (SV)
-    {
-        SV->user_insert(this);
-    }
+    mStackVariableUse.set(SV);
 }
 
 ////////////////////////////////////////////////////////////
@@ -375,12 +351,8 @@ Instruction::removeFromParent()
         return;
     }
 
-    if (mParent->getInstList().empty())
-    {
-        return;
-    }
-
-    mParent->getInstList().remove(this);
+    mParent->remove(this);
+    setParent(nullptr);
 }
 
 // Remove this instruction from its parent and delete it.
@@ -392,47 +364,30 @@ Instruction::eraseFromParent()
         return;
     }
 
-    if (mParent->getInstList().empty())
-    {
-        return;
-    }
-
-    for (auto It = mParent->getInstList().begin(); It != mParent->getInstList().end(); ++It)
-    {
-        if (*It == this)
-        {
-            mParent->getInstList().erase(It);
-            this->setParent(nullptr);
-            --It;
-        }
-    }
+    removeFromParent();
+    delete this;
 }
 
 // Insert an unlinked instructions into a basic block immediately before/after the specified instruction.
 void
 Instruction::insertBeforeOrAfter(Instruction *InsertPos, bool Before)
 {
-    if (InsertPos->getParent() == nullptr)
+    auto BB = InsertPos->getParent();
+    if (BB == nullptr)
     {
         return;
     }
 
-    auto InsertPosIt = InsertPos->getParent()->getInstList().begin();
-    for (; InsertPosIt != InsertPos->getParent()->getInstList().end(); ++InsertPosIt)
-    {
-        if (*InsertPosIt == InsertPos)
-        {
-            if (!Before)
-            {
-                ++InsertPosIt;
-            }
+    assert(getParent() == nullptr && "The instruction is already linked!");
 
-            break;
-        }
+    auto InsertPosIt = InsertPos->getIterator();
+    if (!Before)
+    {
+        ++InsertPosIt;
     }
 
-    InsertPos->getParent()->getInstList().insert(InsertPosIt, this);
-    this->setParent(InsertPos->getParent());
+    BB->insert(InsertPosIt, this);
+    setParent(BB);
 }
 
 // Insert an unlinked instructions into a basic block immediately before the specified instruction.
@@ -458,14 +413,14 @@ Instruction::dropAllReferences()
     // Unlink flags variable from its user list
     if (mFlagsVariable)
     {
-        mFlagsVariable->user_erase(this);
+        mFlagsVariableUse.set(nullptr);
         mFlagsVariable = nullptr;
     }
 
     // Unlink stack variable from its user list
     if (mStackVariable)
     {
-        mStackVariable->user_erase(this);
+        mStackVariableUse.set(nullptr);
         mStackVariable = nullptr;
     }
 }
@@ -478,7 +433,7 @@ Instruction::clearAllOperands()
     dropAllReferences();
 
     // Free all operands
-    std::vector<Value *> FreeOperandsList;
+    unknown::SmallPtrSet<Value *, 4> FreeOperandsList;
     for (auto OPIt = op_begin(); OPIt != op_end(); ++OPIt)
     {
         auto OP = *OPIt;
@@ -492,39 +447,44 @@ Instruction::clearAllOperands()
             continue;
         }
 
-        if (auto CI = dynamic_cast<ConstantInt *>(OP))
+        if (unknown::isa<ConstantInt>(OP))
         {
             // We do not free constant integer
             continue;
         }
 
-        if (auto GV = dynamic_cast<GlobalVariable *>(OP))
+        if (unknown::isa<GlobalVariable>(OP))
         {
             // We do not free global variable
             continue;
         }
 
-        if (auto BB = dynamic_cast<BasicBlock *>(OP))
+        if (unknown::isa<BasicBlock>(OP))
         {
             // We do not free block
             continue;
         }
 
-        if (auto Arg = dynamic_cast<Argument *>(OP))
+        if (unknown::isa<Argument>(OP))
         {
             // We do not free argument
             continue;
         }
 
-        if (auto FC = dynamic_cast<FunctionContext *>(OP))
+        if (unknown::isa<FunctionContext>(OP))
         {
             // We do not free function context
             continue;
         }
 
-        if (std::find(FreeOperandsList.begin(), FreeOperandsList.end(), OP) == FreeOperandsList.end())
+        if (auto I = unknown::dyn_cast<Instruction>(OP); I && I->getParent())
+        {
+            // We do not free the instruction of a block, the block frees it
+            continue;
+        }
+
+        if (FreeOperandsList.insert(OP).second)
         {
-            FreeOperandsList.push_back(OP);
             delete OP;
         }
     }
@@ -708,4 +668,84 @@ TerminatorInstruction::eraseSuccessor(BasicBlock *BB)
     successor_erase(BB);
 }
 
+////////////////////////////////////////////////////////////
+//     BinaryInstruction
+//
+BinaryInstruction::BinaryInstruction(OpCodeID OpCodeId, Value *LHS, Value *RHS, FlagsVariable *FlagsVar) :
+    Instruction(OpCodeId, LHS->getType())
+{
+    // Insert LHS     -> op1
+    insertOperandAndUpdateUsers(LHS);
+
+    // Insert RHS     -> op2
+    insertOperandAndUpdateUsers(RHS);
+
+    // Set flags variable, the instructions that leave the flags alone have none
+    setFlagsVariableAndUpdateUsers(FlagsVar);
+}
+
+BinaryInstruction::~BinaryInstruction()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Virtual
+// Print the instruction
+void
+BinaryInstruction::printInst(unknown::raw_ostream &OS) const
+{
+    OS << this->getReadableName();
+    OS << UIR_OP_RESULT_SEPARATOR;
+    OS << getOpcodeName();
+    OS << UIR_OPCODE_SEPARATOR;
+    OS << getLHS()->getReadableName();
+    OS << UIR_OP_SEPARATOR;
+    OS << getRHS()->getReadableName();
+}
+
+////////////////////////////////////////////////////////////
+// Get/Set
+// Get the left operand of this instruction
+Value *
+BinaryInstruction::getLHS()
+{
+    return getOperand(0);
+}
+
+// Get the left operand of this instruction
+const Value *
+BinaryInstruction::getLHS() const
+{
+    return getOperand(0);
+}
+
+// Set the left operand of this instruction
+void
+BinaryInstruction::setLHS(Value *LHS)
+{
+    setOperandAndUpdateUsers(0, LHS);
+}
+
+// Get the right operand of this instruction
+Value *
+BinaryInstruction::getRHS()
+{
+    return getOperand(1);
+}
+
+// Get the right operand of this instruction
+const Value *
+BinaryInstruction::getRHS() const
+{
+    return getOperand(1);
+}
+
+// Set the right operand of this instruction
+void
+BinaryInstruction::setRHS(Value *RHS)
+{
+    setOperandAndUpdateUsers(1, RHS);
+}
+
 } // namespace uir
\ No newline at end of file
@@ -1 +1,55 @@
 #include <Instruction.h>
+#include <FlagsVariable.h>
+
+namespace uir {
+
+AddInstruction::AddInstruction(Value *LHS, Value *RHS, FlagsVariable *FlagsVar) :
+    BinaryInstruction(OpCodeID::Add, LHS, RHS, FlagsVar)
+{
+    //
+}
+
+AddInstruction::~AddInstruction()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Virtual
+// Get the opcode name of this instruction
+unknown::StringRef
+AddInstruction::getOpcodeName() const
+{
+    return AddComponent.mOpCodeName;
+}
+
+// Get the default number of operands
+uint32_t
+AddInstruction::getDefaultNumberOfOperands() const
+{
+    return AddComponent.mNumberOfOperands;
+}
+
+// Is this instruction with result?
+bool
+AddInstruction::hasResult() const
+{
+    return AddComponent.mHasResult;
+}
+
+// Is this instruction with flags?
+bool
+AddInstruction::hasFlags() const
+{
+    return AddComponent.mHasFlags;
+}
+
+////////////////////////////////////////////////////////////
+// Static
+AddInstruction *
+AddInstruction::get(Value *LHS, Value *RHS, FlagsVariable *FlagsVar)
+{
+    return new AddInstruction(LHS, RHS, FlagsVar);
+}
+
+} // namespace uir
@@ -0,0 +1,55 @@
+#include <Instruction.h>
+#include <FlagsVariable.h>
+
+namespace uir {
+
+AndInstruction::AndInstruction(Value *LHS, Value *RHS, FlagsVariable *FlagsVar) :
+    BinaryInstruction(OpCodeID::And, LHS, RHS, FlagsVar)
+{
+    //
+}
+
+AndInstruction::~AndInstruction()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Virtual
+// Get the opcode name of this instruction
+unknown::StringRef
+AndInstruction::getOpcodeName() const
+{
+    return AndComponent.mOpCodeName;
+}
+
+// Get the default number of operands
+uint32_t
+AndInstruction::getDefaultNumberOfOperands() const
+{
+    return AndComponent.mNumberOfOperands;
+}
+
+// Is this instruction with result?
+bool
+AndInstruction::hasResult() const
+{
+    return AndComponent.mHasResult;
+}
+
+// Is this instruction with flags?
+bool
+AndInstruction::hasFlags() const
+{
+    return AndComponent.mHasFlags;
+}
+
+////////////////////////////////////////////////////////////
+// Static
+AndInstruction *
+AndInstruction::get(Value *LHS, Value *RHS, FlagsVariable *FlagsVar)
+{
+    return new AndInstruction(LHS, RHS, FlagsVar);
+}
+
+} // namespace uir
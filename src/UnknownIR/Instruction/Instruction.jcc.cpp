@@ -3,6 +3,7 @@
 #include <BasicBlock.h>
 
 #include <unknown/ADT/StringExtras.h>
+#include <unknown/ADT/SmallString.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
 
@@ -79,14 +80,14 @@ JccAddrInstruction::printInst(unknown::raw_ostream &OS) const
 const ConstantInt *
 JccAddrInstruction::getJccDestConstantInt() const
 {
-    return dynamic_cast<const ConstantInt *>(getOperand(0));
+    return unknown::dyn_cast_or_null<ConstantInt>(getOperand(0));
 }
 
 // Get the JccNormal constant int
 const ConstantInt *
 JccAddrInstruction::getJccNormalConstantInt() const
 {
-    return dynamic_cast<const ConstantInt *>(getOperand(1));
+    return unknown::dyn_cast_or_null<ConstantInt>(getOperand(1));
 }
 
 // Set the JccDest constant int
@@ -185,12 +186,18 @@ JccBBInstruction::printOp(unknown::XMLPrinter &Printer) const
     Printer.PushAttribute(getPropertyName().data(), getOpcodeName().data());
     Printer.CloseElement();
 
+    unknown::SmallString<64> Name;
+    unknown::raw_svector_ostream OSName(Name);
+
+    getDestinationBlock()->printReadableName(OSName);
     Printer.OpenElement(getPropertyOp().data());
-    Printer.PushAttribute(getPropertyName().data(), getDestinationBlock()->getReadableName().c_str());
+    Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     Printer.CloseElement();
 
+    Name.clear();
+    getNormalBlock()->printReadableName(OSName);
     Printer.OpenElement(getPropertyOp().data());
-    Printer.PushAttribute(getPropertyName().data(), getNormalBlock()->getReadableName().c_str());
+    Printer.PushAttribute(getPropertyName().data(), Name.c_str());
     Printer.CloseElement();
 }
 
@@ -2,6 +2,7 @@
 #include <BasicBlock.h>
 
 #include <unknown/ADT/StringExtras.h>
+#include <unknown/ADT/SmallString.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
 
@@ -65,7 +66,7 @@ JmpAddrInstruction::printInst(unknown::raw_ostream &OS) const
 const ConstantInt *
 JmpAddrInstruction::getJmpDestConstantInt() const
 {
-    return dynamic_cast<const ConstantInt *>(getOperand(0));
+    return unknown::dyn_cast_or_null<ConstantInt>(getOperand(0));
 }
 
 // Set the JmpDest constant int
@@ -144,8 +145,12 @@ JmpBBInstruction::printOp(unknown::XMLPrinter &Printer) const
     Printer.PushAttribute(getPropertyName().data(), getOpcodeName().data());
     Printer.CloseElement();
 
+    unknown::SmallString<64> DestName;
+    unknown::raw_svector_ostream OSDestName(DestName);
+    getDestinationBlock()->printReadableName(OSDestName);
+
     Printer.OpenElement(getPropertyOp().data());
-    Printer.PushAttribute(getPropertyName().data(), getDestinationBlock()->getReadableName().c_str());
+    Printer.PushAttribute(getPropertyName().data(), DestName.c_str());
     Printer.CloseElement();
 }
 
@@ -7,7 +7,7 @@ namespace uir {
 LoadInstruction::LoadInstruction(Value *Ptr) :
     Instruction(
         OpCodeID::Load,
-        Ptr->getType()->isPointerTy() ? dynamic_cast<PointerType *>(Ptr->getType())->getElementType()
+        Ptr->getType()->isPointerTy() ? unknown::cast<PointerType>(Ptr->getType())->getElementType()
                                       : Type::getVoidTy(getContext()))
 {
     assert(Ptr->getType()->isPointerTy() && "Ptr must be a pointer type!");
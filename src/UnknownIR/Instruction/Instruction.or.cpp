@@ -0,0 +1,55 @@
+#include <Instruction.h>
+#include <FlagsVariable.h>
+
+namespace uir {
+
+OrInstruction::OrInstruction(Value *LHS, Value *RHS, FlagsVariable *FlagsVar) :
+    BinaryInstruction(OpCodeID::Or, LHS, RHS, FlagsVar)
+{
+    //
+}
+
+OrInstruction::~OrInstruction()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Virtual
+// Get the opcode name of this instruction
+unknown::StringRef
+OrInstruction::getOpcodeName() const
+{
+    return OrComponent.mOpCodeName;
+}
+
+// Get the default number of operands
+uint32_t
+OrInstruction::getDefaultNumberOfOperands() const
+{
+    return OrComponent.mNumberOfOperands;
+}
+
+// Is this instruction with result?
+bool
+OrInstruction::hasResult() const
+{
+    return OrComponent.mHasResult;
+}
+
+// Is this instruction with flags?
+bool
+OrInstruction::hasFlags() const
+{
+    return OrComponent.mHasFlags;
+}
+
+////////////////////////////////////////////////////////////
+// Static
+OrInstruction *
+OrInstruction::get(Value *LHS, Value *RHS, FlagsVariable *FlagsVar)
+{
+    return new OrInstruction(LHS, RHS, FlagsVar);
+}
+
+} // namespace uir
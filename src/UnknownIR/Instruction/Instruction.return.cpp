@@ -123,7 +123,7 @@ ReturnImmInstruction::printInst(unknown::raw_ostream &OS) const
 const ConstantInt *
 ReturnImmInstruction::getImmConstantInt() const
 {
-    return dynamic_cast<const ConstantInt *>(getOperand(0));
+    return unknown::dyn_cast_or_null<ConstantInt>(getOperand(0));
 }
 
 // Set the immediate constant int
@@ -1 +1,55 @@
 #include <Instruction.h>
+#include <FlagsVariable.h>
+
+namespace uir {
+
+SubInstruction::SubInstruction(Value *LHS, Value *RHS, FlagsVariable *FlagsVar) :
+    BinaryInstruction(OpCodeID::Sub, LHS, RHS, FlagsVar)
+{
+    //
+}
+
+SubInstruction::~SubInstruction()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Virtual
+// Get the opcode name of this instruction
+unknown::StringRef
+SubInstruction::getOpcodeName() const
+{
+    return SubComponent.mOpCodeName;
+}
+
+// Get the default number of operands
+uint32_t
+SubInstruction::getDefaultNumberOfOperands() const
+{
+    return SubComponent.mNumberOfOperands;
+}
+
+// Is this instruction with result?
+bool
+SubInstruction::hasResult() const
+{
+    return SubComponent.mHasResult;
+}
+
+// Is this instruction with flags?
+bool
+SubInstruction::hasFlags() const
+{
+    return SubComponent.mHasFlags;
+}
+
+////////////////////////////////////////////////////////////
+// Static
+SubInstruction *
+SubInstruction::get(Value *LHS, Value *RHS, FlagsVariable *FlagsVar)
+{
+    return new SubInstruction(LHS, RHS, FlagsVar);
+}
+
+} // namespace uir
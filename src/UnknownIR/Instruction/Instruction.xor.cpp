@@ -0,0 +1,55 @@
+#include <Instruction.h>
+#include <FlagsVariable.h>
+
+namespace uir {
+
+XorInstruction::XorInstruction(Value *LHS, Value *RHS, FlagsVariable *FlagsVar) :
+    BinaryInstruction(OpCodeID::Xor, LHS, RHS, FlagsVar)
+{
+    //
+}
+
+XorInstruction::~XorInstruction()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Virtual
+// Get the opcode name of this instruction
+unknown::StringRef
+XorInstruction::getOpcodeName() const
+{
+    return XorComponent.mOpCodeName;
+}
+
+// Get the default number of operands
+uint32_t
+XorInstruction::getDefaultNumberOfOperands() const
+{
+    return XorComponent.mNumberOfOperands;
+}
+
+// Is this instruction with result?
+bool
+XorInstruction::hasResult() const
+{
+    return XorComponent.mHasResult;
+}
+
+// Is this instruction with flags?
+bool
+XorInstruction::hasFlags() const
+{
+    return XorComponent.mHasFlags;
+}
+
+////////////////////////////////////////////////////////////
+// Static
+XorInstruction *
+XorInstruction::get(Value *LHS, Value *RHS, FlagsVariable *FlagsVar)
+{
+    return new XorInstruction(LHS, RHS, FlagsVar);
+}
+
+} // namespace uir
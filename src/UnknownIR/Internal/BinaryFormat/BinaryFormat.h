@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+
+namespace uir {
+namespace binary {
+
+////////////////////////////////////////////////////////////
+// The binary UIR container
+//
+// Header       fixed size, little-endian
+// Bodies       the function bodies, each one is decoded on its own
+// StringTable  ULEB count, then ULEB length + bytes for each string
+// TypeTable    ULEB count, then the type id (+ bits or element type) for each type
+// GlobalTable  ULEB count, then the globals of the module and the ones referenced by its functions, the elements of
+//              a global array follow its address
+// ModuleTable  module name, arch, mode, then the index of the functions with the offsets of their bodies
+//
+// All the other integers are LEB128, the names are indexes into the string table.
+//
+// A function body is flags, annotation, attributes, arguments, function contexts, block headers, detached values,
+// then the predecessors and instructions of each block. The local values are numbered by slot in the order they are
+// defined, a reference to a slot which is not defined yet carries its type (ForwardLocalRef).
+
+// "UIRB"
+constexpr uint8_t Magic[4] = {'U', 'I', 'R', 'B'};
+constexpr uint32_t Version = 2;
+
+// The offsets of the fields of the header
+constexpr uint64_t HeaderMagicOffset = 0;
+constexpr uint64_t HeaderVersionOffset = 4;
+constexpr uint64_t HeaderStringTableOffset = 8;
+constexpr uint64_t HeaderTypeTableOffset = 16;
+constexpr uint64_t HeaderGlobalTableOffset = 24;
+constexpr uint64_t HeaderModuleTableOffset = 32;
+constexpr uint64_t HeaderSize = 40;
+
+// The kind of a value reference
+enum ValueRefKind : uint8_t
+{
+    NullRef,
+    ConstantIntRef,
+    GlobalRef,
+    LocalRef,
+    ForwardLocalRef,
+    BasicBlockRef,
+    ArgumentRef,
+    FunctionContextRef,
+    FunctionRef,
+};
+
+// The kind of a global
+enum GlobalKind : uint8_t
+{
+    PlainGlobal,
+    ArrayGlobal,
+};
+
+// The kind of a function-local value that is not in a block
+enum DetachedValueKind : uint8_t
+{
+    DetachedLocalVariable,
+    DetachedFlagsVariable,
+    DetachedInstruction,
+};
+
+// The flags of a function
+enum FunctionFlags : uint8_t
+{
+    FunctionHasSEH = 1 << 0,
+    FunctionHasAsyncEH = 1 << 1,
+    FunctionHasNaked = 1 << 2,
+};
+
+// The flags of an instruction
+enum InstructionFlags : uint8_t
+{
+    InstructionHasFlagsVariable = 1 << 0,
+    InstructionHasStackVariable = 1 << 1,
+    InstructionIsVolatile = 1 << 2,
+    InstructionHasPrintOp = 1 << 3,
+};
+
+} // namespace binary
+} // namespace uir
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdarg>
+#include <cstdio>
+
+#include <unknown/ADT/SmallString.h>
+#include <unknown/ADT/StringRef.h>
+#include <unknown/Support/raw_ostream.h>
+#include <unknown/tinyxml2/tinyxml2.h>
+
+namespace uir {
+
+// An XMLPrinter that writes the elements into the stream as they are printed, the document is never built in
+// memory. The stream does the buffering, the output is the same as the one of the in-memory printer.
+class XMLStreamPrinter : public unknown::XMLPrinter
+{
+private:
+    unknown::raw_ostream &mOS;
+
+public:
+    // The elements are indented from Depth, a function printed on its own is at the depth of the functions in the module
+    explicit XMLStreamPrinter(unknown::raw_ostream &OS, int Depth = 0) : unknown::XMLPrinter(nullptr, false, Depth), mOS(OS)
+    {
+    }
+
+public:
+    // Write the elements printed by a new printer at the depth of the open element. The open element is sealed and
+    // the line break is written here, a new printer doesn't write one before its first element.
+    void writeElements(unknown::StringRef Elements)
+    {
+        if (Elements.empty())
+        {
+            return;
+        }
+
+        SealElementIfJustOpened();
+        Putc('\n');
+        Write(Elements.data(), Elements.size());
+    }
+
+protected:
+    virtual void Print(const char *Format, ...) override
+    {
+        va_list Args;
+        va_start(Args, Format);
+        va_list ArgsCopy;
+        va_copy(ArgsCopy, Args);
+
+        // The formatted text is small, it fits the inline buffer
+        unknown::SmallString<128> Buffer;
+        int Length = vsnprintf(Buffer.data(), Buffer.capacity(), Format, Args);
+        if (Length >= 0 && static_cast<size_t>(Length) >= Buffer.capacity())
+        {
+            Buffer.reserve(Length + 1);
+            Length = vsnprintf(Buffer.data(), Buffer.capacity(), Format, ArgsCopy);
+        }
+
+        va_end(ArgsCopy);
+        va_end(Args);
+
+        if (Length > 0)
+        {
+            mOS.write(Buffer.data(), Length);
+        }
+    }
+
+    virtual void Write(const char *Data, size_t Size) override { mOS.write(Data, Size); }
+
+    virtual void Putc(char Ch) override { mOS << Ch; }
+};
+
+} // namespace uir
@@ -1,20 +1,22 @@
 #include <LocalVariable.h>
+#include <Instruction.h>
+#include <BasicBlock.h>
+#include <Function.h>
 
 #include <Context.h>
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
 
+#include <unknown/ADT/SmallString.h>
+
 namespace uir {
 
 ////////////////////////////////////////////////////////////
 //     LocalVariable
 //
 LocalVariable::LocalVariable(Type *Ty) :
-    LocalVariable(
-        Ty,
-        Ty == Type::getVoidTy(Ty->getContext()) ? "LocalVoid" : generateOrderedLocalVarName(Ty->getContext()),
-        0)
+    LocalVariable(Ty, Ty == Type::getVoidTy(Ty->getContext()) ? "LocalVoid" : "", 0)
 {
     //
 }
@@ -22,7 +24,7 @@ LocalVariable::LocalVariable(Type *Ty) :
 LocalVariable::LocalVariable(Type *Ty, const unknown::StringRef &LocalVariableName, uint64_t LocalVariableAddress) :
     Constant(Ty, LocalVariableName), mLocalVariableAddress(LocalVariableAddress)
 {
-    //
+    mValueID = LocalVariableVal;
 }
 
 LocalVariable::~LocalVariable()
@@ -46,13 +48,65 @@ LocalVariable::setLocalVariableAddress(uint64_t LocalVariableAddress)
     mLocalVariableAddress = LocalVariableAddress;
 }
 
+// Name this anonymous local variable by its index in its function, the name is cached like a lazy name
+void
+LocalVariable::setOrderedName(uint64_t Index) const
+{
+    unknown::SmallString<16> NameBuffer;
+    mValueName = internName(mType, unknown::Twine(Index).toStringRef(NameBuffer));
+}
+
+////////////////////////////////////////////////////////////
+// Virtual functions
+// Get the name of this local variable, the function using an anonymous one numbers its locals first
+std::string
+LocalVariable::getName() const
+{
+    if (!hasName())
+    {
+        if (auto F = getUsingFunction())
+        {
+            F->numberLocals();
+        }
+    }
+
+    // A local outside of any function takes the next number of the context
+    if (!hasName())
+    {
+        setOrderedName(getContext().mImpl->nextOrderedLocalVarNameIndex());
+    }
+
+    return mValueName.str();
+}
+
+// Get the function that uses this local variable, nullptr if there is none
+const Function *
+LocalVariable::getUsingFunction() const
+{
+    if (auto I = unknown::dyn_cast<Instruction>(this))
+    {
+        return I->getParent() ? I->getParent()->getParent() : nullptr;
+    }
+
+    for (auto It = user_begin(); It != user_end(); ++It)
+    {
+        auto I = unknown::dyn_cast<Instruction>(*It);
+        if (I && I->getParent() && I->getParent()->getParent())
+        {
+            return I->getParent()->getParent();
+        }
+    }
+
+    return nullptr;
+}
+
 ////////////////////////////////////////////////////////////
 // Static
 // Generate a new value name by order
 std::string
 LocalVariable::generateOrderedLocalVarName(Context &C)
 {
-    auto CurIdx = C.mImpl->mOrderedLocalVarNameIndex++;
+    auto CurIdx = C.mImpl->nextOrderedLocalVarNameIndex();
     return std::to_string(CurIdx);
 }
 
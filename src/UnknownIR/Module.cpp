@@ -4,6 +4,14 @@
 #include <ContextImpl/ContextImpl.h>
 
 #include <Internal/InternalConfig/InternalConfig.h>
+#include <Internal/XMLStreamPrinter/XMLStreamPrinter.h>
+
+#include <unknown/ADT/SmallPtrSet.h>
+#include <unknown/Support/ThreadPool.h>
+#include <unknown/Support/Threading.h>
+
+#include <algorithm>
+#include <atomic>
 
 namespace uir {
 
@@ -62,6 +70,25 @@ Module::getContext() const
     return mContext;
 }
 
+////////////////////////////////////////////////////////////
+// Arena
+// Enable the arena of this module
+void
+Module::enableArena()
+{
+    if (!mArena)
+    {
+        mArena = std::make_unique<unknown::BumpPtrAllocator>();
+    }
+}
+
+// Get the arena of this module, nullptr if it is not enabled
+unknown::BumpPtrAllocator *
+Module::getArena() const
+{
+    return mArena.get();
+}
+
 ////////////////////////////////////////////////////////////
 // Get/Set
 // Get/Set the name of module
@@ -92,70 +119,105 @@ Module::getReadableName() const
 std::optional<Function *>
 Module::getFunction(const unknown::StringRef &FunctionName) const
 {
-    for (auto Func : mFunctionList)
+    auto It = mFunctionNameIndex.find(FunctionName);
+    if (It == mFunctionNameIndex.end())
     {
-        if (Func->getName().compare(FunctionName) == 0)
-        {
-            return Func;
-        }
+        return {};
     }
 
-    return {};
+    return It->second;
 }
 
 // Get the specified function by address in the module
 std::optional<Function *>
 Module::getFunction(uint64_t Address) const
 {
-    for (auto Func : mFunctionList)
+    auto It = mFunctionAddressIndex.find(Address);
+    if (It == mFunctionAddressIndex.end())
     {
-        if (Func->getFunctionBeginAddress() == Address)
-        {
-            return Func;
-        }
+        return {};
     }
 
-    return {};
+    return It->second;
 }
 
 // Get the specified global variable by name in the module
 std::optional<GlobalVariable *>
 Module::getGlobalVariable(const unknown::StringRef &GlobalVariableName) const
 {
-    for (auto GV : mGlobalVariableList)
+    auto It = mGlobalVariableNameIndex.find(GlobalVariableName);
+    if (It == mGlobalVariableNameIndex.end())
     {
-        if (GV->getName().compare(GlobalVariableName) == 0)
-        {
-            return GV;
-        }
+        return {};
     }
 
-    return {};
+    return It->second;
 }
 
 // Get the specified global variable by address in the module
 std::optional<GlobalVariable *>
 Module::getGlobalVariable(uint64_t Address) const
 {
-    for (auto GV : mGlobalVariableList)
+    auto It = mGlobalVariableAddressIndex.find(Address);
+    if (It == mGlobalVariableAddressIndex.end())
     {
-        if (GV->getGlobalVariableAddress() == Address)
-        {
-            return GV;
-        }
+        return {};
     }
 
-    return {};
+    return It->second;
+}
+
+// Get the function containing the address in the module
+std::optional<Function *>
+Module::getFunctionContaining(uint64_t Address) const
+{
+    // Find the last function beginning at or before the address, functions do not overlap
+    auto It = mFunctionAddressIndex.upper_bound(Address);
+    if (It == mFunctionAddressIndex.begin())
+    {
+        return {};
+    }
+    --It;
+
+    auto F = It->second;
+    if (Address != F->getFunctionBeginAddress() && Address >= F->getFunctionEndAddress())
+    {
+        return {};
+    }
+
+    return F;
+}
+
+// Get the global variable containing the address in the module
+std::optional<GlobalVariable *>
+Module::getGlobalVariableContaining(uint64_t Address) const
+{
+    // Find the last global variable beginning at or before the address, global variables do not overlap
+    auto It = mGlobalVariableAddressIndex.upper_bound(Address);
+    if (It == mGlobalVariableAddressIndex.begin())
+    {
+        return {};
+    }
+    --It;
+
+    auto GV = It->second;
+    if (Address - GV->getGlobalVariableAddress() >= std::max<uint64_t>(GV->getGlobalVariableSize(), 1))
+    {
+        return {};
+    }
+
+    return GV;
 }
 
 ////////////////////////////////////////////////////////////
-// Insert
+// Insert/Remove
 // Insert a function into the module
 void
 Module::insertFunction(Function *Function)
 {
     push_back(Function);
     Function->setParent(this);
+    addFunctionToIndex(Function);
 }
 
 // Insert a global variable into the module
@@ -164,6 +226,25 @@ Module::insertGlobalVariable(GlobalVariable *GV)
 {
     global_push_back(GV);
     GV->setParent(this);
+    addGlobalVariableToIndex(GV);
+}
+
+// Remove a function from the module, but does not delete it.
+void
+Module::removeFunction(Function *Function)
+{
+    removeFunctionFromIndex(Function);
+    mFunctionList.remove(Function);
+    Function->setParent(nullptr);
+}
+
+// Remove a global variable from the module, but does not delete it.
+void
+Module::removeGlobalVariable(GlobalVariable *GV)
+{
+    removeGlobalVariableFromIndex(GV);
+    mGlobalVariableList.remove(GV);
+    GV->setParent(nullptr);
 }
 
 // Drop all functions/global variables in this module.
@@ -210,21 +291,21 @@ Module::clearAllFunctions()
     }
 
     // Free all functions
-    std::vector<Function *> FreeFunctionList;
+    unknown::SmallPtrSet<Function *, 16> FreeFunctionList;
     for (auto F : *this)
     {
-        if (F)
+        if (F && FreeFunctionList.insert(F).second)
         {
-            if (std::find(FreeFunctionList.begin(), FreeFunctionList.end(), F) == FreeFunctionList.end())
-            {
-                FreeFunctionList.push_back(F);
-                delete F;
-            }
+            delete F;
         }
     }
 
     // Clear list
     clear();
+    mFunctionNameIndex.clear();
+    mFunctionAddressIndex.clear();
+    mSharedFunctionNames.clear();
+    mSharedFunctionAddresses.clear();
 }
 
 // Clear all global variables in this module.
@@ -241,22 +322,162 @@ Module::clearAllGlobalVariables()
     }
 
     // Free all global variables
-    std::vector<GlobalVariable *> FreeGVList;
+    unknown::SmallPtrSet<GlobalVariable *, 16> FreeGVList;
     for (auto It = global_begin(); It != global_end(); ++It)
     {
         auto GV = *It;
-        if (GV)
+        if (GV && FreeGVList.insert(GV).second)
         {
-            if (std::find(FreeGVList.begin(), FreeGVList.end(), GV) == FreeGVList.end())
-            {
-                FreeGVList.push_back(GV);
-                delete GV;
-            }
+            delete GV;
         }
     }
 
     // Clear list
     global_clear();
+    mGlobalVariableNameIndex.clear();
+    mGlobalVariableAddressIndex.clear();
+    mSharedGlobalVariableNames.clear();
+    mSharedGlobalVariableAddresses.clear();
+}
+
+////////////////////////////////////////////////////////////
+// Index
+// Add the function to the name and address indexes
+void
+Module::addFunctionToIndex(Function *Function)
+{
+    // The first function inserted wins, as the list is searched in order
+    auto Name = Function->getName();
+    if (!mFunctionNameIndex.try_emplace(Name, Function).second)
+    {
+        mSharedFunctionNames.insert(Name);
+    }
+
+    auto Address = Function->getFunctionBeginAddress();
+    if (!mFunctionAddressIndex.try_emplace(Address, Function).second)
+    {
+        mSharedFunctionAddresses.insert(Address);
+    }
+}
+
+// Remove the function from the name and address indexes
+void
+Module::removeFunctionFromIndex(Function *Function)
+{
+    auto Name = Function->getName();
+    auto NameIt = mFunctionNameIndex.find(Name);
+    if (NameIt != mFunctionNameIndex.end() && NameIt->second == Function)
+    {
+        mFunctionNameIndex.erase(NameIt);
+
+        // Another function with the same name becomes visible
+        if (mSharedFunctionNames.count(Name))
+        {
+            auto It = std::find_if(mFunctionList.begin(), mFunctionList.end(), [&](uir::Function *F) {
+                return F != Function && F->getName() == Name;
+            });
+            if (It != mFunctionList.end())
+            {
+                mFunctionNameIndex.try_emplace(Name, *It);
+            }
+            else
+            {
+                mSharedFunctionNames.erase(Name);
+            }
+        }
+    }
+
+    auto Address = Function->getFunctionBeginAddress();
+    auto AddrIt = mFunctionAddressIndex.find(Address);
+    if (AddrIt != mFunctionAddressIndex.end() && AddrIt->second == Function)
+    {
+        mFunctionAddressIndex.erase(AddrIt);
+
+        // Another function at the same address becomes visible
+        if (mSharedFunctionAddresses.count(Address))
+        {
+            auto It = std::find_if(mFunctionList.begin(), mFunctionList.end(), [&](uir::Function *F) {
+                return F != Function && F->getFunctionBeginAddress() == Address;
+            });
+            if (It != mFunctionList.end())
+            {
+                mFunctionAddressIndex.try_emplace(Address, *It);
+            }
+            else
+            {
+                mSharedFunctionAddresses.erase(Address);
+            }
+        }
+    }
+}
+
+// Add the global variable to the name and address indexes
+void
+Module::addGlobalVariableToIndex(GlobalVariable *GV)
+{
+    // The first global variable inserted wins, as the list is searched in order
+    auto Name = GV->getName();
+    if (!mGlobalVariableNameIndex.try_emplace(Name, GV).second)
+    {
+        mSharedGlobalVariableNames.insert(Name);
+    }
+
+    auto Address = GV->getGlobalVariableAddress();
+    if (!mGlobalVariableAddressIndex.try_emplace(Address, GV).second)
+    {
+        mSharedGlobalVariableAddresses.insert(Address);
+    }
+}
+
+// Remove the global variable from the name and address indexes
+void
+Module::removeGlobalVariableFromIndex(GlobalVariable *GV)
+{
+    auto Name = GV->getName();
+    auto NameIt = mGlobalVariableNameIndex.find(Name);
+    if (NameIt != mGlobalVariableNameIndex.end() && NameIt->second == GV)
+    {
+        mGlobalVariableNameIndex.erase(NameIt);
+
+        // Another global variable with the same name becomes visible
+        if (mSharedGlobalVariableNames.count(Name))
+        {
+            auto It = std::find_if(mGlobalVariableList.begin(), mGlobalVariableList.end(), [&](GlobalVariable *G) {
+                return G != GV && G->getName() == Name;
+            });
+            if (It != mGlobalVariableList.end())
+            {
+                mGlobalVariableNameIndex.try_emplace(Name, *It);
+            }
+            else
+            {
+                mSharedGlobalVariableNames.erase(Name);
+            }
+        }
+    }
+
+    auto Address = GV->getGlobalVariableAddress();
+    auto AddrIt = mGlobalVariableAddressIndex.find(Address);
+    if (AddrIt != mGlobalVariableAddressIndex.end() && AddrIt->second == GV)
+    {
+        mGlobalVariableAddressIndex.erase(AddrIt);
+
+        // Another global variable at the same address becomes visible
+        if (mSharedGlobalVariableAddresses.count(Address))
+        {
+            auto It = std::find_if(mGlobalVariableList.begin(), mGlobalVariableList.end(), [&](GlobalVariable *G) {
+                return G != GV && G->getGlobalVariableAddress() == Address;
+            });
+            if (It != mGlobalVariableList.end())
+            {
+                mGlobalVariableAddressIndex.try_emplace(Address, *It);
+            }
+            else
+            {
+                mSharedGlobalVariableAddresses.erase(Address);
+            }
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////
@@ -295,14 +516,84 @@ Module::getPropertyMode() const
 void
 Module::print(unknown::raw_ostream &OS, bool NewLine) const
 {
-    unknown::XMLPrinter Printer;
+    XMLStreamPrinter Printer(OS);
     print(Printer);
-    OS << Printer.CStr();
 }
 
 // Print the module
 void
 Module::print(unknown::XMLPrinter &Printer) const
+{
+    printBegin(Printer);
+
+    // function
+    for (auto F : *this)
+    {
+        if (F == nullptr)
+        {
+            continue;
+        }
+
+        F->print(Printer);
+    }
+
+    Printer.CloseElement();
+}
+
+// Print the module, the functions are rendered on the thread pool
+void
+Module::printParallel(unknown::raw_ostream &OS, uint32_t ThreadCount) const
+{
+    std::vector<const Function *> Functions;
+    Functions.reserve(size());
+    for (auto F : *this)
+    {
+        if (F != nullptr)
+        {
+            Functions.push_back(F);
+        }
+    }
+
+    ThreadCount = ThreadCount ? ThreadCount : unknown::hardware_concurrency();
+    ThreadCount = static_cast<uint32_t>(std::min<size_t>(ThreadCount, Functions.size()));
+    if (ThreadCount <= 1)
+    {
+        print(OS);
+        return;
+    }
+
+    // Every function is printed at the depth of the functions in the module, the buffers are written as they are.
+    // The anonymous locals are numbered per function, so the names don't depend on the order of the workers.
+    std::vector<unknown::SmallVector<char, 0>> Buffers(Functions.size());
+    std::atomic<size_t> NextIndex(0);
+    {
+        unknown::ThreadPool Pool(ThreadCount);
+        for (uint32_t i = 0; i < ThreadCount; ++i)
+        {
+            Pool.async([&]() {
+                for (size_t Index = NextIndex++; Index < Functions.size(); Index = NextIndex++)
+                {
+                    unknown::raw_svector_ostream BufferOS(Buffers[Index]);
+                    XMLStreamPrinter FunctionPrinter(BufferOS, 1);
+                    Functions[Index]->print(FunctionPrinter);
+                }
+            });
+        }
+        Pool.wait();
+    }
+
+    XMLStreamPrinter Printer(OS);
+    printBegin(Printer);
+    for (auto &Buffer : Buffers)
+    {
+        Printer.writeElements(unknown::StringRef(Buffer.data(), Buffer.size()));
+    }
+    Printer.CloseElement();
+}
+
+// Open the module element and print its attributes and its global variables
+void
+Module::printBegin(unknown::XMLPrinter &Printer) const
 {
     Printer.OpenElement(getPropertyModule().data());
 
@@ -332,19 +623,6 @@ Module::print(unknown::XMLPrinter &Printer) const
 
         GV->print(Printer);
     }
-
-    // function
-    for (auto F : *this)
-    {
-        if (F == nullptr)
-        {
-            continue;
-        }
-
-        F->print(Printer);
-    }
-
-    Printer.CloseElement();
 }
 
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,1160 @@
+#include <ModuleReader.h>
+#include <BasicBlock.h>
+#include <Instruction.h>
+#include <Argument.h>
+#include <FunctionContext.h>
+#include <FlagsVariable.h>
+#include <Constant.h>
+#include <Context.h>
+
+#include <Internal/BinaryFormat/BinaryFormat.h>
+
+#include <unknown/Support/Endian.h>
+#include <unknown/Support/LEB128.h>
+
+#include <cstring>
+
+namespace uir {
+
+////////////////////////////////////////////////////////////
+//     Cursor
+//
+// Decode the LEB128/bytes of the container, it fails instead of reading past the end
+class ModuleReader::Cursor
+{
+private:
+    const uint8_t *mPtr;
+    const uint8_t *mEnd;
+    bool mFailed;
+
+public:
+    Cursor(const uint8_t *Begin, const uint8_t *End) : mPtr(Begin), mEnd(End), mFailed(false) {}
+
+public:
+    // Has any read failed?
+    bool failed() const { return mFailed; }
+
+    // Read a byte
+    uint8_t readByte()
+    {
+        if (mFailed || mPtr >= mEnd)
+        {
+            mFailed = true;
+            return 0;
+        }
+
+        return *mPtr++;
+    }
+
+    // Read an unsigned/signed LEB128
+    uint64_t readULEB()
+    {
+        if (mFailed)
+        {
+            return 0;
+        }
+
+        unsigned N = 0;
+        const char *Error = nullptr;
+        uint64_t Value = unknown::decodeULEB128(mPtr, &N, mEnd, &Error);
+        if (Error)
+        {
+            mFailed = true;
+            return 0;
+        }
+
+        mPtr += N;
+        return Value;
+    }
+
+    int64_t readSLEB()
+    {
+        if (mFailed)
+        {
+            return 0;
+        }
+
+        unsigned N = 0;
+        const char *Error = nullptr;
+        int64_t Value = unknown::decodeSLEB128(mPtr, &N, mEnd, &Error);
+        if (Error)
+        {
+            mFailed = true;
+            return 0;
+        }
+
+        mPtr += N;
+        return Value;
+    }
+
+    // Read the bytes, they point into the buffer
+    unknown::StringRef readBytes(uint64_t Size)
+    {
+        if (mFailed || Size > static_cast<uint64_t>(mEnd - mPtr))
+        {
+            mFailed = true;
+            return unknown::StringRef();
+        }
+
+        unknown::StringRef Bytes(reinterpret_cast<const char *>(mPtr), Size);
+        mPtr += Size;
+        return Bytes;
+    }
+};
+
+////////////////////////////////////////////////////////////
+//     ModuleReader
+//
+
+////////////////////////////////////////////////////////////
+// Ctor/Dtor
+ModuleReader::ModuleReader(Context &C, const std::string &FilePath) : mContext(C), mFilePath(FilePath)
+{
+    assert(!FilePath.empty());
+}
+
+ModuleReader::ModuleReader(Context &C, std::unique_ptr<unknown::MemoryBuffer> Buffer) :
+    mContext(C), mBuffer(std::move(Buffer))
+{
+    assert(mBuffer);
+}
+
+ModuleReader::~ModuleReader()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Parse
+// Parse the header and the tables, the function bodies are not decoded
+bool
+ModuleReader::parse()
+{
+    using namespace unknown::support::endian;
+    using namespace binary;
+
+    if (mModule)
+    {
+        return error("the container is already parsed");
+    }
+
+    // Map the container once, it is never copied
+    if (!mBuffer)
+    {
+        auto BufferOrErr = unknown::MemoryBuffer::getFile(mFilePath, -1, false);
+        if (!BufferOrErr)
+        {
+            return error("can't open " + mFilePath);
+        }
+        mBuffer = std::move(*BufferOrErr);
+    }
+
+    auto Data = reinterpret_cast<const uint8_t *>(mBuffer->getBufferStart());
+    uint64_t DataSize = mBuffer->getBufferSize();
+
+    // Header
+    if (DataSize < HeaderSize || std::memcmp(Data + HeaderMagicOffset, Magic, sizeof(Magic)) != 0)
+    {
+        return error("not a binary UIR container");
+    }
+
+    if (read32le(Data + HeaderVersionOffset) != Version)
+    {
+        return error("unsupported binary UIR version");
+    }
+
+    uint64_t StringTableOffset = read64le(Data + HeaderStringTableOffset);
+    uint64_t TypeTableOffset = read64le(Data + HeaderTypeTableOffset);
+    uint64_t GlobalTableOffset = read64le(Data + HeaderGlobalTableOffset);
+    uint64_t ModuleTableOffset = read64le(Data + HeaderModuleTableOffset);
+    if (StringTableOffset < HeaderSize || TypeTableOffset < StringTableOffset ||
+        GlobalTableOffset < TypeTableOffset || ModuleTableOffset < GlobalTableOffset || DataSize < ModuleTableOffset)
+    {
+        return error("malformed binary UIR header");
+    }
+
+    // The module table creates the module, the globals are inserted into it
+    Cursor Strings(Data + StringTableOffset, Data + TypeTableOffset);
+    Cursor Types(Data + TypeTableOffset, Data + GlobalTableOffset);
+    Cursor Globals(Data + GlobalTableOffset, Data + ModuleTableOffset);
+    Cursor ModuleTable(Data + ModuleTableOffset, Data + DataSize);
+    if (!parseStringTable(Strings) || !parseTypeTable(Types) || !parseModuleTable(ModuleTable) ||
+        !parseGlobalTable(Globals))
+    {
+        mModule.reset();
+        return false;
+    }
+
+    // The bodies are between the header and the string table
+    for (auto &Entry : mFunctions)
+    {
+        if (Entry.BodyOffset < HeaderSize || Entry.BodyOffset > StringTableOffset ||
+            Entry.BodySize > StringTableOffset - Entry.BodyOffset)
+        {
+            mModule.reset();
+            return error("malformed function table");
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+// Get/Set
+// Get the module, nullptr if it is not parsed
+Module *
+ModuleReader::getModule()
+{
+    return mModule.get();
+}
+
+// Take the module, the materialized functions don't depend on the reader
+std::unique_ptr<Module>
+ModuleReader::takeModule()
+{
+    return std::move(mModule);
+}
+
+// Get the error message of the last failure
+const std::string &
+ModuleReader::getErrorMessage() const
+{
+    return mErrorMessage;
+}
+
+// Get the number of the functions in the container
+size_t
+ModuleReader::getNumFunctions() const
+{
+    return mFunctions.size();
+}
+
+// Get the name of the function in the container
+unknown::StringRef
+ModuleReader::getFunctionName(size_t Index) const
+{
+    assert(Index < mFunctions.size() && "getFunctionName() out of range!");
+    return mFunctions[Index].Name;
+}
+
+////////////////////////////////////////////////////////////
+// Materialize
+// Decode the body of the function, nullptr if it is malformed
+Function *
+ModuleReader::materializeFunction(size_t Index)
+{
+    if (!mModule || Index >= mFunctions.size())
+    {
+        error("the function is not in the module");
+        return nullptr;
+    }
+
+    auto &Entry = mFunctions[Index];
+    if (Entry.Materialized)
+    {
+        return Entry.F;
+    }
+
+    if (Entry.Malformed)
+    {
+        return nullptr;
+    }
+
+    getOrCreateFunction(Index);
+    if (!parseFunctionBody(Entry))
+    {
+        Entry.Malformed = true;
+        return nullptr;
+    }
+
+    Entry.Materialized = true;
+    return Entry.F;
+}
+
+// Decode the body of the function by name
+std::optional<Function *>
+ModuleReader::materializeFunction(unknown::StringRef FunctionName)
+{
+    auto It = mFunctionIndex.find(FunctionName);
+    if (It == mFunctionIndex.end())
+    {
+        return std::nullopt;
+    }
+
+    return materializeFunction(It->getValue());
+}
+
+// Decode all the function bodies, in the order of the container
+bool
+ModuleReader::materializeAll()
+{
+    if (!mModule)
+    {
+        return error("the container is not parsed");
+    }
+
+    // The functions are inserted into the module in the order of the container
+    for (size_t i = 0; i < mFunctions.size(); ++i)
+    {
+        getOrCreateFunction(i);
+    }
+
+    bool Succeeded = true;
+    for (size_t i = 0; i < mFunctions.size(); ++i)
+    {
+        Succeeded &= materializeFunction(i) != nullptr;
+    }
+
+    return Succeeded;
+}
+
+// Decode the body of the function into F, F is owned by the caller and is not inserted into the module
+bool
+ModuleReader::materializeFunctionInto(size_t Index, Function *F)
+{
+    assert(F);
+
+    if (!mModule || Index >= mFunctions.size())
+    {
+        return error("the function is not in the module");
+    }
+
+    // The entry of the container keeps its own shell, F only receives the body
+    FunctionEntry Entry = mFunctions[Index];
+    Entry.F = F;
+    return parseFunctionBody(Entry);
+}
+
+////////////////////////////////////////////////////////////
+// Tables
+bool
+ModuleReader::parseStringTable(Cursor &C)
+{
+    uint64_t NumStrings = C.readULEB();
+    for (uint64_t i = 0; i < NumStrings && !C.failed(); ++i)
+    {
+        mStrings.push_back(C.readBytes(C.readULEB()));
+    }
+
+    return !C.failed() || error("malformed string table");
+}
+
+bool
+ModuleReader::parseTypeTable(Cursor &C)
+{
+    uint64_t NumTypes = C.readULEB();
+    for (uint64_t i = 0; i < NumTypes && !C.failed(); ++i)
+    {
+        uint8_t TypeID = C.readByte();
+        uint64_t Extra = C.readULEB();
+        if (C.failed())
+        {
+            break;
+        }
+
+        Type *Ty = nullptr;
+        switch (TypeID)
+        {
+        case Type::VoidTyID:
+            Ty = Type::getVoidTy(mContext);
+            break;
+        case Type::FloatTyID:
+            Ty = Type::getFloatTy(mContext);
+            break;
+        case Type::DoubleTyID:
+            Ty = Type::getDoubleTy(mContext);
+            break;
+        case Type::LabelTyID:
+            Ty = Type::getLabelTy(mContext);
+            break;
+        case Type::FunctionTyID:
+            Ty = Type::getFunctionTy(mContext);
+            break;
+        case Type::IntegerTyID:
+            if (Extra == 0 || Extra > UINT32_MAX)
+            {
+                return error("malformed integer type");
+            }
+            Ty = IntegerType::get(mContext, static_cast<uint32_t>(Extra));
+            break;
+        case Type::PointerTyID:
+            // The element type is written first
+            if (Extra >= mTypes.size())
+            {
+                return error("malformed pointer type");
+            }
+            Ty = PointerType::get(mContext, mTypes[Extra]);
+            break;
+        default:
+            return error("unsupported type in the type table");
+        }
+
+        mTypes.push_back(Ty);
+    }
+
+    return !C.failed() || error("malformed type table");
+}
+
+bool
+ModuleReader::parseModuleTable(Cursor &C)
+{
+    unknown::StringRef ModuleName;
+    if (!parseString(C, ModuleName))
+    {
+        return false;
+    }
+
+    // The types depend on the mode of the context
+    uint64_t Arch = C.readULEB();
+    uint64_t Mode = C.readULEB();
+    if (Arch != static_cast<uint64_t>(mContext.getArch()) || Mode != static_cast<uint64_t>(mContext.getMode()))
+    {
+        return error("the container was written for another arch/mode");
+    }
+
+    mModule = Module::get(mContext, ModuleName);
+
+    uint64_t NumFunctions = C.readULEB();
+    for (uint64_t i = 0; i < NumFunctions && !C.failed(); ++i)
+    {
+        FunctionEntry Entry;
+        if (!parseString(C, Entry.Name))
+        {
+            return false;
+        }
+
+        Entry.BeginAddress = C.readULEB();
+        Entry.EndAddress = C.readULEB();
+        Entry.BodyOffset = C.readULEB();
+        Entry.BodySize = C.readULEB();
+
+        // The first function of the name wins, like the index of the module
+        mFunctionIndex.try_emplace(Entry.Name, static_cast<uint32_t>(mFunctions.size()));
+        mFunctions.push_back(Entry);
+    }
+
+    return !C.failed() || error("malformed module table");
+}
+
+bool
+ModuleReader::parseGlobalTable(Cursor &C)
+{
+    using namespace binary;
+
+    uint64_t NumGlobals = C.readULEB();
+    for (uint64_t i = 0; i < NumGlobals && !C.failed(); ++i)
+    {
+        ValueHeader Header;
+        if (!parseValueHeader(C, Header))
+        {
+            return false;
+        }
+
+        // The module owns all the globals it reads, including the ones only referenced by the functions
+        uint64_t Address = C.readULEB();
+        GlobalVariable *GV = nullptr;
+        switch (C.readByte())
+        {
+        case PlainGlobal:
+            GV = GlobalVariable::get(Header.Ty, Header.Name, Address);
+            break;
+        case ArrayGlobal:
+            GV = parseGlobalArray(C, Header, Address);
+            break;
+        default:
+            break;
+        }
+
+        if (GV == nullptr)
+        {
+            return error("malformed global table");
+        }
+
+        applyValueHeader(*GV, Header);
+        mModule->insertGlobalVariable(GV);
+        mGlobals.push_back(GV);
+    }
+
+    return !C.failed() || error("malformed global table");
+}
+
+// Decode the elements of a global array, the type of its elements is the one of the size of its element type
+GlobalVariable *
+ModuleReader::parseGlobalArray(Cursor &C, const ValueHeader &Header, uint64_t Address)
+{
+    auto PtrTy = unknown::dyn_cast<PointerType>(Header.Ty);
+    auto Data = C.readBytes(C.readULEB());
+    if (PtrTy == nullptr || C.failed())
+    {
+        return nullptr;
+    }
+
+    auto ElmtTy = PtrTy->getElementType();
+    auto ElmtSize = ElmtTy->getTypeSize();
+    if (ElmtSize == 0 || Data.size() % ElmtSize)
+    {
+        return nullptr;
+    }
+
+    unknown::ArrayRef<uint8_t> Bytes(reinterpret_cast<const uint8_t *>(Data.data()), Data.size());
+    switch (ElmtSize)
+    {
+    case 1:
+        return GlobalArray<uint8_t>::getFromData(mContext, ElmtTy, Bytes, Header.Name, Address);
+    case 2:
+        return GlobalArray<uint16_t>::getFromData(mContext, ElmtTy, Bytes, Header.Name, Address);
+    case 4:
+        return GlobalArray<uint32_t>::getFromData(mContext, ElmtTy, Bytes, Header.Name, Address);
+    case 8:
+        return GlobalArray<uint64_t>::getFromData(mContext, ElmtTy, Bytes, Header.Name, Address);
+    default:
+        return nullptr;
+    }
+}
+
+// Get the function shell of the module table, its body is decoded later
+Function *
+ModuleReader::getOrCreateFunction(size_t Index)
+{
+    auto &Entry = mFunctions[Index];
+    if (Entry.F == nullptr)
+    {
+        Entry.F = Function::get(mContext, Entry.Name, mModule.get(), Entry.BeginAddress, Entry.EndAddress);
+        mModule->insertFunction(Entry.F);
+    }
+
+    return Entry.F;
+}
+
+////////////////////////////////////////////////////////////
+// Function
+// Decode the body of the function
+bool
+ModuleReader::parseFunctionBody(FunctionEntry &Entry)
+{
+    using namespace binary;
+
+    auto Data = reinterpret_cast<const uint8_t *>(mBuffer->getBufferStart());
+    Cursor C(Data + Entry.BodyOffset, Data + Entry.BodyOffset + Entry.BodySize);
+
+    auto F = Entry.F;
+    FunctionState FS;
+    FS.F = F;
+
+    // The blocks, instructions and detached values are released with the function
+    F->enableArena();
+
+    uint8_t Flags = C.readByte();
+    F->setSEH(Flags & FunctionHasSEH);
+    F->setAsyncEH(Flags & FunctionHasAsyncEH);
+    F->setNaked(Flags & FunctionHasNaked);
+
+    ValueHeader FunctionHeader;
+    if (!parseName(C, FunctionHeader))
+    {
+        return false;
+    }
+    applyValueHeader(*F, FunctionHeader);
+
+    // Attributes
+    Function::FunctionAttributesListType Attributes;
+    uint64_t NumAttributes = C.readULEB();
+    for (uint64_t i = 0; i < NumAttributes && !C.failed(); ++i)
+    {
+        unknown::StringRef Attribute;
+        if (!parseString(C, Attribute))
+        {
+            return false;
+        }
+        Attributes.push_back(Attribute.str());
+    }
+    F->setFunctionAttributes(Attributes);
+
+    // Arguments
+    uint64_t NumArguments = C.readULEB();
+    for (uint64_t i = 0; i < NumArguments && !C.failed(); ++i)
+    {
+        ValueHeader Header;
+        if (!parseValueHeader(C, Header))
+        {
+            return false;
+        }
+
+        auto Arg = Argument::get(Header.Ty, Header.Name, F, static_cast<uint32_t>(C.readULEB()));
+        applyValueHeader(*Arg, Header);
+        F->insertArgument(Arg);
+        FS.Arguments.push_back(Arg);
+    }
+
+    // Function contexts
+    uint64_t NumFunctionContexts = C.readULEB();
+    for (uint64_t i = 0; i < NumFunctionContexts && !C.failed(); ++i)
+    {
+        ValueHeader Header;
+        if (!parseValueHeader(C, Header))
+        {
+            return false;
+        }
+
+        auto FC = FunctionContext::get(Header.Ty, Header.Name, F, static_cast<uint32_t>(C.readULEB()));
+        applyValueHeader(*FC, Header);
+        F->insertFunctionContext(FC);
+        FS.FunctionContexts.push_back(FC);
+    }
+
+    // Blocks
+    uint64_t NumBlocks = C.readULEB();
+    for (uint64_t i = 0; i < NumBlocks && !C.failed(); ++i)
+    {
+        ValueHeader Header;
+        if (!parseName(C, Header))
+        {
+            return false;
+        }
+
+        uint64_t BlockBegin = F->getFunctionBeginAddress() + C.readSLEB();
+        uint64_t BlockEnd = BlockBegin + C.readSLEB();
+        auto BB = BasicBlock::create(mContext, Header.Name, BlockBegin, BlockEnd, F);
+        applyValueHeader(*BB, Header);
+        F->insertBasicBlock(BB);
+        FS.Blocks.push_back(BB);
+    }
+
+    // Detached values
+    uint64_t NumDetached = C.readULEB();
+    uint64_t PrevAddress = F->getFunctionBeginAddress();
+    for (uint64_t i = 0; i < NumDetached && !C.failed(); ++i)
+    {
+        uint8_t Kind = C.readByte();
+        if (Kind == DetachedInstruction)
+        {
+            if (!parseInstruction(C, FS, PrevAddress))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        if (Kind != DetachedLocalVariable && Kind != DetachedFlagsVariable)
+        {
+            return error("malformed detached value");
+        }
+
+        ValueHeader Header;
+        if (!parseValueHeader(C, Header))
+        {
+            return false;
+        }
+
+        uint64_t Address = C.readULEB();
+        LocalVariable *LV = nullptr;
+        if (Kind == DetachedFlagsVariable)
+        {
+            auto FV = new (F->getArena()) FlagsVariable(Header.Ty);
+            FV->setLocalVariableAddress(Address);
+            FV->setFlagsValue(C.readULEB());
+            LV = FV;
+        }
+        else
+        {
+            LV = new (F->getArena()) LocalVariable(Header.Ty, Header.Name, Address);
+        }
+
+        applyValueHeader(*LV, Header);
+        defineSlot(FS, LV);
+    }
+
+    // Predecessors and instructions
+    for (auto BB : FS.Blocks)
+    {
+        uint64_t NumPredecessors = C.readULEB();
+        for (uint64_t i = 0; i < NumPredecessors && !C.failed(); ++i)
+        {
+            uint64_t Pred = C.readULEB();
+            if (Pred >= FS.Blocks.size())
+            {
+                return error("malformed predecessor");
+            }
+            BB->getPredecessorsList().push_back(FS.Blocks[Pred]);
+        }
+
+        uint64_t NumInstructions = C.readULEB();
+        PrevAddress = BB->getBasicBlockAddressBegin();
+        for (uint64_t i = 0; i < NumInstructions && !C.failed(); ++i)
+        {
+            auto I = parseInstruction(C, FS, PrevAddress);
+            if (I == nullptr)
+            {
+                return false;
+            }
+            BB->insertInst(I);
+        }
+    }
+
+    if (C.failed())
+    {
+        return error("truncated body of the function " + Entry.Name);
+    }
+
+    if (!FS.Placeholders.empty())
+    {
+        return error("unresolved forward reference in the function " + Entry.Name);
+    }
+
+    return true;
+}
+
+// Decode an instruction, it is not inserted into a block
+Instruction *
+ModuleReader::parseInstruction(Cursor &C, FunctionState &FS, uint64_t &PrevAddress)
+{
+    using namespace binary;
+
+    uint8_t Op = C.readByte();
+    uint8_t Flags = C.readByte();
+    if (Op > static_cast<uint8_t>(OpCodeID::Unknown))
+    {
+        error("malformed opcode");
+        return nullptr;
+    }
+    auto OpCode = static_cast<OpCodeID>(Op);
+
+    ValueHeader Header;
+    if (!parseValueHeader(C, Header))
+    {
+        return nullptr;
+    }
+
+    uint64_t Address = PrevAddress + C.readSLEB();
+    PrevAddress = Address;
+
+    unknown::StringRef UnknownStr;
+    if (OpCode == OpCodeID::Unknown && !parseString(C, UnknownStr))
+    {
+        return nullptr;
+    }
+
+    // The variables are owned by the instruction once it is built
+    std::unique_ptr<FlagsVariable> FV;
+    if (Flags & InstructionHasFlagsVariable)
+    {
+        ValueHeader FlagsHeader;
+        if (!parseValueHeader(C, FlagsHeader))
+        {
+            return nullptr;
+        }
+
+        FV.reset(FlagsVariable::get(FlagsHeader.Ty));
+        FV->setLocalVariableAddress(C.readULEB());
+        FV->setFlagsValue(C.readULEB());
+        applyValueHeader(*FV, FlagsHeader);
+    }
+
+    std::unique_ptr<LocalVariable> SV;
+    if (Flags & InstructionHasStackVariable)
+    {
+        ValueHeader StackHeader;
+        if (!parseValueHeader(C, StackHeader))
+        {
+            return nullptr;
+        }
+
+        SV.reset(LocalVariable::get(StackHeader.Ty, StackHeader.Name, C.readULEB()));
+        applyValueHeader(*SV, StackHeader);
+    }
+
+    // Operands
+    unknown::SmallVector<Value *, 4> Operands;
+    uint64_t NumOperands = C.readULEB();
+    for (uint64_t i = 0; i < NumOperands && !C.failed(); ++i)
+    {
+        auto V = parseValueRef(C, FS);
+        if (V == nullptr)
+        {
+            error("unresolved operand in the function " + FS.F->getFunctionName());
+            return nullptr;
+        }
+        Operands.push_back(V);
+    }
+
+    // Successors
+    bool IsTerminator = OpCode >= OpCodeID::Ret && OpCode <= OpCodeID::JccBB;
+    unknown::SmallVector<BasicBlock *, 2> Successors;
+    if (IsTerminator)
+    {
+        uint64_t NumSuccessors = C.readULEB();
+        for (uint64_t i = 0; i < NumSuccessors && !C.failed(); ++i)
+        {
+            uint64_t Succ = C.readULEB();
+            if (Succ >= FS.Blocks.size())
+            {
+                error("malformed successor");
+                return nullptr;
+            }
+            Successors.push_back(FS.Blocks[Succ]);
+        }
+    }
+
+    if (C.failed())
+    {
+        error("truncated instruction");
+        return nullptr;
+    }
+
+    // The constructors take the leading operands, they must have the right kind
+    auto isPointer = [&](size_t Index) { return Operands[Index]->getType()->isPointerTy(); };
+    auto getImm = [&](size_t Index) { return unknown::dyn_cast<ConstantInt>(Operands[Index]); };
+
+    auto Arena = FS.F->getArena();
+    Instruction *I = nullptr;
+    size_t NumBuiltOperands = 0;
+    switch (OpCode)
+    {
+    case OpCodeID::Load:
+        if (Operands.size() >= 1 && isPointer(0))
+        {
+            I = new (Arena) LoadInstruction(Operands[0]);
+            NumBuiltOperands = 1;
+        }
+        break;
+    case OpCodeID::Store:
+        if (Operands.size() >= 2 && isPointer(1))
+        {
+            I = new (Arena) StoreInstruction(mContext, Operands[0], Operands[1], Flags & InstructionIsVolatile);
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::GetBitPtr:
+        if (Operands.size() >= 2 && isPointer(0) && Header.Ty->isPointerTy())
+        {
+            I = new (Arena)
+                GetBitPtrInstruction(unknown::cast<PointerType>(Header.Ty), Operands[0], Operands[1]);
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::Add:
+        if (Operands.size() >= 2)
+        {
+            I = new (Arena) AddInstruction(Operands[0], Operands[1], FV.release());
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::Sub:
+        if (Operands.size() >= 2)
+        {
+            I = new (Arena) SubInstruction(Operands[0], Operands[1], FV.release());
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::Xor:
+        if (Operands.size() >= 2)
+        {
+            I = new (Arena) XorInstruction(Operands[0], Operands[1], FV.release());
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::Or:
+        if (Operands.size() >= 2)
+        {
+            I = new (Arena) OrInstruction(Operands[0], Operands[1], FV.release());
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::And:
+        if (Operands.size() >= 2)
+        {
+            I = new (Arena) AndInstruction(Operands[0], Operands[1], FV.release());
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::Ret:
+        I = new (Arena) ReturnInstruction(mContext);
+        break;
+    case OpCodeID::RetIMM:
+        if (Operands.size() >= 1 && getImm(0))
+        {
+            I = new (Arena) ReturnImmInstruction(mContext, getImm(0));
+            NumBuiltOperands = 1;
+        }
+        break;
+    case OpCodeID::JmpAddr:
+        if (Operands.size() >= 1 && getImm(0))
+        {
+            I = new (Arena) JmpAddrInstruction(mContext, getImm(0));
+            NumBuiltOperands = 1;
+        }
+        break;
+    case OpCodeID::JccAddr:
+        if (Operands.size() >= 2 && getImm(0) && getImm(1))
+        {
+            I = new (Arena) JccAddrInstruction(mContext, getImm(0), getImm(1), FV.release());
+            NumBuiltOperands = 2;
+        }
+        break;
+    case OpCodeID::JmpBB:
+        if (!Successors.empty())
+        {
+            I = new (Arena) JmpBBInstruction(mContext, Successors.front());
+        }
+        break;
+    case OpCodeID::JccBB:
+        if (!Successors.empty())
+        {
+            I = new (Arena) JccBBInstruction(mContext, Successors.front(), Successors.back(), FV.release());
+        }
+        break;
+    case OpCodeID::Unknown:
+        I = new (Arena) UnknownInstruction(mContext, UnknownStr);
+        break;
+    default:
+        error("unsupported opcode");
+        return nullptr;
+    }
+
+    if (I == nullptr)
+    {
+        error("malformed operands of the instruction");
+        return nullptr;
+    }
+
+    for (size_t i = NumBuiltOperands; i < Operands.size(); ++i)
+    {
+        I->insertOperandAndUpdateUsers(Operands[i]);
+    }
+
+    // The successors are restored as they were, the constructors drop the duplicates
+    if (IsTerminator)
+    {
+        auto &SuccessorsList = unknown::cast<TerminatorInstruction>(I)->getSuccessorsList();
+        SuccessorsList.assign(Successors.begin(), Successors.end());
+    }
+
+    I->setType(Header.Ty);
+    applyValueHeader(*I, Header);
+    I->setInstructionAddress(Address);
+    I->enablePrintOp(Flags & InstructionHasPrintOp);
+    if (FV)
+    {
+        I->setFlagsVariableAndUpdateUsers(FV.release());
+    }
+    if (SV)
+    {
+        I->setStackVariableAndUpdateUsers(SV.release());
+    }
+
+    // The slots are defined in the order of the writer
+    defineSlot(FS, I);
+    if (Flags & InstructionHasFlagsVariable)
+    {
+        defineSlot(FS, I->getFlagsVariable());
+    }
+    if (Flags & InstructionHasStackVariable)
+    {
+        defineSlot(FS, I->getStackVariable());
+    }
+
+    return I;
+}
+
+// Decode a value reference
+Value *
+ModuleReader::parseValueRef(Cursor &C, FunctionState &FS)
+{
+    using namespace binary;
+
+    auto getByIndex = [&C](auto &List) -> Value * {
+        uint64_t Index = C.readULEB();
+        return Index < List.size() ? List[Index] : nullptr;
+    };
+
+    switch (C.readByte())
+    {
+    case ConstantIntRef: {
+        Type *Ty = nullptr;
+        if (!parseType(C, Ty) || !Ty->isIntegerTy())
+        {
+            return nullptr;
+        }
+
+        uint32_t NumBits = Ty->getTypeBits();
+        if (NumBits <= 64)
+        {
+            return ConstantInt::get(unknown::cast<IntegerType>(Ty), unknown::APInt(NumBits, C.readULEB()));
+        }
+
+        unknown::SmallVector<uint64_t, 4> Words((NumBits + 63) / 64);
+        for (auto &Word : Words)
+        {
+            Word = C.readULEB();
+        }
+        return ConstantInt::get(unknown::cast<IntegerType>(Ty), unknown::APInt(NumBits, Words));
+    }
+    case GlobalRef:
+        return getByIndex(mGlobals);
+    case LocalRef:
+        return getByIndex(FS.Slots);
+    case ForwardLocalRef: {
+        uint64_t Slot = C.readULEB();
+        Type *Ty = nullptr;
+        if (!parseType(C, Ty) || Slot > UINT32_MAX)
+        {
+            return nullptr;
+        }
+
+        if (Slot < FS.Slots.size())
+        {
+            return FS.Slots[Slot];
+        }
+
+        // The placeholder stands in for the value until its slot is defined
+        auto &Placeholder = FS.Placeholders[static_cast<uint32_t>(Slot)];
+        if (Placeholder == nullptr)
+        {
+            Placeholder = LocalVariable::get(Ty);
+        }
+        return Placeholder;
+    }
+    case BasicBlockRef:
+        return getByIndex(FS.Blocks);
+    case ArgumentRef:
+        return getByIndex(FS.Arguments);
+    case FunctionContextRef:
+        return getByIndex(FS.FunctionContexts);
+    case FunctionRef: {
+        uint64_t Index = C.readULEB();
+        return Index < mFunctions.size() ? getOrCreateFunction(Index) : nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+// Define the next local slot, the forward references to it are resolved
+void
+ModuleReader::defineSlot(FunctionState &FS, LocalVariable *LV)
+{
+    uint32_t Slot = static_cast<uint32_t>(FS.Slots.size());
+    FS.Slots.push_back(LV);
+
+    auto It = FS.Placeholders.find(Slot);
+    if (It != FS.Placeholders.end())
+    {
+        It->second->replaceAllUsesWith(LV);
+        delete It->second;
+        FS.Placeholders.erase(It);
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Values
+bool
+ModuleReader::parseString(Cursor &C, unknown::StringRef &Str)
+{
+    uint64_t Index = C.readULEB();
+    if (C.failed() || Index >= mStrings.size())
+    {
+        return error("malformed string index");
+    }
+
+    Str = mStrings[Index];
+    return true;
+}
+
+bool
+ModuleReader::parseType(Cursor &C, Type *&Ty)
+{
+    uint64_t Index = C.readULEB();
+    if (C.failed() || Index >= mTypes.size())
+    {
+        return error("malformed type index");
+    }
+
+    Ty = mTypes[Index];
+    return true;
+}
+
+// The name is (string index + 1) << 1 | has annotation, 0 is an anonymous value
+bool
+ModuleReader::parseName(Cursor &C, ValueHeader &Header)
+{
+    uint64_t NameField = C.readULEB();
+    uint64_t NameIndex = NameField >> 1;
+    Header.HasAnnotation = NameField & 1;
+    if (NameIndex)
+    {
+        if (NameIndex > mStrings.size())
+        {
+            return error("malformed name");
+        }
+        Header.Name = mStrings[NameIndex - 1];
+    }
+
+    if (!Header.HasAnnotation)
+    {
+        return !C.failed() || error("truncated name");
+    }
+
+    uint64_t NumExtraInfo = C.readULEB();
+    for (uint64_t i = 0; i < NumExtraInfo && !C.failed(); ++i)
+    {
+        unknown::StringRef ExtraInfo;
+        if (!parseString(C, ExtraInfo))
+        {
+            return false;
+        }
+        Header.ExtraInfoList.push_back(ExtraInfo);
+    }
+
+    uint64_t CommentIndex = C.readULEB();
+    if (CommentIndex > mStrings.size())
+    {
+        return error("malformed comment");
+    }
+    if (CommentIndex)
+    {
+        Header.Comment = mStrings[CommentIndex - 1];
+    }
+
+    return !C.failed() || error("truncated annotation");
+}
+
+bool
+ModuleReader::parseValueHeader(Cursor &C, ValueHeader &Header)
+{
+    return parseType(C, Header.Ty) && parseName(C, Header);
+}
+
+// The anonymous values keep their lazy names, the annotation is created only if there is one
+void
+ModuleReader::applyValueHeader(Value &V, const ValueHeader &Header)
+{
+    if (!Header.Name.empty() && V.getNameRef() != Header.Name)
+    {
+        V.setName(Header.Name);
+    }
+
+    if (!Header.HasAnnotation)
+    {
+        return;
+    }
+
+    for (auto ExtraInfo : Header.ExtraInfoList)
+    {
+        V.addExtraInfo(ExtraInfo);
+    }
+
+    if (!Header.Comment.empty())
+    {
+        V.setComment(Header.Comment);
+    }
+}
+
+// Record the error, always returns false
+bool
+ModuleReader::error(const unknown::Twine &Message)
+{
+    mErrorMessage = Message.str();
+    return false;
+}
+
+} // namespace uir
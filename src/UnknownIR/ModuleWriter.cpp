@@ -0,0 +1,702 @@
+#include <ModuleWriter.h>
+#include <BasicBlock.h>
+#include <Instruction.h>
+#include <Argument.h>
+#include <FunctionContext.h>
+#include <FlagsVariable.h>
+#include <Constant.h>
+#include <Context.h>
+
+#include <Internal/BinaryFormat/BinaryFormat.h>
+#include <Internal/InternalConfig/InternalConfig.h>
+
+#include <unknown/Support/Endian.h>
+#include <unknown/Support/FileSystem.h>
+#include <unknown/Support/LEB128.h>
+
+namespace uir {
+
+////////////////////////////////////////////////////////////
+// Ctor/Dtor
+ModuleWriter::ModuleWriter(const Module &M) : mModule(&M), mFunctions(M.begin(), M.end())
+{
+    //
+}
+
+ModuleWriter::ModuleWriter(const Function &F) : mModule(nullptr), mFunctions({&F})
+{
+    //
+}
+
+ModuleWriter::~ModuleWriter()
+{
+    //
+}
+
+////////////////////////////////////////////////////////////
+// Write
+// Write the module into the stream, nothing is written if a value can't be referenced in the container
+bool
+ModuleWriter::write(unknown::raw_ostream &OS)
+{
+    using namespace binary;
+
+    // The functions may reference each other
+    uint32_t FunctionIdx = 0;
+    for (auto F : mFunctions)
+    {
+        mFunctionIndex.try_emplace(F, FunctionIdx++);
+    }
+
+    // The globals of the module come first, so that they keep their order
+    if (mModule)
+    {
+        for (auto It = mModule->global_begin(); It != mModule->global_end(); ++It)
+        {
+            getGlobalIndex(*It);
+        }
+    }
+
+    // The bodies are encoded first, they fill the tables
+    unknown::SmallVector<char, 0> Bodies;
+    unknown::raw_svector_ostream BodiesOS(Bodies);
+    std::vector<std::pair<uint64_t, uint64_t>> BodyRanges;
+    BodyRanges.reserve(mFunctions.size());
+    for (auto F : mFunctions)
+    {
+        uint64_t BodyBegin = BodiesOS.tell();
+        writeFunction(BodiesOS, *F);
+        BodyRanges.emplace_back(HeaderSize + BodyBegin, BodiesOS.tell() - BodyBegin);
+    }
+
+    unknown::SmallVector<char, 0> Globals;
+    unknown::raw_svector_ostream GlobalsOS(Globals);
+    writeGlobalTable(GlobalsOS);
+
+    // The reader would reject the container
+    if (!mErrorMessage.empty())
+    {
+        return false;
+    }
+
+    // Module table
+    unknown::SmallVector<char, 0> ModuleTable;
+    unknown::raw_svector_ostream ModuleOS(ModuleTable);
+    auto &C = mModule ? mModule->getContext() : mFunctions.front()->getContext();
+    auto ModuleName = mModule ? mModule->getModuleName() : mFunctions.front()->getFunctionName();
+    unknown::encodeULEB128(getStringIndex(ModuleName), ModuleOS);
+    unknown::encodeULEB128(static_cast<uint32_t>(C.getArch()), ModuleOS);
+    unknown::encodeULEB128(static_cast<uint32_t>(C.getMode()), ModuleOS);
+    unknown::encodeULEB128(mFunctions.size(), ModuleOS);
+    size_t Index = 0;
+    for (auto F : mFunctions)
+    {
+        unknown::encodeULEB128(getStringIndex(F->getFunctionName()), ModuleOS);
+        unknown::encodeULEB128(F->getFunctionBeginAddress(), ModuleOS);
+        unknown::encodeULEB128(F->getFunctionEndAddress(), ModuleOS);
+        unknown::encodeULEB128(BodyRanges[Index].first, ModuleOS);
+        unknown::encodeULEB128(BodyRanges[Index].second, ModuleOS);
+        ++Index;
+    }
+
+    // The types and strings are complete now
+    unknown::SmallVector<char, 0> Types;
+    unknown::raw_svector_ostream TypesOS(Types);
+    writeTypeTable(TypesOS);
+
+    unknown::SmallVector<char, 0> Strings;
+    unknown::raw_svector_ostream StringsOS(Strings);
+    writeStringTable(StringsOS);
+
+    // Header
+    uint64_t StringTableOffset = HeaderSize + Bodies.size();
+    uint64_t TypeTableOffset = StringTableOffset + Strings.size();
+    uint64_t GlobalTableOffset = TypeTableOffset + Types.size();
+    uint64_t ModuleTableOffset = GlobalTableOffset + Globals.size();
+
+    char Header[HeaderSize] = {};
+    std::memcpy(Header + HeaderMagicOffset, Magic, sizeof(Magic));
+    unknown::support::endian::write32le(Header + HeaderVersionOffset, Version);
+    unknown::support::endian::write64le(Header + HeaderStringTableOffset, StringTableOffset);
+    unknown::support::endian::write64le(Header + HeaderTypeTableOffset, TypeTableOffset);
+    unknown::support::endian::write64le(Header + HeaderGlobalTableOffset, GlobalTableOffset);
+    unknown::support::endian::write64le(Header + HeaderModuleTableOffset, ModuleTableOffset);
+
+    OS.write(Header, HeaderSize);
+    OS.write(Bodies.data(), Bodies.size());
+    OS.write(Strings.data(), Strings.size());
+    OS.write(Types.data(), Types.size());
+    OS.write(Globals.data(), Globals.size());
+    OS.write(ModuleTable.data(), ModuleTable.size());
+    return true;
+}
+
+// Write the module into the file
+bool
+ModuleWriter::writeToFile(const std::string &FilePath)
+{
+    // The file is not created if the module can't be written
+    unknown::SmallVector<char, 0> Buffer;
+    unknown::raw_svector_ostream BufferOS(Buffer);
+    if (!write(BufferOS))
+    {
+        return false;
+    }
+
+    std::error_code EC;
+    unknown::raw_fd_ostream OS(FilePath, EC, unknown::sys::fs::OF_None);
+    if (EC)
+    {
+        return error("can't open " + FilePath);
+    }
+
+    OS.write(Buffer.data(), Buffer.size());
+    OS.close();
+    return !OS.has_error() || error("can't write " + FilePath);
+}
+
+// Get the error message of the last failure
+const std::string &
+ModuleWriter::getErrorMessage() const
+{
+    return mErrorMessage;
+}
+
+////////////////////////////////////////////////////////////
+// Tables
+// Get the index of the string, it is added to the table if it isn't there
+uint32_t
+ModuleWriter::getStringIndex(unknown::StringRef Str)
+{
+    auto [It, Inserted] = mStringIndex.try_emplace(Str, static_cast<uint32_t>(mStrings.size()));
+    if (Inserted)
+    {
+        // The key of the map is stable
+        mStrings.push_back(It->getKey());
+    }
+
+    return It->getValue();
+}
+
+// Get the index of the type, it is added to the table if it isn't there
+uint32_t
+ModuleWriter::getTypeIndex(const Type *Ty)
+{
+    auto It = mTypeIndex.find(Ty);
+    if (It != mTypeIndex.end())
+    {
+        return It->second;
+    }
+
+    // The element type is read before the pointer type
+    if (auto PtrTy = unknown::dyn_cast<PointerType>(Ty))
+    {
+        getTypeIndex(PtrTy->getElementType());
+    }
+
+    uint32_t Index = static_cast<uint32_t>(mTypes.size());
+    mTypes.push_back(Ty);
+    mTypeIndex[Ty] = Index;
+    return Index;
+}
+
+// Get the index of the global, it is added to the table if it isn't there
+uint32_t
+ModuleWriter::getGlobalIndex(const GlobalVariable *GV)
+{
+    auto [It, Inserted] = mGlobalIndex.try_emplace(GV, static_cast<uint32_t>(mGlobals.size()));
+    if (Inserted)
+    {
+        mGlobals.push_back(GV);
+    }
+
+    return It->second;
+}
+
+// Write the string table
+void
+ModuleWriter::writeStringTable(unknown::raw_ostream &OS) const
+{
+    unknown::encodeULEB128(mStrings.size(), OS);
+    for (auto Str : mStrings)
+    {
+        unknown::encodeULEB128(Str.size(), OS);
+        OS << Str;
+    }
+}
+
+// Write the type table
+void
+ModuleWriter::writeTypeTable(unknown::raw_ostream &OS) const
+{
+    unknown::encodeULEB128(mTypes.size(), OS);
+    for (auto Ty : mTypes)
+    {
+        OS << static_cast<char>(Ty->getTypeID());
+        if (auto PtrTy = unknown::dyn_cast<PointerType>(Ty))
+        {
+            unknown::encodeULEB128(mTypeIndex.lookup(PtrTy->getElementType()), OS);
+        }
+        else
+        {
+            unknown::encodeULEB128(Ty->getTypeBits(), OS);
+        }
+    }
+}
+
+// Write the global table
+void
+ModuleWriter::writeGlobalTable(unknown::raw_ostream &OS)
+{
+    using namespace binary;
+
+    unknown::encodeULEB128(mGlobals.size(), OS);
+    for (auto GV : mGlobals)
+    {
+        writeValueHeader(OS, *GV);
+        unknown::encodeULEB128(GV->getGlobalVariableAddress(), OS);
+        if (!GV->isGlobalArray())
+        {
+            OS << static_cast<char>(PlainGlobal);
+            continue;
+        }
+
+        // The elements are written as the bytes of the host, the reader gets them back by the size of the element
+        auto Data = GV->getGlobalArrayData();
+        if (Data.size() != GV->getGlobalVariableSize())
+        {
+            error("the elements of the global array " + GV->getName() + " can't be written");
+            continue;
+        }
+
+        OS << static_cast<char>(ArrayGlobal);
+        unknown::encodeULEB128(Data.size(), OS);
+        OS.write(reinterpret_cast<const char *>(Data.data()), Data.size());
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Function
+// Write the body of the function
+void
+ModuleWriter::writeFunction(unknown::raw_ostream &OS, const Function &F)
+{
+    using namespace binary;
+
+    FunctionState FS;
+    FS.F = &F;
+
+    // The names are written as they are printed
+    F.numberLocals();
+
+    uint8_t Flags = 0;
+    Flags |= F.hasSEH() ? FunctionHasSEH : 0;
+    Flags |= F.hasAsyncEH() ? FunctionHasAsyncEH : 0;
+    Flags |= F.hasNaked() ? FunctionHasNaked : 0;
+    OS << static_cast<char>(Flags);
+
+    // The name is in the module table
+    writeName(OS, "", F);
+
+    // Attributes
+    unknown::encodeULEB128(F.getFunctionAttributes().size(), OS);
+    for (auto &Attr : F.getFunctionAttributes())
+    {
+        unknown::encodeULEB128(getStringIndex(Attr), OS);
+    }
+
+    // Arguments
+    unknown::encodeULEB128(F.arg_size(), OS);
+    for (auto It = F.arg_begin(); It != F.arg_end(); ++It)
+    {
+        auto Arg = *It;
+        FS.ArgumentIndex.try_emplace(Arg, static_cast<uint32_t>(FS.ArgumentIndex.size()));
+        writeValueHeader(OS, *Arg);
+        unknown::encodeULEB128(Arg->getArgNo(), OS);
+    }
+
+    // Function contexts
+    unknown::encodeULEB128(F.fc_size(), OS);
+    for (auto It = F.fc_begin(); It != F.fc_end(); ++It)
+    {
+        auto FC = *It;
+        FS.FunctionContextIndex.try_emplace(FC, static_cast<uint32_t>(FS.FunctionContextIndex.size()));
+        writeValueHeader(OS, *FC);
+        unknown::encodeULEB128(FC->getCtxNo(), OS);
+    }
+
+    // The instructions of the blocks and their variables are not detached
+    for (auto BB : F)
+    {
+        FS.BlockIndex.try_emplace(BB, static_cast<uint32_t>(FS.BlockIndex.size()));
+        for (auto &I : *BB)
+        {
+            FS.InBlockValues.insert(&I);
+            FS.InBlockValues.insert(I.getFlagsVariable());
+            FS.InBlockValues.insert(I.getStackVariable());
+        }
+    }
+
+    // The detached values are defined before the blocks
+    std::vector<const LocalVariable *> Detached;
+    for (auto BB : F)
+    {
+        for (auto &I : *BB)
+        {
+            for (auto OpIt = I.op_begin(); OpIt != I.op_end(); ++OpIt)
+            {
+                collectDetachedValue(FS, *OpIt, Detached);
+            }
+        }
+    }
+
+    for (auto V : Detached)
+    {
+        if (auto I = unknown::dyn_cast<Instruction>(V))
+        {
+            assignInstructionSlots(FS, *I);
+        }
+        else
+        {
+            FS.LocalSlots[V] = FS.NumSlots++;
+        }
+    }
+
+    for (auto BB : F)
+    {
+        for (auto &I : *BB)
+        {
+            assignInstructionSlots(FS, I);
+        }
+    }
+
+    // Blocks, the instructions may refer to any of them
+    unknown::encodeULEB128(F.size(), OS);
+    for (auto BB : F)
+    {
+        writeName(OS, BB->getBasicBlockName(), *BB);
+        unknown::encodeSLEB128(
+            static_cast<int64_t>(BB->getBasicBlockAddressBegin() - F.getFunctionBeginAddress()), OS);
+        unknown::encodeSLEB128(
+            static_cast<int64_t>(BB->getBasicBlockAddressEnd() - BB->getBasicBlockAddressBegin()), OS);
+    }
+
+    // Detached values
+    unknown::encodeULEB128(Detached.size(), OS);
+    uint64_t PrevAddress = F.getFunctionBeginAddress();
+    for (auto V : Detached)
+    {
+        if (auto I = unknown::dyn_cast<Instruction>(V))
+        {
+            OS << static_cast<char>(DetachedInstruction);
+            writeInstruction(OS, FS, *I, PrevAddress);
+            continue;
+        }
+
+        auto FV = unknown::dyn_cast<FlagsVariable>(V);
+        OS << static_cast<char>(FV ? DetachedFlagsVariable : DetachedLocalVariable);
+        writeValueHeader(OS, *V);
+        unknown::encodeULEB128(V->getLocalVariableAddress(), OS);
+        if (FV)
+        {
+            unknown::encodeULEB128(FV->getFlagsValue(), OS);
+        }
+        ++FS.NumDefinedSlots;
+    }
+
+    for (auto BB : F)
+    {
+        // The predecessors out of this function are dropped
+        unknown::SmallVector<uint32_t, 4> Predecessors;
+        for (auto Pred : BB->getPredecessorsList())
+        {
+            auto It = FS.BlockIndex.find(Pred);
+            if (It != FS.BlockIndex.end())
+            {
+                Predecessors.push_back(It->second);
+            }
+        }
+
+        unknown::encodeULEB128(Predecessors.size(), OS);
+        for (auto Pred : Predecessors)
+        {
+            unknown::encodeULEB128(Pred, OS);
+        }
+
+        // Instructions
+        unknown::encodeULEB128(BB->size(), OS);
+        PrevAddress = BB->getBasicBlockAddressBegin();
+        for (auto &I : *BB)
+        {
+            writeInstruction(OS, FS, I, PrevAddress);
+        }
+    }
+}
+
+// Collect the function-local values which are not in a block, the operands come first
+void
+ModuleWriter::collectDetachedValue(FunctionState &FS, const Value *V, std::vector<const LocalVariable *> &Detached)
+{
+    auto LV = unknown::dyn_cast_or_null<LocalVariable>(V);
+    if (LV == nullptr || FS.InBlockValues.count(LV) || !FS.DetachedVisited.insert(LV).second)
+    {
+        return;
+    }
+
+    if (auto I = unknown::dyn_cast<Instruction>(LV))
+    {
+        // The variables of the instruction are written with it
+        FS.DetachedVisited.insert(I->getFlagsVariable());
+        FS.DetachedVisited.insert(I->getStackVariable());
+
+        for (auto OpIt = I->op_begin(); OpIt != I->op_end(); ++OpIt)
+        {
+            collectDetachedValue(FS, *OpIt, Detached);
+        }
+    }
+
+    Detached.push_back(LV);
+}
+
+// Assign the local slots of the instruction, its flags variable and its stack variable
+void
+ModuleWriter::assignInstructionSlots(FunctionState &FS, const Instruction &I)
+{
+    FS.LocalSlots[&I] = FS.NumSlots++;
+    if (I.getFlagsVariable())
+    {
+        FS.LocalSlots[I.getFlagsVariable()] = FS.NumSlots++;
+    }
+    if (I.getStackVariable())
+    {
+        FS.LocalSlots[I.getStackVariable()] = FS.NumSlots++;
+    }
+}
+
+// Write the instruction, the address is encoded relative to PrevAddress
+void
+ModuleWriter::writeInstruction(
+    unknown::raw_ostream &OS,
+    FunctionState &FS,
+    const Instruction &I,
+    uint64_t &PrevAddress)
+{
+    using namespace binary;
+
+    auto FV = I.getFlagsVariable();
+    auto SV = I.getStackVariable();
+    auto SI = unknown::dyn_cast<StoreInstruction>(&I);
+
+    uint8_t Flags = 0;
+    Flags |= FV ? InstructionHasFlagsVariable : 0;
+    Flags |= SV ? InstructionHasStackVariable : 0;
+    Flags |= SI && SI->isVolatile() ? InstructionIsVolatile : 0;
+    Flags |= I.hasPrintOp() ? InstructionHasPrintOp : 0;
+
+    OS << static_cast<char>(I.getOpCodeID());
+    OS << static_cast<char>(Flags);
+    writeValueHeader(OS, I);
+    unknown::encodeSLEB128(static_cast<int64_t>(I.getInstructionAddress() - PrevAddress), OS);
+    PrevAddress = I.getInstructionAddress();
+
+    if (auto UI = unknown::dyn_cast<UnknownInstruction>(&I))
+    {
+        unknown::encodeULEB128(getStringIndex(UI->getUnknownStr()), OS);
+    }
+
+    if (FV)
+    {
+        writeValueHeader(OS, *FV);
+        unknown::encodeULEB128(FV->getLocalVariableAddress(), OS);
+        unknown::encodeULEB128(FV->getFlagsValue(), OS);
+    }
+
+    if (SV)
+    {
+        writeValueHeader(OS, *SV);
+        unknown::encodeULEB128(SV->getLocalVariableAddress(), OS);
+    }
+
+    // Operands
+    unknown::encodeULEB128(I.op_count(), OS);
+    for (auto OpIt = I.op_begin(); OpIt != I.op_end(); ++OpIt)
+    {
+        writeValueRef(OS, FS, *OpIt);
+    }
+
+    // Successors, the reader can't rebuild a terminator without the ones out of this function
+    if (auto TI = unknown::dyn_cast<TerminatorInstruction>(&I))
+    {
+        unknown::SmallVector<uint32_t, 2> Successors;
+        for (auto It = TI->successor_begin(); It != TI->successor_end(); ++It)
+        {
+            auto BBIt = FS.BlockIndex.find(*It);
+            if (BBIt == FS.BlockIndex.end())
+            {
+                error("successor out of the function " + FS.F->getFunctionName());
+                continue;
+            }
+
+            Successors.push_back(BBIt->second);
+        }
+
+        unknown::encodeULEB128(Successors.size(), OS);
+        for (auto Succ : Successors)
+        {
+            unknown::encodeULEB128(Succ, OS);
+        }
+    }
+
+    // The slots of the instruction are defined after its operands
+    FS.NumDefinedSlots += 1 + (FV ? 1 : 0) + (SV ? 1 : 0);
+}
+
+// Write the type, name and annotation of the value
+void
+ModuleWriter::writeValueHeader(unknown::raw_ostream &OS, const Value &V)
+{
+    unknown::encodeULEB128(getTypeIndex(V.getType()), OS);
+    writeName(OS, V.getNameRef(), V);
+}
+
+// Write the name and the annotation of the value, the name is empty if the value is anonymous
+void
+ModuleWriter::writeName(unknown::raw_ostream &OS, unknown::StringRef Name, const Value &V)
+{
+    auto &ExtraInfoList = V.getExtraInfoList();
+    auto Comment = V.getComment();
+    bool HasAnnotation = !ExtraInfoList.empty() || !Comment.empty();
+
+    // The lowest bit tells whether the annotation follows
+    uint64_t NameIndex = Name.empty() ? 0 : getStringIndex(Name) + 1;
+    unknown::encodeULEB128(NameIndex << 1 | (HasAnnotation ? 1 : 0), OS);
+    if (!HasAnnotation)
+    {
+        return;
+    }
+
+    unknown::encodeULEB128(ExtraInfoList.size(), OS);
+    for (auto &ExtraInfo : ExtraInfoList)
+    {
+        unknown::encodeULEB128(getStringIndex(ExtraInfo), OS);
+    }
+    unknown::encodeULEB128(Comment.empty() ? 0 : getStringIndex(Comment) + 1, OS);
+}
+
+// Write the reference to the value
+void
+ModuleWriter::writeValueRef(unknown::raw_ostream &OS, FunctionState &FS, const Value *V)
+{
+    using namespace binary;
+
+    // The reader rejects a null operand, so the whole container fails here
+    auto unresolved = [&]() {
+        error("unresolved operand in the function " + FS.F->getFunctionName());
+        OS << static_cast<char>(NullRef);
+    };
+
+    if (V == nullptr)
+    {
+        unresolved();
+        return;
+    }
+
+    if (auto CI = unknown::dyn_cast<ConstantInt>(V))
+    {
+        OS << static_cast<char>(ConstantIntRef);
+        unknown::encodeULEB128(getTypeIndex(CI->getType()), OS);
+
+        // The width is the one of the type
+        auto &Val = CI->getValue();
+        if (Val.getBitWidth() <= 64)
+        {
+            unknown::encodeULEB128(Val.getZExtValue(), OS);
+        }
+        else
+        {
+            for (unsigned i = 0; i < Val.getNumWords(); ++i)
+            {
+                unknown::encodeULEB128(Val.getRawData()[i], OS);
+            }
+        }
+        return;
+    }
+
+    if (auto GV = unknown::dyn_cast<GlobalVariable>(V))
+    {
+        OS << static_cast<char>(GlobalRef);
+        unknown::encodeULEB128(getGlobalIndex(GV), OS);
+        return;
+    }
+
+    // The values below are only valid in the function or the module
+    auto refByIndex = [&](ValueRefKind Kind, const unknown::DenseMap<const Value *, uint32_t> &Index) {
+        auto It = Index.find(V);
+        if (It == Index.end())
+        {
+            unresolved();
+            return;
+        }
+
+        OS << static_cast<char>(Kind);
+        unknown::encodeULEB128(It->second, OS);
+    };
+
+    if (unknown::isa<BasicBlock>(V))
+    {
+        refByIndex(BasicBlockRef, FS.BlockIndex);
+    }
+    else if (unknown::isa<Argument>(V))
+    {
+        refByIndex(ArgumentRef, FS.ArgumentIndex);
+    }
+    else if (unknown::isa<FunctionContext>(V))
+    {
+        refByIndex(FunctionContextRef, FS.FunctionContextIndex);
+    }
+    else if (auto F = unknown::dyn_cast<Function>(V))
+    {
+        auto It = mFunctionIndex.find(F);
+        if (It == mFunctionIndex.end())
+        {
+            unresolved();
+            return;
+        }
+
+        OS << static_cast<char>(FunctionRef);
+        unknown::encodeULEB128(It->second, OS);
+    }
+    else if (auto It = FS.LocalSlots.find(V); It != FS.LocalSlots.end())
+    {
+        // The reader needs the type to stand in for the value until it is defined
+        if (It->second < FS.NumDefinedSlots)
+        {
+            OS << static_cast<char>(LocalRef);
+            unknown::encodeULEB128(It->second, OS);
+        }
+        else
+        {
+            OS << static_cast<char>(ForwardLocalRef);
+            unknown::encodeULEB128(It->second, OS);
+            unknown::encodeULEB128(getTypeIndex(V->getType()), OS);
+        }
+    }
+    else
+    {
+        unresolved();
+    }
+}
+
+// Record the first error, always returns false
+bool
+ModuleWriter::error(const unknown::Twine &Message)
+{
+    if (mErrorMessage.empty())
+    {
+        mErrorMessage = Message.str();
+    }
+
+    return false;
+}
+
+} // namespace uir
@@ -35,13 +35,7 @@ Type::setTypeName(const unknown::StringRef &TypeName)
     mTypeName = TypeName;
 }
 
-// Get/Set the id of the type
-Type::TypeID
-Type::getTypeID() const
-{
-    return mTypeID;
-}
-
+// Set the id of the type
 void
 Type::setTypeID(TypeID TypeID)
 {
@@ -248,7 +242,7 @@ Type::getPointerTo()
 //     IntegerType
 //
 
-IntegerType::IntegerType(Context &C, const char *TypeName, uint32_t TypeSizeInBits) :
+IntegerType::IntegerType(Context &C, const unknown::StringRef &TypeName, uint32_t TypeSizeInBits) :
     Type(C, TypeName, Type::IntegerTyID, TypeSizeInBits)
 {
 }
@@ -261,67 +255,15 @@ IntegerType::~IntegerType() {}
 IntegerType *
 IntegerType::get(Context &C, uint32_t NumBits)
 {
-    // Check for the built-in integer types
-    if (NumBits == 1)
-    {
-        if (auto IntTy = dynamic_cast<IntegerType *>(Type::getInt1Ty(C)))
-        {
-            return IntTy;
-        }
-    }
-    else if (NumBits == 1)
-    {
-        if (auto IntTy = dynamic_cast<IntegerType *>(Type::getInt8Ty(C)))
-        {
-            return IntTy;
-        }
-    }
-    else if (NumBits == 16)
-    {
-        if (auto IntTy = dynamic_cast<IntegerType *>(Type::getInt16Ty(C)))
-        {
-            return IntTy;
-        }
-    }
-    else if (NumBits == 32)
-    {
-        if (auto IntTy = dynamic_cast<IntegerType *>(Type::getInt32Ty(C)))
-        {
-            return IntTy;
-        }
-    }
-    else if (NumBits == 64)
-    {
-        if (auto IntTy = dynamic_cast<IntegerType *>(Type::getInt64Ty(C)))
-        {
-            return IntTy;
-        }
-    }
-    else if (NumBits == 128)
-    {
-        if (auto IntTy = dynamic_cast<IntegerType *>(Type::getInt128Ty(C)))
-        {
-            return IntTy;
-        }
-    }
-
-    IntegerType *Entry = C.mImpl->mIntegerTypes[NumBits];
-    if (!Entry)
-    {
-        // i256/i512
-        std::string NewTypeName = "i";
-        NewTypeName += std::to_string(NumBits);
-
-        Entry = new IntegerType(C, NewTypeName.c_str(), NumBits);
-    }
-    return Entry;
+    // The built-in integer types are preinstalled in the table
+    return C.mImpl->getIntegerType(NumBits);
 }
 
 ////////////////////////////////////////////////////////////
 //     PointerType
 //
 
-PointerType::PointerType(Context &C, Type *ElementType, const char *TypeName) :
+PointerType::PointerType(Context &C, Type *ElementType, const unknown::StringRef &TypeName) :
     Type(C, TypeName, Type::PointerTyID, ElementType->getTypeBits())
 {
     mElementType = ElementType;
@@ -352,17 +294,7 @@ PointerType::getElementTypeBits() const
 PointerType *
 PointerType::get(Context &C, Type *ElementType)
 {
-    auto It = C.mImpl->mPointerTypes.find(ElementType);
-    if (It != C.mImpl->mPointerTypes.end())
-    {
-        return It->second;
-    }
-
-    // i8*/i16*/i32*/i64*
-    std::string PtrTyName = ElementType->getTypeName().str() + UIR_PTR_TYPE_NAME_SUFFIX;
-    PointerType *PtrTy = new PointerType(C, ElementType, PtrTyName.c_str());
-    C.mImpl->mPointerTypes[ElementType] = PtrTy;
-    return PtrTy;
+    return C.mImpl->getPointerType(ElementType);
 }
 
 } // namespace uir
\ No newline at end of file
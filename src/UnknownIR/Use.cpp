@@ -0,0 +1,68 @@
+#include <Use.h>
+#include <Value.h>
+
+namespace uir {
+
+////////////////////////////////////////////////////////////
+// Ctor/Dtor
+Use::Use() : Use(nullptr) {}
+
+Use::Use(User *Parent) : mVal(nullptr), mNext(nullptr), mPrev(nullptr), mParent(Parent) {}
+
+Use::~Use()
+{
+    drop();
+}
+
+////////////////////////////////////////////////////////////
+// Get/Set
+// Set the value and link this use into the use list of the value
+void
+Use::set(Value *V)
+{
+    drop();
+    mVal = V;
+    if (V)
+    {
+        V->addUse(*this);
+    }
+}
+
+// Set the value without linking this use into the use list of the value
+void
+Use::setUnlinked(Value *V)
+{
+    drop();
+    mVal = V;
+}
+
+// Unlink this use from the use list of its value, but keep the value
+void
+Use::drop()
+{
+    if (mPrev)
+    {
+        mVal->removeUse(*this);
+    }
+}
+
+// Take the value of another use and its place in the use list
+void
+Use::moveFrom(Use &Other)
+{
+    if (this == &Other)
+    {
+        return;
+    }
+
+    drop();
+    mVal = Other.mVal;
+    if (Other.mPrev)
+    {
+        mVal->replaceUse(Other, *this);
+    }
+
+    Other.mVal = nullptr;
+}
+
+} // namespace uir
@@ -2,33 +2,72 @@
 
 #include <Internal/InternalErrors/InternalErrors.h>
 
+#include <functional>
+
 namespace uir {
 
 ////////////////////////////////////////////////////////////
 // Ctor/Dtor
-User::User() : Value() {}
+User::User() : User(nullptr, "") {}
 
-User::User(Type *Ty, const unknown::StringRef &UserName) : Value(Ty, UserName) {}
+User::User(Type *Ty, const unknown::StringRef &UserName) :
+    Value(Ty, UserName), mOperandList(mInlineOperands), mNumOperands(0), mOperandCapacity(NumInlineOperands)
+{
+    for (auto &U : mInlineOperands)
+    {
+        U.setUser(this);
+    }
+}
 
 User::~User()
 {
     // Drop all references to operands.
     dropAllReferences();
+
+    if (mOperandList != mInlineOperands)
+    {
+        delete[] mOperandList;
+    }
 }
 
 ////////////////////////////////////////////////////////////
 // OperandList
-// Returns the list of operands for this instruction.
-User::OperandListType &
-User::getOperandList()
+// Is the use one of the operands of this user?
+bool
+User::isOperandUse(const Use *U) const
 {
-    return mOperandList;
+    return std::less_equal<const Use *>()(mOperandList, U) && std::less<const Use *>()(U, mOperandList + mNumOperands);
 }
 
-const User::OperandListType &
-User::getOperandList() const
+// Append a new empty operand, the operand list grows if needed
+Use &
+User::allocateOperand()
 {
-    return mOperandList;
+    if (mNumOperands == mOperandCapacity)
+    {
+        // Move the operands to a larger list, the moved uses keep their place in the use lists
+        uint32_t NewCapacity = mOperandCapacity * 2;
+        Use *NewOperandList = new Use[NewCapacity];
+        for (uint32_t i = 0; i < NewCapacity; ++i)
+        {
+            NewOperandList[i].setUser(this);
+        }
+
+        for (uint32_t i = 0; i < mNumOperands; ++i)
+        {
+            NewOperandList[i].moveFrom(mOperandList[i]);
+        }
+
+        if (mOperandList != mInlineOperands)
+        {
+            delete[] mOperandList;
+        }
+
+        mOperandList = NewOperandList;
+        mOperandCapacity = NewCapacity;
+    }
+
+    return mOperandList[mNumOperands++];
 }
 
 ////////////////////////////////////////////////////////////
@@ -36,80 +75,90 @@ User::getOperandList() const
 User::op_iterator
 User::op_begin()
 {
-    return mOperandList.begin();
+    return op_iterator(mOperandList);
 }
 
 User::const_op_iterator
 User::op_begin() const
 {
-    return mOperandList.cbegin();
+    return const_op_iterator(mOperandList);
 }
 
 User::op_iterator
 User::op_end()
 {
-    return mOperandList.end();
+    return op_iterator(mOperandList + mNumOperands);
 }
 
 User::const_op_iterator
 User::op_end() const
 {
-    return mOperandList.cend();
+    return const_op_iterator(mOperandList + mNumOperands);
 }
 
 Value *
 User::op_back()
 {
-    return mOperandList.back();
+    return mOperandList[mNumOperands - 1].get();
 }
 
 Value *
 User::op_front()
 {
-    return mOperandList.front();
+    return mOperandList[0].get();
 }
 
 void
 User::op_push(Value *V)
 {
-    mOperandList.push_back(V);
+    allocateOperand().setUnlinked(V);
 }
 
 void
 User::op_pop()
 {
-    mOperandList.pop_back();
+    mOperandList[--mNumOperands].setUnlinked(nullptr);
 }
 
 size_t
 User::op_count() const
 {
-    return mOperandList.size();
+    return mNumOperands;
 }
 
 void
 User::op_erase(Value *V)
 {
-    for (auto It = mOperandList.begin(); It != mOperandList.end(); ++It)
+    uint32_t NumOperands = 0;
+    for (uint32_t i = 0; i < mNumOperands; ++i)
     {
-        if (*It == V)
+        if (mOperandList[i].get() == V)
         {
-            mOperandList.erase(It);
-            --It;
+            mOperandList[i].setUnlinked(nullptr);
+            continue;
         }
+
+        mOperandList[NumOperands++].moveFrom(mOperandList[i]);
     }
+
+    mNumOperands = NumOperands;
 }
 
 bool
 User::op_empty() const
 {
-    return mOperandList.empty();
+    return mNumOperands == 0;
 }
 
 void
 User::op_clear()
 {
-    mOperandList.clear();
+    for (uint32_t i = 0; i < mNumOperands; ++i)
+    {
+        mOperandList[i].setUnlinked(nullptr);
+    }
+
+    mNumOperands = 0;
 }
 
 ////////////////////////////////////////////////////////////
@@ -118,7 +167,18 @@ User::op_clear()
 void
 User::replaceUsesOfWith(Value *From, Value *To)
 {
-    // nothing
+    if (From == To)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < mNumOperands; ++i)
+    {
+        if (mOperandList[i].get() == From)
+        {
+            mOperandList[i].set(To);
+        }
+    }
 }
 
 // Change all uses of this to point to a new Value.
@@ -131,10 +191,16 @@ User::replaceAllUsesWith(Value *V)
         return;
     }
 
-    // Replace all uses of this value with the new value.
-    for (auto &User : mUsers)
+    // Replace all uses of this value with the new value, it is proportional to the number of uses.
+    // The uses which are not operands (e.g. the flags of an instruction) are kept.
+    for (Use *U = mUseList; U != nullptr;)
     {
-        User->replaceUsesOfWith(this, V);
+        Use *Next = U->getNext();
+        if (U->getUser()->isOperandUse(U))
+        {
+            U->set(V);
+        }
+        U = Next;
     }
 }
 
@@ -144,10 +210,10 @@ User::replaceAllUsesWith(Value *V)
 const Value *
 User::getOperand(size_t Index) const
 {
-    assert(Index < mOperandList.size() && "getOperand() out of range!");
+    assert(Index < mNumOperands && "getOperand() out of range!");
     if (!op_empty())
     {
-        return mOperandList[Index];
+        return mOperandList[Index].get();
     }
 
     return nullptr;
@@ -156,10 +222,10 @@ User::getOperand(size_t Index) const
 Value *
 User::getOperand(size_t Index)
 {
-    assert(Index < mOperandList.size() && "getOperand() out of range!");
+    assert(Index < mNumOperands && "getOperand() out of range!");
     if (!op_empty())
     {
-        return mOperandList[Index];
+        return mOperandList[Index].get();
     }
 
     return nullptr;
@@ -174,8 +240,8 @@ User::setOperand(size_t Index, Value *Val)
         return;
     }
 
-    assert(Index < mOperandList.size() && "setOperand() out of range!");
-    mOperandList[Index] = Val;
+    assert(Index < mNumOperands && "setOperand() out of range!");
+    mOperandList[Index].setUnlinked(Val);
 }
 
 // Set the operand at the specified index and update the user list.
@@ -187,34 +253,25 @@ User::setOperandAndUpdateUsers(size_t Index, Value *Val)
         return;
     }
 
-    assert(Index < mOperandList.size() && "setOperandAndUpdateUsers() out of range!");
-    auto OldVal = mOperandList[Index];
-    if (OldVal == Val)
+    assert(Index < mNumOperands && "setOperandAndUpdateUsers() out of range!");
+    auto OldVal = mOperandList[Index].get();
+    if (OldVal == Val && mOperandList[Index].isLinked())
     {
         return;
     }
 
-    // Set operand
-    setOperand(Index, Val);
-
-    // Update user
-    if (OldVal)
-    {
-        OldVal->user_erase(this);
-    }
-    else
+    if (OldVal == nullptr)
     {
         uir_unreachable("OldVal == nullptr in User::setOperandAndUpdateUsers");
     }
 
-    if (Val)
-    {
-        Val->user_insert(this);
-    }
-    else
+    if (Val == nullptr)
     {
         uir_unreachable("Val == nullptr in User::setOperandAndUpdateUsers");
     }
+
+    // Set operand and update user
+    mOperandList[Index].set(Val);
 }
 
 ////////////////////////////////////////////////////////////
@@ -230,17 +287,13 @@ User::insertOperand(Value *Val)
 void
 User::insertOperandAndUpdateUsers(Value *Val)
 {
-    // Insert the specified value.
-    insertOperand(Val);
-    if (Val)
-    {
-        // Insert user
-        Val->user_insert(this);
-    }
-    else
+    if (Val == nullptr)
     {
         uir_unreachable("Val == nullptr in User::insertOperandAndUpdateUsers");
     }
+
+    // Insert the specified value and link the use
+    allocateOperand().set(Val);
 }
 
 // Erase the specified value.
@@ -264,20 +317,13 @@ User::eraseOperandAndUpdateUsers(Value *Val)
         return;
     }
 
-    // Erase the specified value.
-    eraseOperand(Val);
-    if (Val)
-    {
-        // Erase user
-        if (std::find(op_begin(), op_end(), Val) == op_end())
-        {
-            Val->user_erase(this);
-        }
-    }
-    else
+    if (Val == nullptr)
     {
         uir_unreachable("Val == nullptr in User::eraseOperandAndUpdateUsers");
     }
+
+    // Erase the specified value, the erased uses are unlinked
+    eraseOperand(Val);
 }
 
 // Drop all references to operands.
@@ -289,12 +335,9 @@ User::dropAllReferences()
         return;
     }
 
-    for (Value *Op : mOperandList)
+    for (uint32_t i = 0; i < mNumOperands; ++i)
     {
-        if (Op)
-        {
-            Op->user_erase(this);
-        }
+        mOperandList[i].drop();
     }
 }
 
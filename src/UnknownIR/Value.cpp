@@ -4,14 +4,89 @@
 
 #include <Internal/InternalConfig/InternalConfig.h>
 
+#include <UnknownUtils/unknown/ADT/SmallString.h>
+
+#include <mutex>
+
 namespace uir {
+
+// The striped locks guarding the use lists of shared values
+static std::mutex &
+getSharedUseListMutex(const Value *V)
+{
+    static std::mutex SharedUseListMutexes[64];
+    return SharedUseListMutexes[(reinterpret_cast<uintptr_t>(V) >> 4) % 64];
+}
+
 ////////////////////////////////////////////////////////////
 // Ctor/Dtor
 Value::Value() : Value(nullptr, "") {}
 
-Value::Value(Type *Ty, const unknown::StringRef &ValueName) : mType(Ty), mValueName(ValueName), mComment("") {}
+Value::Value(Type *Ty, const unknown::StringRef &ValueName) :
+    mType(Ty),
+    mValueID(ConstantVal),
+    mValueName(internName(Ty, ValueName)),
+    mUseList(nullptr),
+    mIsShared(false),
+    mAnnotation(nullptr)
+{
+}
 
-Value::~Value() {}
+Value::~Value()
+{
+    // Detach the remaining uses, so that they do not point to a freed value
+    for (Use *U = mUseList; U != nullptr;)
+    {
+        Use *Next = U->mNext;
+        U->mVal = nullptr;
+        U->mNext = nullptr;
+        U->mPrev = nullptr;
+        U = Next;
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Allocation
+// Allocate the value on the heap
+void *
+Value::operator new(size_t Size)
+{
+    return operator new(Size, nullptr);
+}
+
+// Allocate the value on the heap, or in the arena if it is not nullptr
+void *
+Value::operator new(size_t Size, unknown::BumpPtrAllocator *Arena)
+{
+    // The word in front of the value records the arena, nullptr for the heap
+    auto Header = static_cast<unknown::BumpPtrAllocator **>(
+        Arena ? Arena->Allocate(Size + sizeof(Arena), alignof(void *)) : ::operator new(Size + sizeof(Arena)));
+    *Header = Arena;
+    return Header + 1;
+}
+
+// Free the value, the memory of a value in an arena is released with the arena
+void
+Value::operator delete(void *Ptr)
+{
+    if (Ptr == nullptr)
+    {
+        return;
+    }
+
+    auto Header = static_cast<unknown::BumpPtrAllocator **>(Ptr) - 1;
+    if (*Header == nullptr)
+    {
+        ::operator delete(Header);
+    }
+}
+
+// Called if the constructor of a value allocated in an arena throws
+void
+Value::operator delete(void *Ptr, unknown::BumpPtrAllocator *Arena)
+{
+    operator delete(Ptr);
+}
 
 ////////////////////////////////////////////////////////////
 // Context
@@ -22,17 +97,64 @@ Value::getContext() const
 }
 
 ////////////////////////////////////////////////////////////
-// User
-const Value::UsersListType &
-Value::getUsers() const
+// Use
+// Link the use into the use list of this value
+void
+Value::addUse(Use &U)
 {
-    return mUsers;
+    std::unique_lock<std::mutex> Lock;
+    if (mIsShared)
+    {
+        Lock = std::unique_lock<std::mutex>(getSharedUseListMutex(this));
+    }
+
+    U.mNext = mUseList;
+    if (mUseList)
+    {
+        mUseList->mPrev = &U.mNext;
+    }
+    U.mPrev = &mUseList;
+    mUseList = &U;
 }
 
-Value::UsersListType &
-Value::getUsers()
+// Unlink the use from the use list of this value
+void
+Value::removeUse(Use &U)
 {
-    return mUsers;
+    std::unique_lock<std::mutex> Lock;
+    if (mIsShared)
+    {
+        Lock = std::unique_lock<std::mutex>(getSharedUseListMutex(this));
+    }
+
+    *U.mPrev = U.mNext;
+    if (U.mNext)
+    {
+        U.mNext->mPrev = U.mPrev;
+    }
+    U.mNext = nullptr;
+    U.mPrev = nullptr;
+}
+
+// Replace the use From by the use To in the use list of this value
+void
+Value::replaceUse(Use &From, Use &To)
+{
+    std::unique_lock<std::mutex> Lock;
+    if (mIsShared)
+    {
+        Lock = std::unique_lock<std::mutex>(getSharedUseListMutex(this));
+    }
+
+    To.mNext = From.mNext;
+    To.mPrev = From.mPrev;
+    *To.mPrev = &To;
+    if (To.mNext)
+    {
+        To.mNext->mPrev = &To.mNext;
+    }
+    From.mNext = nullptr;
+    From.mPrev = nullptr;
 }
 
 ////////////////////////////////////////////////////////////
@@ -45,9 +167,9 @@ Value::hasName() const
 }
 
 void
-Value::setName(const char *ValueName)
+Value::setName(const unknown::Twine &ValueName)
 {
-    mValueName = ValueName;
+    mValueName = internName(mType, ValueName);
 }
 
 // Get/Set the type of the value
@@ -76,32 +198,82 @@ Value::getValueSize() const
     return mType->getTypeBits() / 8;
 }
 
+// Is the value shared by threads?
+bool
+Value::isShared() const
+{
+    return mIsShared;
+}
+
 // Get the extra info of this object
 const Value::ExtraInfoListType &
 Value::getExtraInfoList() const
 {
-    return mExtraInfoList;
+    static const ExtraInfoListType EmptyExtraInfoList;
+    return mAnnotation ? mAnnotation->ExtraInfoList : EmptyExtraInfoList;
 }
 
 // Set the extra info of this object
 void
 Value::setExtraInfoList(const Value::ExtraInfoListType &ExtraInfo)
 {
-    mExtraInfoList = ExtraInfo;
+    if (ExtraInfo.empty() && !mAnnotation)
+    {
+        return;
+    }
+
+    getOrCreateAnnotation().ExtraInfoList = ExtraInfo;
 }
 
 // Get the comment of this object
 const std::string
 Value::getComment() const
 {
-    return mComment;
+    return mAnnotation ? mAnnotation->Comment : "";
 }
 
 // Set the comment of this object
 void
 Value::setComment(const unknown::StringRef &Comment)
 {
-    mComment = Comment;
+    if (Comment.empty() && !mAnnotation)
+    {
+        return;
+    }
+
+    getOrCreateAnnotation().Comment = Comment;
+}
+
+// Get the annotation of this object, it is allocated if it doesn't exist
+Value::AnnotationType &
+Value::getOrCreateAnnotation()
+{
+    if (!mAnnotation)
+    {
+        mAnnotation = std::make_unique<AnnotationType>();
+    }
+
+    return *mAnnotation;
+}
+
+// Intern the name in the context of the type
+unknown::StringRef
+Value::internName(Type *Ty, const unknown::Twine &ValueName)
+{
+    if (ValueName.isTriviallyEmpty())
+    {
+        return unknown::StringRef();
+    }
+
+    unknown::SmallString<64> NameBuffer;
+    auto Name = ValueName.toStringRef(NameBuffer);
+    if (Name.empty())
+    {
+        return unknown::StringRef();
+    }
+
+    assert(Ty && "A named value must have a type");
+    return Ty->getContext().mImpl->internName(Name);
 }
 
 ////////////////////////////////////////////////////////////
@@ -110,10 +282,11 @@ Value::setComment(const unknown::StringRef &Comment)
 void
 Value::addExtraInfo(const unknown::StringRef &ExtraInfo)
 {
-    auto It = std::find(mExtraInfoList.begin(), mExtraInfoList.end(), ExtraInfo);
-    if (It == mExtraInfoList.end())
+    auto &ExtraInfoList = getOrCreateAnnotation().ExtraInfoList;
+    auto It = std::find(ExtraInfoList.begin(), ExtraInfoList.end(), ExtraInfo);
+    if (It == ExtraInfoList.end())
     {
-        mExtraInfoList.push_back(ExtraInfo);
+        ExtraInfoList.push_back(ExtraInfo);
     }
 }
 
@@ -121,10 +294,16 @@ Value::addExtraInfo(const unknown::StringRef &ExtraInfo)
 void
 Value::removeExtraInfo(const unknown::StringRef &ExtraInfo)
 {
-    auto It = std::find(mExtraInfoList.begin(), mExtraInfoList.end(), ExtraInfo);
-    if (It != mExtraInfoList.end())
+    if (!mAnnotation)
     {
-        mExtraInfoList.erase(It);
+        return;
+    }
+
+    auto &ExtraInfoList = mAnnotation->ExtraInfoList;
+    auto It = std::find(ExtraInfoList.begin(), ExtraInfoList.end(), ExtraInfo);
+    if (It != ExtraInfoList.end())
+    {
+        ExtraInfoList.erase(It);
     }
 }
 
@@ -132,7 +311,12 @@ Value::removeExtraInfo(const unknown::StringRef &ExtraInfo)
 void
 Value::addComment(const unknown::StringRef &Comment)
 {
-    mComment += Comment;
+    if (Comment.empty())
+    {
+        return;
+    }
+
+    getOrCreateAnnotation().Comment += Comment;
 }
 
 ////////////////////////////////////////////////////////////
@@ -140,75 +324,49 @@ Value::addComment(const unknown::StringRef &Comment)
 Value::user_iterator
 Value::user_begin()
 {
-    return mUsers.begin();
+    return user_iterator(mUseList);
 }
 
 Value::const_user_iterator
 Value::user_begin() const
 {
-    return mUsers.cbegin();
+    return const_user_iterator(mUseList);
 }
 
 Value::user_iterator
 Value::user_end()
 {
-    return mUsers.end();
+    return user_iterator();
 }
 
 Value::const_user_iterator
 Value::user_end() const
 {
-    return mUsers.cend();
+    return const_user_iterator();
 }
 
 bool
 Value::user_empty() const
 {
-    return mUsers.empty();
+    return mUseList == nullptr;
 }
 
 bool
-Value::user_contains(User *U) const
+Value::user_contains(const User *U) const
 {
-    return mUsers.contains(U);
+    return std::find(user_begin(), user_end(), U) != user_end();
 }
 
 size_t
 Value::user_size() const
 {
-    return mUsers.size();
+    return std::distance(user_begin(), user_end());
 }
 
 size_t
-Value::user_count(User *U) const
-{
-    return mUsers.count(U);
-}
-
-void
-Value::user_insert(User *U)
-{
-    auto It = mUsers.find(U);
-    if (It == mUsers.end())
-    {
-        mUsers.insert(U);
-    }
-}
-
-void
-Value::user_erase(User *U)
+Value::user_count(const User *U) const
 {
-    auto It = mUsers.find(U);
-    if (It != mUsers.end())
-    {
-        mUsers.erase(It);
-    }
-}
-
-void
-Value::user_clear()
-{
-    mUsers.clear();
+    return std::count(user_begin(), user_end(), U);
 }
 
 ////////////////////////////////////////////////////////////
@@ -217,20 +375,34 @@ Value::user_clear()
 std::string
 Value::getName() const
 {
-    return mValueName;
+    return mValueName.str();
 }
 
 // Get the readable name of the value
 std::string
 Value::getReadableName() const
 {
-    // %var i32
-    std::string ReadableName = UIR_LOCAL_VARIABLE_NAME_PREFIX;
-    ReadableName += mValueName;
-    ReadableName += " ";
-    ReadableName += mType->getTypeName();
+    std::string ReadableName;
+    unknown::raw_string_ostream OS(ReadableName);
+    printReadableName(OS);
+    return OS.str();
+}
 
-    return ReadableName;
+// Print the readable name of the value
+void
+Value::printReadableName(unknown::raw_ostream &OS) const
+{
+    // %var i32, the anonymous locals are numbered once
+    OS << UIR_LOCAL_VARIABLE_NAME_PREFIX;
+    if (hasName())
+    {
+        OS << mValueName;
+    }
+    else
+    {
+        OS << getName();
+    }
+    OS << " " << mType->getTypeName();
 }
 
 // Get the property 'name' of the value
@@ -304,7 +476,10 @@ Value::printExtraInfo(unknown::raw_ostream &OS) const
 void
 Value::printCommentInfo(unknown::raw_ostream &OS) const
 {
-    OS << mComment;
+    if (mAnnotation)
+    {
+        OS << mAnnotation->Comment;
+    }
 }
 
 } // namespace uir
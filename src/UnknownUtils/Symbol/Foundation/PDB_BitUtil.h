@@ -11,6 +11,7 @@
 #ifdef _WIN32
 #    include <intrin.h>
 #    pragma intrinsic(_BitScanForward)
+#    pragma intrinsic(__popcnt)
 #endif
 
 namespace PDB {
@@ -63,5 +64,17 @@ FindFirstSetBit(uint32_t value) PDB_NO_EXCEPT
 
     return result;
 }
+
+// Counts the set bits in the given value, e.g. CountSetBits(0b00010110) == 3. This operation is also known as
+// POPCNT (Population Count).
+PDB_NO_DISCARD inline uint32_t
+CountSetBits(uint32_t value) PDB_NO_EXCEPT
+{
+#ifdef _WIN32
+    return static_cast<uint32_t>(__popcnt(value));
+#else
+    return static_cast<uint32_t>(__builtin_popcount(value));
+#endif
+}
 } // namespace BitUtil
 } // namespace PDB
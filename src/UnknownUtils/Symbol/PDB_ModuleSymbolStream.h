@@ -7,7 +7,7 @@
 #include "Foundation/PDB_BitUtil.h"
 #include "PDB_DBITypes.h"
 #include "PDB_Util.h"
-#include "PDB_CoalescedMSFStream.h"
+#include "PDB_RecordMSFStream.h"
 
 namespace PDB {
 class RawFile;
@@ -24,14 +24,14 @@ public:
     template <typename T>
     PDB_NO_DISCARD inline const CodeView::DBI::Record *GetParentRecord(const T &record) const PDB_NO_EXCEPT
     {
-        return m_stream.GetDataAtOffset<const CodeView::DBI::Record>(record.parent);
+        return m_stream.GetRecordAtOffset(record.parent);
     }
 
     // Returns a record's end record.
     template <typename T>
     PDB_NO_DISCARD inline const CodeView::DBI::Record *GetEndRecord(const T &record) const PDB_NO_EXCEPT
     {
-        return m_stream.GetDataAtOffset<const CodeView::DBI::Record>(record.end);
+        return m_stream.GetRecordAtOffset(record.end);
     }
 
     // Finds a record of a certain kind.
@@ -48,7 +48,7 @@ public:
         while (offset < m_stream.GetSize())
         {
             // https://llvm.org/docs/PDB/CodeViewTypes.html
-            const CodeView::DBI::Record *record = m_stream.GetDataAtOffset<const CodeView::DBI::Record>(offset);
+            const CodeView::DBI::Record *record = m_stream.GetRecordAtOffset(offset);
             const uint32_t recordSize = GetCodeViewRecordSize(record);
 
             functor(record);
@@ -59,7 +59,7 @@ public:
     }
 
 private:
-    CoalescedMSFStream m_stream;
+    RecordMSFStream m_stream;
 
     PDB_DISABLE_COPY(ModuleSymbolStream);
 };
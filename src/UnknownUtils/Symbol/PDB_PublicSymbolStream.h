@@ -6,6 +6,7 @@
 #include "Foundation/PDB_Macros.h"
 #include "Foundation/PDB_ArrayView.h"
 #include "PDB_CoalescedMSFStream.h"
+#include "PDB_RecordMSFStream.h"
 
 namespace PDB {
 class RawFile;
@@ -28,7 +29,12 @@ public:
     // Turns a given hash record into a DBI record using the given symbol stream..
     // Returns nullptr in case the record is not of type S_PUB32, which should only happen for invalid PDBs.
     PDB_NO_DISCARD const CodeView::DBI::Record *
-    GetRecord(const CoalescedMSFStream &symbolRecordStream, const HashRecord &hashRecord) const PDB_NO_EXCEPT;
+    GetRecord(const RecordMSFStream &symbolRecordStream, const HashRecord &hashRecord) const PDB_NO_EXCEPT;
+
+    // Turns a given entry of the address map into a DBI record using the given symbol stream.
+    // Returns nullptr in case the record is not of type S_PUB32, which should only happen for invalid PDBs.
+    PDB_NO_DISCARD const CodeView::DBI::Record *
+    GetRecord(const RecordMSFStream &symbolRecordStream, uint32_t addressMapEntry) const PDB_NO_EXCEPT;
 
     // Returns a view of all the records in the stream.
     PDB_NO_DISCARD inline ArrayView<HashRecord> GetRecords(void) const PDB_NO_EXCEPT
@@ -36,6 +42,14 @@ public:
         return ArrayView<HashRecord>(m_hashRecords, m_count);
     }
 
+    // Returns a view of the records in the hash bucket of the given name.
+    // The bucket can hold the records of other names, the names of the records need to be compared.
+    PDB_NO_DISCARD ArrayView<HashRecord> GetRecordsInBucket(const char *name, size_t length) const PDB_NO_EXCEPT;
+
+    // Returns a view of the address map, the offsets of the records in the symbol record stream sorted by their
+    // section and offset.
+    PDB_NO_DISCARD ArrayView<uint32_t> GetAddressMap(void) const PDB_NO_EXCEPT;
+
 private:
     CoalescedMSFStream m_stream;
     const HashRecord *m_hashRecords;
@@ -0,0 +1,54 @@
+// Copyright 2011-2022, Molecular Matters GmbH <office@molecular-matters.com>
+// See LICENSE.txt for licensing details (2-clause BSD License: https://opensource.org/licenses/BSD-2-Clause)
+
+#pragma once
+
+#include "Foundation/PDB_Macros.h"
+#include "PDB_DirectMSFStream.h"
+#include "Foundation/PDB_DisableWarningsPush.h"
+#include <cstdint>
+#include "Foundation/PDB_DisableWarningsPop.h"
+
+// https://llvm.org/docs/PDB/index.html#the-msf-container
+// https://llvm.org/docs/PDB/MsfFile.html
+namespace PDB {
+namespace CodeView {
+namespace DBI {
+struct Record;
+}
+} // namespace CodeView
+
+// provides access to the CodeView records of an MSF stream.
+// thread-safe, the records coalesced so far are guarded by a lock.
+// never coalesces the whole stream. records within contiguous blocks point into the memory-mapped data directly,
+// only records straddling disjunct blocks are coalesced one by one upon first access.
+// all returned records stay valid for the lifetime of the stream.
+class PDB_NO_DISCARD RecordMSFStream
+{
+public:
+    RecordMSFStream(void) PDB_NO_EXCEPT;
+    RecordMSFStream(RecordMSFStream &&other) PDB_NO_EXCEPT;
+    RecordMSFStream &operator=(RecordMSFStream &&other) PDB_NO_EXCEPT;
+
+    explicit RecordMSFStream(const void *data, uint32_t blockSize, const uint32_t *blockIndices, uint32_t streamSize)
+        PDB_NO_EXCEPT;
+
+    ~RecordMSFStream(void) PDB_NO_EXCEPT;
+
+    // Returns the size of the stream.
+    PDB_NO_DISCARD inline size_t GetSize(void) const PDB_NO_EXCEPT { return m_stream.GetSize(); }
+
+    // Provides read-only access to the CodeView record at the given offset, including its variable-length data.
+    PDB_NO_DISCARD const CodeView::DBI::Record *GetRecordAtOffset(size_t offset) const PDB_NO_EXCEPT;
+
+private:
+    struct CoalescedRecords;
+
+    DirectMSFStream m_stream;
+
+    // records that have been copied from disjunct blocks, keyed by their offset, can be null
+    CoalescedRecords *m_coalescedRecords;
+
+    PDB_DISABLE_COPY(RecordMSFStream);
+};
+} // namespace PDB
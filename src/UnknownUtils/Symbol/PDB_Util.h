@@ -25,6 +25,26 @@ ConvertSizeToBlockCount(uint32_t sizeInBytes, uint32_t blockSize) PDB_NO_EXCEPT
     return (sizeInBytes + blockSize - 1u) / blockSize;
 };
 
+// Checks whether the blocks holding a certain number of bytes are contiguous (N, N+1, N+2, ...) in the file
+PDB_NO_DISCARD inline bool
+AreBlockIndicesContiguous(const uint32_t *blockIndices, uint32_t blockSize, uint32_t sizeInBytes) PDB_NO_EXCEPT
+{
+    const uint32_t blockCount = ConvertSizeToBlockCount(sizeInBytes, blockSize);
+
+    // start with the first index, checking if all following indices are contiguous
+    uint32_t expectedIndex = blockIndices[0];
+    for (uint32_t i = 1u; i < blockCount; ++i)
+    {
+        ++expectedIndex;
+        if (blockIndices[i] != expectedIndex)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 // Returns the actual size of the data associated with a CodeView record, not including the size of the header
 template <typename T>
 PDB_NO_DISCARD inline uint32_t
@@ -58,4 +78,35 @@ GetNameLength(const Header &header, const T &record) PDB_NO_EXCEPT
     const size_t length = estimatedLength - nullTerminatorCount;
     return length;
 }
+
+// Hashes a name the way the hash tables of the public and global symbol streams do, based on LHashPbCb defined here:
+// https://github.com/microsoft/microsoft-pdb/blob/master/PDB/include/misc.h#L15
+PDB_NO_DISCARD inline uint32_t
+HashStringV1(const char *name, size_t length) PDB_NO_EXCEPT
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(name);
+
+    uint32_t result = 0u;
+    for (/* nothing */; length >= 4u; data += 4u, length -= 4u)
+    {
+        result ^= static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8u |
+                  static_cast<uint32_t>(data[2]) << 16u | static_cast<uint32_t>(data[3]) << 24u;
+    }
+
+    if (length >= 2u)
+    {
+        result ^= static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8u;
+        data += 2u;
+        length -= 2u;
+    }
+
+    if (length == 1u)
+    {
+        result ^= data[0];
+    }
+
+    result |= 0x20202020u;
+    result ^= (result >> 11u);
+    return result ^ (result >> 16u);
+}
 } // namespace PDB
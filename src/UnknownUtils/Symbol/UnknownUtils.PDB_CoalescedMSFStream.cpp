@@ -11,29 +11,6 @@
 #include <cstring>
 #include "Foundation/PDB_DisableWarningsPop.h"
 
-namespace {
-// ------------------------------------------------------------------------------------------------
-// ------------------------------------------------------------------------------------------------
-PDB_NO_DISCARD static bool
-AreBlockIndicesContiguous(const uint32_t *blockIndices, uint32_t blockSize, uint32_t streamSize) PDB_NO_EXCEPT
-{
-    const uint32_t blockCount = PDB::ConvertSizeToBlockCount(streamSize, blockSize);
-
-    // start with the first index, checking if all following indices are contiguous (N, N+1, N+2, ...)
-    uint32_t expectedIndex = blockIndices[0];
-    for (uint32_t i = 1u; i < blockCount; ++i)
-    {
-        ++expectedIndex;
-        if (blockIndices[i] != expectedIndex)
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-} // namespace
-
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 PDB::CoalescedMSFStream::CoalescedMSFStream(void) PDB_NO_EXCEPT : m_ownedData(nullptr), m_data(nullptr), m_size(0u) {}
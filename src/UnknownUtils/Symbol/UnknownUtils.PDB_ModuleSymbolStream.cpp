@@ -12,7 +12,7 @@ PDB::ModuleSymbolStream::ModuleSymbolStream(void) PDB_NO_EXCEPT : m_stream() {}
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 PDB::ModuleSymbolStream::ModuleSymbolStream(const RawFile &file, uint16_t streamIndex, uint32_t symbolStreamSize)
-    PDB_NO_EXCEPT : m_stream(file.CreateMSFStream<CoalescedMSFStream>(streamIndex, symbolStreamSize))
+    PDB_NO_EXCEPT : m_stream(file.CreateMSFStream<RecordMSFStream>(streamIndex, symbolStreamSize))
 {
     // https://llvm.org/docs/PDB/ModiStream.html
     // struct ModiStream {
@@ -24,8 +24,8 @@ PDB::ModuleSymbolStream::ModuleSymbolStream(const RawFile &file, uint16_t stream
     //	uint8_t GlobalRefs[GlobalRefsSize];
     // };
     // we are only interested in the symbols, but not the line information or global refs.
-    // the coalesced stream is therefore only built for the symbols, not all the data in the stream.
-    // this potentially saves a lot of memory and performance on large PDBs.
+    // the record stream therefore only covers the symbols, not all the data in the stream.
+    // the records are accessed in place, only records straddling disjunct blocks are coalesced.
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -40,7 +40,7 @@ PDB::ModuleSymbolStream::FindRecord(CodeView::DBI::SymbolRecordKind kind) const
     while (offset < m_stream.GetSize())
     {
         // https://llvm.org/docs/PDB/CodeViewTypes.html
-        const CodeView::DBI::Record *record = m_stream.GetDataAtOffset<const CodeView::DBI::Record>(offset);
+        const CodeView::DBI::Record *record = m_stream.GetRecordAtOffset(offset);
         if (record->header.kind == kind)
         {
             return record;
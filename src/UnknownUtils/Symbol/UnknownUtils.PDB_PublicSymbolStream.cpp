@@ -6,6 +6,20 @@
 #include "PDB_RawFile.h"
 #include "PDB_Types.h"
 #include "PDB_DBITypes.h"
+#include "PDB_Util.h"
+#include "Foundation/PDB_BitUtil.h"
+
+namespace {
+// the number of buckets of the hash table, based on IPHR_HASH defined here:
+// https://github.com/Microsoft/microsoft-pdb/blob/master/PDB/dbi/gsi.h#L21
+static constexpr uint32_t HashBucketCount = 4096u;
+
+// the bitmap of the non-empty buckets has one more bit, it is padded to 32-bit words
+static constexpr uint32_t HashBitmapWordCount = (HashBucketCount + 1u + 31u) / 32u;
+
+// the offsets of the buckets are based on the in-memory hash records of a 32-bit PDB writer
+static constexpr uint32_t HashBucketRecordSize = 12u;
+} // namespace
 
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
@@ -23,15 +37,22 @@ PDB::PublicSymbolStream::PublicSymbolStream(const RawFile &file, uint16_t stream
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 PDB_NO_DISCARD const PDB::CodeView::DBI::Record *
-PDB::PublicSymbolStream::GetRecord(const CoalescedMSFStream &symbolRecordStream, const HashRecord &hashRecord) const
+PDB::PublicSymbolStream::GetRecord(const RecordMSFStream &symbolRecordStream, const HashRecord &hashRecord) const
     PDB_NO_EXCEPT
 {
     // hash record offsets start at 1, not at 0
-    const uint32_t headerOffset = hashRecord.offset - 1u;
+    return GetRecord(symbolRecordStream, hashRecord.offset - 1u);
+}
 
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB_NO_DISCARD const PDB::CodeView::DBI::Record *
+PDB::PublicSymbolStream::GetRecord(const RecordMSFStream &symbolRecordStream, uint32_t addressMapEntry) const
+    PDB_NO_EXCEPT
+{
     // the offset doesn't point to the public symbol directly, but to the CodeView record:
     // https://llvm.org/docs/PDB/CodeViewSymbols.html
-    const CodeView::DBI::Record *record = symbolRecordStream.GetDataAtOffset<const CodeView::DBI::Record>(headerOffset);
+    const CodeView::DBI::Record *record = symbolRecordStream.GetRecordAtOffset(addressMapEntry);
 
     if (record->header.kind != CodeView::DBI::SymbolRecordKind::S_PUB32)
     {
@@ -41,3 +62,73 @@ PDB::PublicSymbolStream::GetRecord(const CoalescedMSFStream &symbolRecordStream,
 
     return record;
 }
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB_NO_DISCARD PDB::ArrayView<PDB::HashRecord>
+PDB::PublicSymbolStream::GetRecordsInBucket(const char *name, size_t length) const PDB_NO_EXCEPT
+{
+    // the hash records are followed by the bitmap of the non-empty buckets and their offsets:
+    // https://llvm.org/docs/PDB/PublicStream.html
+    const HashTableHeader *hashHeader = m_stream.GetDataAtOffset<HashTableHeader>(sizeof(PublicStreamHeader));
+    const size_t bitmapOffset = sizeof(PublicStreamHeader) + sizeof(HashTableHeader) + hashHeader->size;
+    if (hashHeader->bucketCount < HashBitmapWordCount * sizeof(uint32_t) ||
+        bitmapOffset + hashHeader->bucketCount > m_stream.GetSize())
+    {
+        return ArrayView<HashRecord>(nullptr, 0u);
+    }
+
+    const uint32_t *bitmap = m_stream.GetDataAtOffset<uint32_t>(bitmapOffset);
+    const uint32_t *bucketOffsets = bitmap + HashBitmapWordCount;
+    const uint32_t nonEmptyBucketCount =
+        (hashHeader->bucketCount - HashBitmapWordCount * sizeof(uint32_t)) / sizeof(uint32_t);
+
+    const uint32_t bucket = HashStringV1(name, length) % HashBucketCount;
+    const uint32_t bucketBit = 1u << (bucket % 32u);
+    if ((bitmap[bucket / 32u] & bucketBit) == 0u)
+    {
+        return ArrayView<HashRecord>(nullptr, 0u);
+    }
+
+    // only the non-empty buckets have an offset
+    uint32_t bucketIndex = BitUtil::CountSetBits(bitmap[bucket / 32u] & (bucketBit - 1u));
+    for (uint32_t i = 0u; i < bucket / 32u; ++i)
+    {
+        bucketIndex += BitUtil::CountSetBits(bitmap[i]);
+    }
+
+    if (bucketIndex >= nonEmptyBucketCount)
+    {
+        return ArrayView<HashRecord>(nullptr, 0u);
+    }
+
+    const uint32_t begin = bucketOffsets[bucketIndex] / HashBucketRecordSize;
+    uint32_t end = m_count;
+    if (bucketIndex + 1u < nonEmptyBucketCount)
+    {
+        end = bucketOffsets[bucketIndex + 1u] / HashBucketRecordSize;
+    }
+
+    if (end > m_count || begin > end)
+    {
+        return ArrayView<HashRecord>(nullptr, 0u);
+    }
+
+    return ArrayView<HashRecord>(m_hashRecords + begin, end - begin);
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB_NO_DISCARD PDB::ArrayView<uint32_t>
+PDB::PublicSymbolStream::GetAddressMap(void) const PDB_NO_EXCEPT
+{
+    // the address map follows the hash table
+    const PublicStreamHeader *header = m_stream.GetDataAtOffset<PublicStreamHeader>(0u);
+    const size_t addressMapOffset = sizeof(PublicStreamHeader) + header->symHash;
+    if (addressMapOffset + header->addrMap > m_stream.GetSize())
+    {
+        return ArrayView<uint32_t>(nullptr, 0u);
+    }
+
+    return ArrayView<uint32_t>(m_stream.GetDataAtOffset<uint32_t>(addressMapOffset), header->addrMap / sizeof(uint32_t));
+}
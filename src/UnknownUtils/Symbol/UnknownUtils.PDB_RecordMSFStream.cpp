@@ -0,0 +1,128 @@
+// Copyright 2011-2022, Molecular Matters GmbH <office@molecular-matters.com>
+// See LICENSE.txt for licensing details (2-clause BSD License: https://opensource.org/licenses/BSD-2-Clause)
+
+#include "PDB_PCH.h"
+#include "PDB_RecordMSFStream.h"
+#include "PDB_Types.h"
+#include "PDB_DBITypes.h"
+#include "PDB_Util.h"
+#include "Foundation/PDB_PointerUtil.h"
+#include "Foundation/PDB_Memory.h"
+#include "Foundation/PDB_DisableWarningsPush.h"
+#include <mutex>
+#include <unordered_map>
+#include "Foundation/PDB_DisableWarningsPop.h"
+
+struct PDB::RecordMSFStream::CoalescedRecords
+{
+    std::mutex lock;
+    std::unordered_map<size_t, PDB::Byte *> records;
+};
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB::RecordMSFStream::RecordMSFStream(void) PDB_NO_EXCEPT : m_stream(), m_coalescedRecords(nullptr) {}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB::RecordMSFStream::RecordMSFStream(RecordMSFStream &&other) PDB_NO_EXCEPT
+    : m_stream(PDB_MOVE(other.m_stream)),
+      m_coalescedRecords(PDB_MOVE(other.m_coalescedRecords))
+{
+    other.m_coalescedRecords = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB::RecordMSFStream &
+PDB::RecordMSFStream::operator=(RecordMSFStream &&other) PDB_NO_EXCEPT
+{
+    if (this != &other)
+    {
+        if (m_coalescedRecords)
+        {
+            for (auto &record : m_coalescedRecords->records)
+            {
+                PDB_DELETE_ARRAY(record.second);
+            }
+
+            PDB_DELETE(m_coalescedRecords);
+        }
+
+        m_stream = PDB_MOVE(other.m_stream);
+        m_coalescedRecords = PDB_MOVE(other.m_coalescedRecords);
+
+        other.m_coalescedRecords = nullptr;
+    }
+
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB::RecordMSFStream::RecordMSFStream(
+    const void *data,
+    uint32_t blockSize,
+    const uint32_t *blockIndices,
+    uint32_t streamSize) PDB_NO_EXCEPT : m_stream(data, blockSize, blockIndices, streamSize),
+                                         m_coalescedRecords(nullptr)
+{
+    if (streamSize != 0u && !AreBlockIndicesContiguous(blockIndices, blockSize, streamSize))
+    {
+        // only streams with disjunct blocks can have records that need to be coalesced
+        m_coalescedRecords = PDB_NEW(CoalescedRecords);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB::RecordMSFStream::~RecordMSFStream(void) PDB_NO_EXCEPT
+{
+    if (m_coalescedRecords)
+    {
+        for (auto &record : m_coalescedRecords->records)
+        {
+            PDB_DELETE_ARRAY(record.second);
+        }
+
+        PDB_DELETE(m_coalescedRecords);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// ------------------------------------------------------------------------------------------------
+PDB_NO_DISCARD const PDB::CodeView::DBI::Record *
+PDB::RecordMSFStream::GetRecordAtOffset(size_t offset) const PDB_NO_EXCEPT
+{
+    // the header can straddle a block boundary as well, so it is always read.
+    // the stored size doesn't include the size of the 'size' field itself.
+    const CodeView::DBI::RecordHeader header = m_stream.ReadAtOffset<CodeView::DBI::RecordHeader>(offset);
+    const uint32_t size = sizeof(uint16_t) + header.size;
+
+    const DirectMSFStream::IndexAndOffset indexAndOffset =
+        m_stream.GetBlockIndexForOffset(static_cast<uint32_t>(offset));
+
+    // fast path, the record lies in contiguous blocks and is accessed in place.
+    // see CoalescedMSFStream for why the offset within the block is added to the size.
+    if (!m_coalescedRecords ||
+        AreBlockIndicesContiguous(
+            m_stream.GetBlockIndices() + indexAndOffset.index,
+            m_stream.GetBlockSize(),
+            indexAndOffset.offsetWithinBlock + size))
+    {
+        const size_t offsetWithinData = m_stream.GetDataOffsetForIndexAndOffset(indexAndOffset);
+        return Pointer::Offset<const CodeView::DBI::Record *>(m_stream.GetData(), offsetWithinData);
+    }
+
+    // slower path, the record is copied from disjunct blocks once and kept for the lifetime of the stream
+    std::lock_guard<std::mutex> lock(m_coalescedRecords->lock);
+
+    Byte *&record = m_coalescedRecords->records[offset];
+    if (!record)
+    {
+        record = PDB_NEW_ARRAY(Byte, size);
+        m_stream.ReadAtOffset(record, size, offset);
+    }
+
+    return reinterpret_cast<const CodeView::DBI::Record *>(record);
+}
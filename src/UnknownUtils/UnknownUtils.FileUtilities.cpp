@@ -0,0 +1,45 @@
+//===- Support/FileUtilities.cpp - File System Utilities ------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a family of utility functions which are useful for doing
+// various things with files.
+//
+//===----------------------------------------------------------------------===//
+
+#include "unknown/Support/FileUtilities.h"
+#include "unknown/ADT/SmallString.h"
+#include "unknown/Support/raw_ostream.h"
+
+using namespace unknown;
+
+bool unknown::writeFileAtomically(StringRef TempPathModel, StringRef FinalPath,
+                                  function_ref<bool(raw_ostream &)> Writer) {
+  SmallString<128> GeneratedUniqPath;
+  int TempFD;
+  if (sys::fs::createUniqueFile(TempPathModel, TempFD, GeneratedUniqPath))
+    return false;
+
+  // Make sure the temporary file gets removed if anything fails.
+  FileRemover RemoveTmpFileOnFail(GeneratedUniqPath);
+  {
+    raw_fd_ostream OS(TempFD, /*shouldClose=*/true);
+    bool Written = Writer(OS);
+    OS.close();
+    if (!Written || OS.has_error()) {
+      OS.clear_error();
+      return false;
+    }
+  }
+
+  if (sys::fs::rename(GeneratedUniqPath, FinalPath))
+    return false;
+
+  RemoveTmpFileOnFail.releaseFile();
+  return true;
+}
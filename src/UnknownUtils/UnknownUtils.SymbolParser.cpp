@@ -8,12 +8,23 @@
 #include "Symbol/PDB_NamesStream.h"
 #include "Symbol/ExampleMemoryMappedFile.h"
 
-#include <unordered_set>
-#include <regex>
+#include <unknown/ADT/DenseMap.h>
+#include <unknown/ADT/SmallString.h>
+#include <unknown/ADT/StringExtras.h>
+#include <unknown/Support/Endian.h>
+#include <unknown/Support/FileSystem.h>
+#include <unknown/Support/FileUtilities.h>
+#include <unknown/Support/MemoryBuffer.h>
+#include <unknown/Support/Path.h>
+#include <unknown/Support/ThreadPool.h>
+#include <unknown/Support/Threading.h>
+#include <unknown/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <iterator>
 #include <cstdio>
-#include <io.h>
+#include <cstring>
 #include <iostream>
-#include <fstream>
 #include <ostream>
 
 namespace unknown {
@@ -82,165 +93,487 @@ HasValidDBIStreams(const PDB::RawFile &rawPdbFile, const PDB::DBIStream &dbiStre
 
     return true;
 }
+
+// The index of the parsed function symbols of a PDB, it is named by the GUID and age of the PDB.
+//   header:  magic[8], version, GUID[16], age, symbol count, string table size
+//   symbols: fixed-size records, the names are offsets into the string table
+//   strings: the names of the symbols
+constexpr char SymbolIndexMagic[8] = {'U', 'P', 'D', 'B', 'I', 'D', 'X', '\0'};
+constexpr uint32_t SymbolIndexVersion = 1u;
+constexpr size_t SymbolIndexHeaderSize = 40u;
+constexpr size_t SymbolIndexRecordSize = 48u;
+
+// The flags of a record, in the order of their bits
+constexpr bool SymbolParser::FunctionSymbol::*SymbolIndexFlags[] = {
+    &SymbolParser::FunctionSymbol::hasAlloca,
+    &SymbolParser::FunctionSymbol::hasSetJmp,
+    &SymbolParser::FunctionSymbol::hasLongJmp,
+    &SymbolParser::FunctionSymbol::hasInlAsm,
+    &SymbolParser::FunctionSymbol::hasEH,
+    &SymbolParser::FunctionSymbol::hasSEH,
+    &SymbolParser::FunctionSymbol::hasNaked,
+    &SymbolParser::FunctionSymbol::hasSecurityChecks,
+    &SymbolParser::FunctionSymbol::hasAsyncEH,
+    &SymbolParser::FunctionSymbol::hasWasInlined,
+    &SymbolParser::FunctionSymbol::hasGSCheck,
+    &SymbolParser::FunctionSymbol::hasSafeBuffers,
+    &SymbolParser::FunctionSymbol::hasOptSpeed,
+    &SymbolParser::FunctionSymbol::hasGuardCF};
+
+static_assert(std::size(SymbolIndexFlags) <= 16u, "The flags of a record are 16 bits.");
+
+// Get the path of the index, it isn't named "llvmcache-*" so pruneCache keeps it in a shared directory
+static std::string
+GetSymbolIndexPath(StringRef directory, const PDB::Header &header)
+{
+    SmallString<128> path(directory);
+    sys::path::append(
+        path,
+        "pdbindex-" + toHex(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(&header.guid), sizeof(PDB::GUID))) +
+            "-" + utostr(header.age));
+    return std::string(path.str());
+}
+
+// Write the header of the index
+static void
+WriteSymbolIndexHeader(char *data, const PDB::Header &header, uint32_t symbolCount, uint32_t stringTableSize)
+{
+    using namespace support::endian;
+
+    std::memcpy(data, SymbolIndexMagic, sizeof(SymbolIndexMagic));
+    write32le(data + 8, SymbolIndexVersion);
+    std::memcpy(data + 12, &header.guid, sizeof(PDB::GUID));
+    write32le(data + 28, header.age);
+    write32le(data + 32, symbolCount);
+    write32le(data + 36, stringTableSize);
+}
+
+// Read the symbols from the index, false if it is missing or it is not the index of the PDB
+static bool
+ReadSymbolIndex(StringRef path, const PDB::Header &header, std::vector<SymbolParser::FunctionSymbol> &functionSymbols)
+{
+    using namespace support::endian;
+
+    auto bufferOrErr = MemoryBuffer::getFile(path, -1, false);
+    if (!bufferOrErr)
+    {
+        return false;
+    }
+
+    StringRef data = (*bufferOrErr)->getBuffer();
+    if (data.size() < SymbolIndexHeaderSize)
+    {
+        return false;
+    }
+
+    const uint32_t symbolCount = read32le(data.data() + 32);
+    const uint32_t stringTableSize = read32le(data.data() + 36);
+    char expectedHeader[SymbolIndexHeaderSize];
+    WriteSymbolIndexHeader(expectedHeader, header, symbolCount, stringTableSize);
+    if (std::memcmp(data.data(), expectedHeader, SymbolIndexHeaderSize) != 0 ||
+        data.size() != SymbolIndexHeaderSize + uint64_t(symbolCount) * SymbolIndexRecordSize + stringTableSize)
+    {
+        return false;
+    }
+
+    StringRef strings = data.take_back(stringTableSize);
+    auto readString = [&strings](const char *record, std::string &str) {
+        const uint32_t offset = read32le(record);
+        const uint32_t size = read32le(record + 4);
+        if (offset > strings.size() || size > strings.size() - offset)
+        {
+            return false;
+        }
+
+        str.assign(strings.data() + offset, size);
+        return true;
+    };
+
+    std::vector<SymbolParser::FunctionSymbol> symbols(symbolCount);
+    const char *record = data.data() + SymbolIndexHeaderSize;
+    for (SymbolParser::FunctionSymbol &symbol : symbols)
+    {
+        if (!readString(record, symbol.name) || !readString(record + 8, symbol.internal_name))
+        {
+            return false;
+        }
+
+        symbol.rva = read32le(record + 16);
+        symbol.size = read32le(record + 20);
+        symbol.cbFrame = read32le(record + 24);
+        symbol.cbPad = read32le(record + 28);
+        symbol.offPad = read32le(record + 32);
+        symbol.cbSaveRegs = read32le(record + 36);
+        symbol.offExHdlr = read32le(record + 40);
+        symbol.sectExHdlr = read16le(record + 44);
+
+        const uint16_t flags = read16le(record + 46);
+        for (size_t i = 0u; i < std::size(SymbolIndexFlags); ++i)
+        {
+            symbol.*SymbolIndexFlags[i] = (flags >> i) & 1u;
+        }
+
+        record += SymbolIndexRecordSize;
+    }
+
+    std::swap(functionSymbols, symbols);
+    return true;
+}
+
+// Write the symbols into the index next to the other cached indexes
+static bool
+WriteSymbolIndex(
+    StringRef path,
+    const PDB::Header &header,
+    const std::vector<SymbolParser::FunctionSymbol> &functionSymbols)
+{
+    using namespace support::endian;
+
+    // the internal name is usually the name, it is stored once
+    std::string strings;
+    std::vector<char> records(functionSymbols.size() * SymbolIndexRecordSize);
+    char *record = records.data();
+    for (const SymbolParser::FunctionSymbol &symbol : functionSymbols)
+    {
+        write32le(record, static_cast<uint32_t>(strings.size()));
+        write32le(record + 4, static_cast<uint32_t>(symbol.name.size()));
+        strings += symbol.name;
+        if (symbol.internal_name == symbol.name)
+        {
+            write32le(record + 8, read32le(record));
+        }
+        else
+        {
+            write32le(record + 8, static_cast<uint32_t>(strings.size()));
+            strings += symbol.internal_name;
+        }
+        write32le(record + 12, static_cast<uint32_t>(symbol.internal_name.size()));
+
+        write32le(record + 16, symbol.rva);
+        write32le(record + 20, symbol.size);
+        write32le(record + 24, symbol.cbFrame);
+        write32le(record + 28, symbol.cbPad);
+        write32le(record + 32, symbol.offPad);
+        write32le(record + 36, symbol.cbSaveRegs);
+        write32le(record + 40, symbol.offExHdlr);
+        write16le(record + 44, symbol.sectExHdlr);
+
+        uint16_t flags = 0u;
+        for (size_t i = 0u; i < std::size(SymbolIndexFlags); ++i)
+        {
+            flags |= (symbol.*SymbolIndexFlags[i] ? 1u : 0u) << i;
+        }
+        write16le(record + 46, flags);
+
+        record += SymbolIndexRecordSize;
+    }
+
+    char indexHeader[SymbolIndexHeaderSize];
+    WriteSymbolIndexHeader(
+        indexHeader, header, static_cast<uint32_t>(functionSymbols.size()), static_cast<uint32_t>(strings.size()));
+
+    StringRef directory = sys::path::parent_path(path);
+    if (sys::fs::create_directories(directory))
+    {
+        return false;
+    }
+
+    SmallString<128> tempModel(directory);
+    sys::path::append(tempModel, "tmp-pdb-%%%%%%");
+    return writeFileAtomically(tempModel, path, [&](raw_ostream &os) {
+        os.write(indexHeader, SymbolIndexHeaderSize);
+        os.write(records.data(), records.size());
+        os << strings;
+        return true;
+    });
+}
 } // namespace
 
-class SymbolParserByPDB : public SymbolParser
+////////////////////////////////////////////////////////////////////////////////////////
+//// SymbolParser
+// Lookup
+// Open the symbol file for the lookups, the function symbols are parsed and the lookups search them
+bool
+SymbolParser::OpenFunctionSymbols(StringRef SymFilePath)
 {
-public:
-    SymbolParserByPDB() : SymbolParser() {}
-    ~SymbolParserByPDB() = default;
+    return ParseFunctionSymbols(SymFilePath);
+}
 
-private:
-    void ExampleFunctionSymbols(const PDB::RawFile &rawPdbFile, const PDB::DBIStream &dbiStream)
+// Find the function symbol beginning at the RVA
+std::optional<SymbolParser::FunctionSymbolRef>
+SymbolParser::FindFunctionSymbolByRVA(uint32_t RVA)
+{
+    for (auto &Symbol : mFunctionSymbols)
     {
-        const PDB::ImageSectionStream imageSectionStream = dbiStream.CreateImageSectionStream(rawPdbFile);
+        if (Symbol.rva == RVA)
+        {
+            return FunctionSymbolRef{Symbol.name, Symbol.rva, Symbol.size};
+        }
+    }
 
-        // prepare the module info stream for grabbing function symbols from modules
-        const PDB::ModuleInfoStream moduleInfoStream = dbiStream.CreateModuleInfoStream(rawPdbFile);
+    return std::nullopt;
+}
 
-        // prepare symbol record stream needed by the public stream
-        const PDB::CoalescedMSFStream symbolRecordStream = dbiStream.CreateSymbolRecordStream(rawPdbFile);
+// Find the function symbol by name
+std::optional<SymbolParser::FunctionSymbolRef>
+SymbolParser::FindFunctionSymbolByName(StringRef Name)
+{
+    for (auto &Symbol : mFunctionSymbols)
+    {
+        if (Symbol.name == Name)
+        {
+            return FunctionSymbolRef{Symbol.name, Symbol.rva, Symbol.size};
+        }
+    }
 
-        // note that we only use unordered_set in order to keep the example code easy to understand.
-        // using other hash set implementations like e.g. abseil's Swiss Tables
-        // (https://abseil.io/about/design/swisstables) is *much* faster.
-        std::vector<FunctionSymbol> functionSymbols;
-        std::unordered_set<uint32_t> seenFunctionRVAs;
+    return std::nullopt;
+}
 
-        // start by reading the module stream, grabbing every function symbol we can find.
-        // in most cases, this gives us ~90% of all function symbols already, along with their size.
+// Visit the function symbols beginning in [BeginRVA, EndRVA), in the order of their RVA
+void
+SymbolParser::ForEachFunctionSymbolInRange(
+    uint32_t BeginRVA,
+    uint32_t EndRVA,
+    function_ref<void(const FunctionSymbolRef &)> Callback)
+{
+    std::vector<FunctionSymbolRef> Symbols;
+    for (auto &Symbol : mFunctionSymbols)
+    {
+        if (Symbol.rva >= BeginRVA && Symbol.rva < EndRVA)
         {
-            const PDB::ArrayView<PDB::ModuleInfoStream::Module> modules = moduleInfoStream.GetModules();
+            Symbols.push_back(FunctionSymbolRef{Symbol.name, Symbol.rva, Symbol.size});
+        }
+    }
+
+    std::stable_sort(Symbols.begin(), Symbols.end(), [](const FunctionSymbolRef &LHS, const FunctionSymbolRef &RHS) {
+        return LHS.rva < RHS.rva;
+    });
+    for (auto &Symbol : Symbols)
+    {
+        Callback(Symbol);
+    }
+}
+
+class SymbolParserByPDB : public SymbolParser
+{
+public:
+    SymbolParserByPDB() : SymbolParser() {}
+    ~SymbolParserByPDB() = default;
 
-            for (const PDB::ModuleInfoStream::Module &module : modules)
+private:
+    // Grab the function symbols of a module symbol stream, in the order of the stream
+    static void ExampleModuleFunctionSymbols(
+        const PDB::RawFile &rawPdbFile,
+        const PDB::ImageSectionStream &imageSectionStream,
+        const PDB::ModuleInfoStream::Module &module,
+        std::vector<FunctionSymbol> &functionSymbols)
+    {
+        const PDB::ModuleSymbolStream moduleSymbolStream = module.CreateSymbolStream(rawPdbFile);
+        moduleSymbolStream.ForEachSymbol([&functionSymbols,
+                                          &imageSectionStream](const PDB::CodeView::DBI::Record *record) {
+            // only grab function symbols from the module streams
+            const char *name = nullptr;
+            uint32_t rva = 0u;
+            uint32_t size = 0u;
+            if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_FRAMEPROC)
             {
-                if (!module.HasSymbolStream())
+                // the frame of the last function of this module
+                if (functionSymbols.empty())
                 {
-                    continue;
+                    return;
                 }
 
-                const PDB::ModuleSymbolStream moduleSymbolStream = module.CreateSymbolStream(rawPdbFile);
-                moduleSymbolStream.ForEachSymbol([&functionSymbols, &seenFunctionRVAs, &imageSectionStream](
-                                                     const PDB::CodeView::DBI::Record *record) {
-                    // only grab function symbols from the module streams
-                    const char *name = nullptr;
-                    uint32_t rva = 0u;
-                    uint32_t size = 0u;
-                    if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_FRAMEPROC)
-                    {
-                        // functionSymbols[functionSymbols.size() - 1].frameProc = record;
-                        functionSymbols[functionSymbols.size() - 1].cbFrame = record->data.S_FRAMEPROC.cbFrame;
-                        functionSymbols[functionSymbols.size() - 1].cbPad = record->data.S_FRAMEPROC.cbPad;
-                        functionSymbols[functionSymbols.size() - 1].offPad = record->data.S_FRAMEPROC.offPad;
-                        functionSymbols[functionSymbols.size() - 1].cbSaveRegs = record->data.S_FRAMEPROC.cbSaveRegs;
-                        functionSymbols[functionSymbols.size() - 1].offExHdlr = record->data.S_FRAMEPROC.offExHdlr;
-                        functionSymbols[functionSymbols.size() - 1].sectExHdlr = record->data.S_FRAMEPROC.sectExHdlr;
+                FunctionSymbol &lastSymbol = functionSymbols.back();
+                lastSymbol.cbFrame = record->data.S_FRAMEPROC.cbFrame;
+                lastSymbol.cbPad = record->data.S_FRAMEPROC.cbPad;
+                lastSymbol.offPad = record->data.S_FRAMEPROC.offPad;
+                lastSymbol.cbSaveRegs = record->data.S_FRAMEPROC.cbSaveRegs;
+                lastSymbol.offExHdlr = record->data.S_FRAMEPROC.offExHdlr;
+                lastSymbol.sectExHdlr = record->data.S_FRAMEPROC.sectExHdlr;
+
+                lastSymbol.hasAlloca = record->data.S_FRAMEPROC.flags.fHasAlloca ? true : false;
+                lastSymbol.hasSetJmp = record->data.S_FRAMEPROC.flags.fHasSetJmp ? true : false;
+                lastSymbol.hasLongJmp = record->data.S_FRAMEPROC.flags.fHasLongJmp ? true : false;
+                lastSymbol.hasInlAsm = record->data.S_FRAMEPROC.flags.fHasInlAsm ? true : false;
+                lastSymbol.hasEH = record->data.S_FRAMEPROC.flags.fHasEH ? true : false;
+                lastSymbol.hasSEH = record->data.S_FRAMEPROC.flags.fHasSEH ? true : false;
+                lastSymbol.hasNaked = record->data.S_FRAMEPROC.flags.fNaked ? true : false;
+                lastSymbol.hasSecurityChecks = record->data.S_FRAMEPROC.flags.fSecurityChecks ? true : false;
+                lastSymbol.hasAsyncEH = record->data.S_FRAMEPROC.flags.fAsyncEH ? true : false;
+                lastSymbol.hasWasInlined = record->data.S_FRAMEPROC.flags.fWasInlined ? true : false;
+                lastSymbol.hasGSCheck = record->data.S_FRAMEPROC.flags.fGSCheck ? true : false;
+                lastSymbol.hasSafeBuffers = record->data.S_FRAMEPROC.flags.fSafeBuffers ? true : false;
+                lastSymbol.hasOptSpeed = record->data.S_FRAMEPROC.flags.fOptSpeed ? true : false;
+                lastSymbol.hasGuardCF = record->data.S_FRAMEPROC.flags.fGuardCF ? true : false;
+                return;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_THUNK32)
+            {
+                if (record->data.S_THUNK32.thunk == PDB::CodeView::DBI::ThunkOrdinal::TrampolineIncremental)
+                {
+                    // we have never seen incremental linking thunks stored inside a S_THUNK32 symbol, but
+                    // better safe than sorry
+                    name = "ILT";
+                    rva = imageSectionStream.ConvertSectionOffsetToRVA(
+                        record->data.S_THUNK32.section, record->data.S_THUNK32.offset);
+                    size = 5u;
+                }
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_TRAMPOLINE)
+            {
+                // incremental linking thunks are stored in the linker module
+                name = "ILT";
+                rva = imageSectionStream.ConvertSectionOffsetToRVA(
+                    record->data.S_TRAMPOLINE.thunkSection, record->data.S_TRAMPOLINE.thunkOffset);
+                size = 5u;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_LPROC32)
+            {
+                name = record->data.S_LPROC32.name;
+                rva = imageSectionStream.ConvertSectionOffsetToRVA(
+                    record->data.S_LPROC32.section, record->data.S_LPROC32.offset);
+                size = record->data.S_LPROC32.codeSize;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_GPROC32)
+            {
+                name = record->data.S_GPROC32.name;
+                rva = imageSectionStream.ConvertSectionOffsetToRVA(
+                    record->data.S_GPROC32.section, record->data.S_GPROC32.offset);
+                size = record->data.S_GPROC32.codeSize;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_LPROC32_ID)
+            {
+                name = record->data.S_LPROC32_ID.name;
+                rva = imageSectionStream.ConvertSectionOffsetToRVA(
+                    record->data.S_LPROC32_ID.section, record->data.S_LPROC32_ID.offset);
+                size = record->data.S_LPROC32_ID.codeSize;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_GPROC32_ID)
+            {
+                name = record->data.S_GPROC32_ID.name;
+                rva = imageSectionStream.ConvertSectionOffsetToRVA(
+                    record->data.S_GPROC32_ID.section, record->data.S_GPROC32_ID.offset);
+                size = record->data.S_GPROC32_ID.codeSize;
+            }
 
-                        functionSymbols[functionSymbols.size() - 1].hasAlloca =
-                            record->data.S_FRAMEPROC.flags.fHasAlloca ? true : false;
+            if (rva == 0u)
+            {
+                return;
+            }
 
-                        functionSymbols[functionSymbols.size() - 1].hasSetJmp =
-                            record->data.S_FRAMEPROC.flags.fHasSetJmp ? true : false;
+            if (size == 0u)
+            {
+                return;
+            }
 
-                        functionSymbols[functionSymbols.size() - 1].hasLongJmp =
-                            record->data.S_FRAMEPROC.flags.fHasLongJmp ? true : false;
+            functionSymbols.push_back(FunctionSymbol{name, name, rva, size});
+        });
+    }
 
-                        functionSymbols[functionSymbols.size() - 1].hasInlAsm =
-                            record->data.S_FRAMEPROC.flags.fHasInlAsm ? true : false;
+    // Convert the RVA into a one-based section offset, false if it is not in a section.
+    // In that case it is the section offset of the next section, the sections are in the order of their RVA.
+    static bool
+    ConvertRVAToSectionOffset(const PDB::ImageSectionStream &imageSectionStream, uint32_t rva, uint16_t &section, uint32_t &offset)
+    {
+        const PDB::ArrayView<PDB::IMAGE_SECTION_HEADER> imageSections = imageSectionStream.GetImageSections();
+        for (size_t i = 0u; i < imageSections.GetLength(); ++i)
+        {
+            const PDB::IMAGE_SECTION_HEADER &imageSection = imageSections[i];
+            const uint32_t sectionSize = std::max(imageSection.Misc.VirtualSize, imageSection.SizeOfRawData);
+            section = static_cast<uint16_t>(i + 1u);
+            offset = 0u;
+            if (rva < imageSection.VirtualAddress)
+            {
+                return false;
+            }
 
-                        functionSymbols[functionSymbols.size() - 1].hasEH =
-                            record->data.S_FRAMEPROC.flags.fHasEH ? true : false;
+            if (rva - imageSection.VirtualAddress < sectionSize)
+            {
+                offset = rva - imageSection.VirtualAddress;
+                return true;
+            }
+        }
 
-                        functionSymbols[functionSymbols.size() - 1].hasSEH =
-                            record->data.S_FRAMEPROC.flags.fHasSEH ? true : false;
+        section = static_cast<uint16_t>(imageSections.GetLength() + 1u);
+        offset = 0u;
+        return false;
+    }
 
-                        functionSymbols[functionSymbols.size() - 1].hasNaked =
-                            record->data.S_FRAMEPROC.flags.fNaked ? true : false;
+    // Find the section contribution beginning at the RVA, the contributions are sorted by section and offset
+    static const PDB::DBI::SectionContribution *FindSectionContribution(
+        const PDB::ImageSectionStream &imageSectionStream,
+        const PDB::ArrayView<PDB::DBI::SectionContribution> &sectionContributions,
+        uint32_t rva)
+    {
+        uint16_t section = 0u;
+        uint32_t offset = 0u;
+        if (!ConvertRVAToSectionOffset(imageSectionStream, rva, section, offset))
+        {
+            return nullptr;
+        }
 
-                        functionSymbols[functionSymbols.size() - 1].hasSecurityChecks =
-                            record->data.S_FRAMEPROC.flags.fSecurityChecks ? true : false;
+        const PDB::DBI::SectionContribution *contribution = std::lower_bound(
+            sectionContributions.begin(),
+            sectionContributions.end(),
+            std::make_pair(section, offset),
+            [](const PDB::DBI::SectionContribution &lhs, const std::pair<uint16_t, uint32_t> &key) {
+                return std::make_pair(lhs.section, lhs.offset) < key;
+            });
+        if (contribution == sectionContributions.end() || contribution->section != section ||
+            contribution->offset != offset)
+        {
+            return nullptr;
+        }
 
-                        functionSymbols[functionSymbols.size() - 1].hasAsyncEH =
-                            record->data.S_FRAMEPROC.flags.fAsyncEH ? true : false;
+        return contribution;
+    }
 
-                        functionSymbols[functionSymbols.size() - 1].hasWasInlined =
-                            record->data.S_FRAMEPROC.flags.fWasInlined ? true : false;
+    void ExampleFunctionSymbols(const PDB::RawFile &rawPdbFile, const PDB::DBIStream &dbiStream)
+    {
+        const PDB::ImageSectionStream imageSectionStream = dbiStream.CreateImageSectionStream(rawPdbFile);
 
-                        functionSymbols[functionSymbols.size() - 1].hasGSCheck =
-                            record->data.S_FRAMEPROC.flags.fGSCheck ? true : false;
+        // prepare the module info stream for grabbing function symbols from modules
+        const PDB::ModuleInfoStream moduleInfoStream = dbiStream.CreateModuleInfoStream(rawPdbFile);
 
-                        functionSymbols[functionSymbols.size() - 1].hasSafeBuffers =
-                            record->data.S_FRAMEPROC.flags.fSafeBuffers ? true : false;
+        // prepare symbol record stream needed by the public stream
+        const PDB::RecordMSFStream symbolRecordStream = dbiStream.CreateSymbolRecordStream(rawPdbFile);
 
-                        functionSymbols[functionSymbols.size() - 1].hasOptSpeed =
-                            record->data.S_FRAMEPROC.flags.fOptSpeed ? true : false;
+        std::vector<FunctionSymbol> functionSymbols;
 
-                        functionSymbols[functionSymbols.size() - 1].hasGuardCF =
-                            record->data.S_FRAMEPROC.flags.fGuardCF ? true : false;
-                        return;
-                    }
-                    else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_THUNK32)
-                    {
-                        if (record->data.S_THUNK32.thunk == PDB::CodeView::DBI::ThunkOrdinal::TrampolineIncremental)
-                        {
-                            // we have never seen incremental linking thunks stored inside a S_THUNK32 symbol, but
-                            // better safe than sorry
-                            name = "ILT";
-                            rva = imageSectionStream.ConvertSectionOffsetToRVA(
-                                record->data.S_THUNK32.section, record->data.S_THUNK32.offset);
-                            size = 5u;
-                        }
-                    }
-                    else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_TRAMPOLINE)
-                    {
-                        // incremental linking thunks are stored in the linker module
-                        name = "ILT";
-                        rva = imageSectionStream.ConvertSectionOffsetToRVA(
-                            record->data.S_TRAMPOLINE.thunkSection, record->data.S_TRAMPOLINE.thunkOffset);
-                        size = 5u;
-                    }
-                    else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_LPROC32)
-                    {
-                        name = record->data.S_LPROC32.name;
-                        rva = imageSectionStream.ConvertSectionOffsetToRVA(
-                            record->data.S_LPROC32.section, record->data.S_LPROC32.offset);
-                        size = record->data.S_LPROC32.codeSize;
-                    }
-                    else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_GPROC32)
-                    {
-                        name = record->data.S_GPROC32.name;
-                        rva = imageSectionStream.ConvertSectionOffsetToRVA(
-                            record->data.S_GPROC32.section, record->data.S_GPROC32.offset);
-                        size = record->data.S_GPROC32.codeSize;
-                    }
-                    else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_LPROC32_ID)
-                    {
-                        name = record->data.S_LPROC32_ID.name;
-                        rva = imageSectionStream.ConvertSectionOffsetToRVA(
-                            record->data.S_LPROC32_ID.section, record->data.S_LPROC32_ID.offset);
-                        size = record->data.S_LPROC32_ID.codeSize;
-                    }
-                    else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_GPROC32_ID)
-                    {
-                        name = record->data.S_GPROC32_ID.name;
-                        rva = imageSectionStream.ConvertSectionOffsetToRVA(
-                            record->data.S_GPROC32_ID.section, record->data.S_GPROC32_ID.offset);
-                        size = record->data.S_GPROC32_ID.codeSize;
-                    }
+        // start by reading the module stream, grabbing every function symbol we can find.
+        // in most cases, this gives us ~90% of all function symbols already, along with their size.
+        // the module streams are independent, they are scanned concurrently and merged in the order of the modules.
+        {
+            const PDB::ArrayView<PDB::ModuleInfoStream::Module> modules = moduleInfoStream.GetModules();
 
-                    if (rva == 0u)
+            std::vector<std::vector<FunctionSymbol>> moduleFunctionSymbols(modules.GetLength());
+            {
+                ThreadPool Pool(std::max(1u, hardware_concurrency()));
+                for (size_t i = 0u; i < modules.GetLength(); ++i)
+                {
+                    if (!modules[i].HasSymbolStream())
                     {
-                        return;
+                        continue;
                     }
 
-                    if (size == 0u)
-                    {
-                        return;
-                    }
+                    Pool.async([&, i]() {
+                        ExampleModuleFunctionSymbols(
+                            rawPdbFile, imageSectionStream, modules[i], moduleFunctionSymbols[i]);
+                    });
+                }
+                Pool.wait();
+            }
 
-                    functionSymbols.push_back(FunctionSymbol{name, name, rva, size});
-                    seenFunctionRVAs.emplace(rva);
-                });
+            size_t symbolCount = 0u;
+            for (const std::vector<FunctionSymbol> &symbols : moduleFunctionSymbols)
+            {
+                symbolCount += symbols.size();
+            }
+
+            functionSymbols.reserve(symbolCount);
+            for (std::vector<FunctionSymbol> &symbols : moduleFunctionSymbols)
+            {
+                std::move(symbols.begin(), symbols.end(), std::back_inserter(functionSymbols));
             }
         }
 
@@ -250,12 +583,13 @@ private:
         // function symbols we haven't seen yet in any of the modules, especially for PDBs that don't provide
         // module-specific information.
 
-        // read public symbols
-        std::vector<FunctionSymbol> publicSymbols;
+        // read public symbols, the names point into the mapped file.
+        // the last public function symbol at an RVA wins.
+        DenseMap<uint32_t, const char *> publicNames;
         const PDB::PublicSymbolStream publicSymbolStream = dbiStream.CreatePublicSymbolStream(rawPdbFile);
         {
             const PDB::ArrayView<PDB::HashRecord> hashRecords = publicSymbolStream.GetRecords();
-            const size_t count = hashRecords.GetLength();
+            publicNames.reserve(hashRecords.GetLength());
 
             for (const PDB::HashRecord &hashRecord : hashRecords)
             {
@@ -275,17 +609,12 @@ private:
                     continue;
                 }
 
-                // this is a new function symbol, so store it.
-                // note that we don't know its size yet.
-                publicSymbols.push_back(FunctionSymbol{record->data.S_PUB32.name, record->data.S_PUB32.name, rva, 0u});
+                publicNames[rva] = record->data.S_PUB32.name;
             }
         }
 
-        // we still need to find the size of the public function symbols.
-        // this can be deduced by sorting the symbols by their RVA, and then computing the distance between the current
-        // and the next symbol. this works since functions are always mapped to executable pages, so they aren't
-        // interleaved by any data symbols.
-        std::sort(
+        // sort the symbols by their RVA, the symbols at the same RVA keep the order of the modules
+        std::stable_sort(
             functionSymbols.begin(), functionSymbols.end(), [](const FunctionSymbol &lhs, const FunctionSymbol &rhs) {
                 return lhs.rva < rhs.rva;
             });
@@ -293,75 +622,33 @@ private:
         const size_t symbolCount = functionSymbols.size();
         if (symbolCount != 0u)
         {
-            size_t foundCount = 0u;
-
-            // we have at least 1 symbol.
-            // compute missing symbol sizes by computing the distance from this symbol to the next.
-            // note that this includes "int 3" padding after the end of a function. if you don't want that, but the
-            // actual number of bytes of the function's code, your best bet is to use a disassembler instead.
-            for (size_t i = 0u; i < symbolCount - 1u; ++i)
-            {
-                FunctionSymbol &currentSymbol = functionSymbols[i];
-                if (currentSymbol.size != 0u)
-                {
-                    // the symbol's size is already known
-                    continue;
-                }
-
-                const FunctionSymbol &nextSymbol = functionSymbols[i + 1u];
-                const size_t size = nextSymbol.rva - currentSymbol.rva;
-                (void)size; // unused
-                ++foundCount;
-            }
-
-            // we know have the sizes of all symbols, except the last.
-            // this can be found by going through the contributions, if needed.
+            // the size of the last symbol is taken from the contributions
             FunctionSymbol &lastSymbol = functionSymbols[symbolCount - 1u];
             if (lastSymbol.size != 0u)
             {
-                // bad luck, we can't deduce the last symbol's size, so have to consult the contributions instead.
-                // we do a linear search in this case to keep the code simple.
                 const PDB::SectionContributionStream sectionContributionStream =
                     dbiStream.CreateSectionContributionStream(rawPdbFile);
-                const PDB::ArrayView<PDB::DBI::SectionContribution> sectionContributions =
-                    sectionContributionStream.GetContributions();
-                for (const PDB::DBI::SectionContribution &contribution : sectionContributions)
+                const PDB::DBI::SectionContribution *contribution = FindSectionContribution(
+                    imageSectionStream, sectionContributionStream.GetContributions(), lastSymbol.rva);
+                if (contribution)
                 {
-                    const uint32_t rva =
-                        imageSectionStream.ConvertSectionOffsetToRVA(contribution.section, contribution.offset);
-                    if (rva == 0u)
-                    {
-                        printf("Contribution has invalid RVA\n");
-                        continue;
-                    }
-
-                    if (rva == lastSymbol.rva)
-                    {
-                        lastSymbol.size = contribution.size;
-                        break;
-                    }
-
-                    if (rva > lastSymbol.rva)
-                    {
-                        // should have found the contribution by now
-                        printf(
-                            "Unknown contribution for symbol %s at RVA 0x%X", lastSymbol.name.c_str(), lastSymbol.rva);
-                        break;
-                    }
+                    lastSymbol.size = contribution->size;
+                }
+                else
+                {
+                    printf("Unknown contribution for symbol %s at RVA 0x%X", lastSymbol.name.c_str(), lastSymbol.rva);
                 }
             }
         }
 
         if (!functionSymbols.empty())
         {
-            for (auto &functionItem : functionSymbols)
+            for (FunctionSymbol &functionItem : functionSymbols)
             {
-                for (auto &publicItem : publicSymbols)
+                auto It = publicNames.find(functionItem.rva);
+                if (It != publicNames.end())
                 {
-                    if (functionItem.rva == publicItem.rva)
-                    {
-                        functionItem.name = publicItem.name;
-                    }
+                    functionItem.name = It->second;
                 }
             }
 
@@ -410,7 +697,19 @@ public:
             return false;
         }
 
+        // the symbols of a PDB that is parsed before are read from the index
         const auto h = infoStream.GetHeader();
+        std::string indexPath;
+        if (!mIndexCacheDirectory.empty())
+        {
+            indexPath = GetSymbolIndexPath(mIndexCacheDirectory, *h);
+            if (ReadSymbolIndex(indexPath, *h, mFunctionSymbols))
+            {
+                MemoryMappedFile::Close(pdbFile);
+                return true;
+            }
+        }
+
         const PDB::DBIStream dbiStream = PDB::CreateDBIStream(rawPdbFile);
         if (!HasValidDBIStreams(rawPdbFile, dbiStream))
         {
@@ -427,14 +726,408 @@ public:
 
         ExampleFunctionSymbols(rawPdbFile, dbiStream);
 
+        if (!indexPath.empty() && !WriteSymbolIndex(indexPath, *h, mFunctionSymbols))
+        {
+            printf("Failed to write the symbol index %s\n", indexPath.c_str());
+        }
+
         MemoryMappedFile::Close(pdbFile);
 
         return true;
     }
+
+public:
+    // Lookup
+    // Open the PDB for the lookups, only the public symbol, section contribution, symbol record and module info
+    // streams are read
+    virtual bool OpenFunctionSymbols(StringRef SymFilePath) override
+    {
+        mLookupStreams.reset();
+
+        MemoryMappedFile::Handle pdbFile = MemoryMappedFile::Open(SymFilePath.data());
+        if (!pdbFile.baseAddress)
+        {
+            return false;
+        }
+
+        if (IsError(PDB::ValidateFile(pdbFile.baseAddress)))
+        {
+            MemoryMappedFile::Close(pdbFile);
+            return false;
+        }
+
+        PDB::RawFile rawPdbFile = PDB::CreateRawFile(pdbFile.baseAddress);
+        if (IsError(PDB::HasValidDBIStream(rawPdbFile)))
+        {
+            MemoryMappedFile::Close(pdbFile);
+            return false;
+        }
+
+        const PDB::DBIStream dbiStream = PDB::CreateDBIStream(rawPdbFile);
+        if (!HasValidDBIStreams(rawPdbFile, dbiStream))
+        {
+            MemoryMappedFile::Close(pdbFile);
+            return false;
+        }
+
+        mLookupStreams = std::make_unique<LookupStreams>(pdbFile, std::move(rawPdbFile), dbiStream);
+        return true;
+    }
+
+    // Find the function symbol beginning at the RVA, the public symbols are preferred to the module ones
+    virtual std::optional<FunctionSymbolRef> FindFunctionSymbolByRVA(uint32_t RVA) override
+    {
+        if (!mLookupStreams)
+        {
+            return SymbolParser::FindFunctionSymbolByRVA(RVA);
+        }
+
+        uint16_t section = 0u;
+        uint32_t offset = 0u;
+        if (!ConvertRVAToSectionOffset(mLookupStreams->imageSectionStream, RVA, section, offset))
+        {
+            return std::nullopt;
+        }
+
+        const PDB::ArrayView<uint32_t> addressMap = mLookupStreams->publicSymbolStream.GetAddressMap();
+        for (size_t i = LowerBoundAddressMap(section, offset); i < addressMap.GetLength(); ++i)
+        {
+            const PDB::CodeView::DBI::Record *record = GetAddressMapRecord(i);
+            if (!record || record->data.S_PUB32.section != section || record->data.S_PUB32.offset != offset)
+            {
+                break;
+            }
+
+            if (IsFunctionRecord(record))
+            {
+                return MakeFunctionSymbolRef(record, RVA, i);
+            }
+        }
+
+        // the static functions have no public symbol, they are only in the module streams
+        return FindProcSymbol(section, offset);
+    }
+
+    // Find the function symbol by name, the hash bucket of the public symbols is searched before the module streams
+    virtual std::optional<FunctionSymbolRef> FindFunctionSymbolByName(StringRef Name) override
+    {
+        if (!mLookupStreams)
+        {
+            return SymbolParser::FindFunctionSymbolByName(Name);
+        }
+
+        const PDB::ArrayView<PDB::HashRecord> hashRecords =
+            mLookupStreams->publicSymbolStream.GetRecordsInBucket(Name.data(), Name.size());
+        for (const PDB::HashRecord &hashRecord : hashRecords)
+        {
+            const PDB::CodeView::DBI::Record *record =
+                mLookupStreams->publicSymbolStream.GetRecord(mLookupStreams->symbolRecordStream, hashRecord);
+            if (!record || !IsFunctionRecord(record) || Name != StringRef(record->data.S_PUB32.name))
+            {
+                continue;
+            }
+
+            const uint32_t rva = mLookupStreams->imageSectionStream.ConvertSectionOffsetToRVA(
+                record->data.S_PUB32.section, record->data.S_PUB32.offset);
+            if (rva == 0u)
+            {
+                continue;
+            }
+
+            // the size is found by the address of the record
+            const size_t index = LowerBoundAddressMap(record->data.S_PUB32.section, record->data.S_PUB32.offset);
+            return MakeFunctionSymbolRef(record, rva, index);
+        }
+
+        // the static functions have no public symbol, every module stream is searched for them
+        std::optional<FunctionSymbolRef> symbol;
+        const PDB::ArrayView<PDB::ModuleInfoStream::Module> modules = mLookupStreams->moduleInfoStream.GetModules();
+        for (size_t i = 0u; i < modules.GetLength() && !symbol; ++i)
+        {
+            ForEachProcSymbol(i, [&symbol, Name](const FunctionSymbolRef &procSymbol, uint16_t, uint32_t) {
+                if (!symbol && procSymbol.name == Name)
+                {
+                    symbol = procSymbol;
+                }
+            });
+        }
+
+        return symbol;
+    }
+
+    // Visit the public function symbols beginning in [BeginRVA, EndRVA), the address map is in the order of the RVA
+    virtual void ForEachFunctionSymbolInRange(
+        uint32_t BeginRVA,
+        uint32_t EndRVA,
+        function_ref<void(const FunctionSymbolRef &)> Callback) override
+    {
+        if (!mLookupStreams)
+        {
+            SymbolParser::ForEachFunctionSymbolInRange(BeginRVA, EndRVA, Callback);
+            return;
+        }
+
+        uint16_t section = 0u;
+        uint32_t offset = 0u;
+        ConvertRVAToSectionOffset(mLookupStreams->imageSectionStream, BeginRVA, section, offset);
+
+        const PDB::ArrayView<uint32_t> addressMap = mLookupStreams->publicSymbolStream.GetAddressMap();
+        for (size_t i = LowerBoundAddressMap(section, offset); i < addressMap.GetLength(); ++i)
+        {
+            const PDB::CodeView::DBI::Record *record = GetAddressMapRecord(i);
+            if (!record)
+            {
+                continue;
+            }
+
+            const uint32_t rva = mLookupStreams->imageSectionStream.ConvertSectionOffsetToRVA(
+                record->data.S_PUB32.section, record->data.S_PUB32.offset);
+            if (rva == 0u || rva >= EndRVA)
+            {
+                // the records after the last section have no RVA
+                break;
+            }
+
+            if (IsFunctionRecord(record))
+            {
+                Callback(MakeFunctionSymbolRef(record, rva, i));
+            }
+        }
+    }
+
+private:
+    // Is the public symbol a function?
+    static bool IsFunctionRecord(const PDB::CodeView::DBI::Record *record)
+    {
+        return (PDB_AS_UNDERLYING(record->data.S_PUB32.flags) &
+                PDB_AS_UNDERLYING(PDB::CodeView::DBI::PublicSymbolFlags::Function)) != 0u;
+    }
+
+    // Get the public symbol of the address map, nullptr if it is malformed
+    const PDB::CodeView::DBI::Record *GetAddressMapRecord(size_t index) const
+    {
+        const PDB::ArrayView<uint32_t> addressMap = mLookupStreams->publicSymbolStream.GetAddressMap();
+        if (addressMap[index] >= mLookupStreams->symbolRecordStream.GetSize())
+        {
+            return nullptr;
+        }
+
+        return mLookupStreams->publicSymbolStream.GetRecord(mLookupStreams->symbolRecordStream, addressMap[index]);
+    }
+
+    // Get the index of the first public symbol of the address map at or after the section offset
+    size_t LowerBoundAddressMap(uint16_t section, uint32_t offset) const
+    {
+        const PDB::ArrayView<uint32_t> addressMap = mLookupStreams->publicSymbolStream.GetAddressMap();
+        size_t first = 0u;
+        size_t count = addressMap.GetLength();
+        while (count > 0u)
+        {
+            const size_t step = count / 2u;
+            const PDB::CodeView::DBI::Record *record = GetAddressMapRecord(first + step);
+            if (record && std::make_pair(record->data.S_PUB32.section, record->data.S_PUB32.offset) <
+                              std::make_pair(section, offset))
+            {
+                first += step + 1u;
+                count -= step + 1u;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        return first;
+    }
+
+    // Visit the procedure symbols of the module stream with their section offsets, the names point into the stream
+    template <typename F>
+    void ForEachProcSymbol(size_t moduleIndex, F &&Callback)
+    {
+        const PDB::ArrayView<PDB::ModuleInfoStream::Module> modules = mLookupStreams->moduleInfoStream.GetModules();
+        if (moduleIndex >= modules.GetLength() || !modules[moduleIndex].HasSymbolStream())
+        {
+            return;
+        }
+
+        // the module streams are read at the first lookup in them
+        std::optional<PDB::ModuleSymbolStream> &moduleSymbolStream = mLookupStreams->moduleSymbolStreams[moduleIndex];
+        if (!moduleSymbolStream)
+        {
+            moduleSymbolStream.emplace(modules[moduleIndex].CreateSymbolStream(mLookupStreams->rawPdbFile));
+        }
+
+        moduleSymbolStream->ForEachSymbol([this, &Callback](const PDB::CodeView::DBI::Record *record) {
+            FunctionSymbolRef symbol;
+            uint16_t section = 0u;
+            uint32_t offset = 0u;
+            if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_LPROC32)
+            {
+                symbol.name = record->data.S_LPROC32.name;
+                symbol.size = record->data.S_LPROC32.codeSize;
+                section = record->data.S_LPROC32.section;
+                offset = record->data.S_LPROC32.offset;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_GPROC32)
+            {
+                symbol.name = record->data.S_GPROC32.name;
+                symbol.size = record->data.S_GPROC32.codeSize;
+                section = record->data.S_GPROC32.section;
+                offset = record->data.S_GPROC32.offset;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_LPROC32_ID)
+            {
+                symbol.name = record->data.S_LPROC32_ID.name;
+                symbol.size = record->data.S_LPROC32_ID.codeSize;
+                section = record->data.S_LPROC32_ID.section;
+                offset = record->data.S_LPROC32_ID.offset;
+            }
+            else if (record->header.kind == PDB::CodeView::DBI::SymbolRecordKind::S_GPROC32_ID)
+            {
+                symbol.name = record->data.S_GPROC32_ID.name;
+                symbol.size = record->data.S_GPROC32_ID.codeSize;
+                section = record->data.S_GPROC32_ID.section;
+                offset = record->data.S_GPROC32_ID.offset;
+            }
+            else
+            {
+                return;
+            }
+
+            // the procedures without code are skipped like in the full parse
+            symbol.rva = mLookupStreams->imageSectionStream.ConvertSectionOffsetToRVA(section, offset);
+            if (symbol.rva == 0u || symbol.size == 0u)
+            {
+                return;
+            }
+
+            Callback(symbol, section, offset);
+        });
+    }
+
+    // Find the procedure symbol beginning at the section offset, only the module of the section contribution holding
+    // the offset is searched
+    std::optional<FunctionSymbolRef> FindProcSymbol(uint16_t section, uint32_t offset)
+    {
+        const PDB::ArrayView<PDB::DBI::SectionContribution> sectionContributions =
+            mLookupStreams->sectionContributionStream.GetContributions();
+        const PDB::DBI::SectionContribution *contribution = std::upper_bound(
+            sectionContributions.begin(),
+            sectionContributions.end(),
+            std::make_pair(section, offset),
+            [](const std::pair<uint16_t, uint32_t> &key, const PDB::DBI::SectionContribution &rhs) {
+                return key < std::make_pair(rhs.section, rhs.offset);
+            });
+        if (contribution == sectionContributions.begin())
+        {
+            return std::nullopt;
+        }
+
+        --contribution;
+        if (contribution->section != section || offset - contribution->offset >= contribution->size)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<FunctionSymbolRef> symbol;
+        ForEachProcSymbol(
+            contribution->moduleIndex,
+            [&symbol, section, offset](const FunctionSymbolRef &procSymbol, uint16_t procSection, uint32_t procOffset) {
+                if (!symbol && procSection == section && procOffset == offset)
+                {
+                    symbol = procSymbol;
+                }
+            });
+        return symbol;
+    }
+
+    // Make the function symbol of the public symbol at the index of the address map.
+    // The size is the one of its procedure symbol, its section contribution, or the distance to the next public
+    // function symbol.
+    FunctionSymbolRef MakeFunctionSymbolRef(const PDB::CodeView::DBI::Record *record, uint32_t rva, size_t index)
+    {
+        FunctionSymbolRef symbol;
+        symbol.name = record->data.S_PUB32.name;
+        symbol.rva = rva;
+
+        const std::optional<FunctionSymbolRef> procSymbol =
+            FindProcSymbol(record->data.S_PUB32.section, record->data.S_PUB32.offset);
+        if (procSymbol)
+        {
+            symbol.size = procSymbol->size;
+            return symbol;
+        }
+
+        const PDB::DBI::SectionContribution *contribution = FindSectionContribution(
+            mLookupStreams->imageSectionStream, mLookupStreams->sectionContributionStream.GetContributions(), rva);
+        if (contribution)
+        {
+            symbol.size = contribution->size;
+            return symbol;
+        }
+
+        const PDB::ArrayView<uint32_t> addressMap = mLookupStreams->publicSymbolStream.GetAddressMap();
+        for (size_t i = index + 1u; i < addressMap.GetLength(); ++i)
+        {
+            const PDB::CodeView::DBI::Record *nextRecord = GetAddressMapRecord(i);
+            if (!nextRecord)
+            {
+                continue;
+            }
+
+            if (nextRecord->data.S_PUB32.section != record->data.S_PUB32.section)
+            {
+                break;
+            }
+
+            if (IsFunctionRecord(nextRecord) && nextRecord->data.S_PUB32.offset > record->data.S_PUB32.offset)
+            {
+                symbol.size = nextRecord->data.S_PUB32.offset - record->data.S_PUB32.offset;
+                break;
+            }
+        }
+
+        return symbol;
+    }
+
+private:
+    // The streams of the PDB opened for the lookups, the names of the symbols point into them.
+    // The module symbol streams are created by the lookups needing them.
+    struct LookupStreams
+    {
+        MemoryMappedFile::Handle pdbFile;
+        PDB::RawFile rawPdbFile;
+        PDB::ImageSectionStream imageSectionStream;
+        PDB::RecordMSFStream symbolRecordStream;
+        PDB::PublicSymbolStream publicSymbolStream;
+        PDB::SectionContributionStream sectionContributionStream;
+        PDB::ModuleInfoStream moduleInfoStream;
+        std::vector<std::optional<PDB::ModuleSymbolStream>> moduleSymbolStreams;
+
+        LookupStreams(MemoryMappedFile::Handle pdbFile, PDB::RawFile &&rawPdbFile, const PDB::DBIStream &dbiStream) :
+            pdbFile(pdbFile),
+            rawPdbFile(std::move(rawPdbFile)),
+            imageSectionStream(dbiStream.CreateImageSectionStream(this->rawPdbFile)),
+            symbolRecordStream(dbiStream.CreateSymbolRecordStream(this->rawPdbFile)),
+            publicSymbolStream(dbiStream.CreatePublicSymbolStream(this->rawPdbFile)),
+            sectionContributionStream(dbiStream.CreateSectionContributionStream(this->rawPdbFile)),
+            moduleInfoStream(dbiStream.CreateModuleInfoStream(this->rawPdbFile)),
+            moduleSymbolStreams(moduleInfoStream.GetModules().GetLength())
+        {
+        }
+
+        ~LookupStreams() { MemoryMappedFile::Close(pdbFile); }
+    };
+
+    std::unique_ptr<LookupStreams> mLookupStreams;
 };
 
 class SymbolParserByMap : public SymbolParser
 {
+private:
+    // The lines after the image base are parsed in chunks of at least this size, split at the line boundaries
+    static constexpr size_t MinChunkSize = 4 << 20;
+
 public:
     SymbolParserByMap() : SymbolParser() {}
     ~SymbolParserByMap() = default;
@@ -451,80 +1144,166 @@ public:
     {
         mFunctionSymbols.clear();
 
-        std::vector<FunctionSymbol> FunctionSymbols;
+        // The file is mapped, the lines are not copied
+        auto BufferOrErr = MemoryBuffer::getFile(SymFilePath, -1, false);
+        if (!BufferOrErr)
+        {
+            // file does not exist
+            return false;
+        }
+        auto &Buffer = *BufferOrErr;
+
+        // The symbols are only parsed after the line of the image base
+        StringRef Text = Buffer->getBuffer();
+        while (!Text.empty() && mImageBase == 0)
+        {
+            auto [Line, Rest] = Text.split('\n');
+            ParseImageBase(Line);
+            Text = Rest;
+        }
 
-        auto ParseImageBase = [&](std::string &Line) {
-            auto Idx = Line.find("Preferred load address is ");
-            if (Idx != std::string::npos)
+        std::vector<StringRef> Chunks;
+        unsigned ThreadCount = std::max(1u, hardware_concurrency());
+        size_t ChunkSize = std::max(MinChunkSize, Text.size() / ThreadCount + 1);
+        while (!Text.empty())
+        {
+            size_t ChunkEnd = Text.find('\n', std::min(ChunkSize, Text.size()) - 1);
+            ChunkEnd = ChunkEnd == StringRef::npos ? Text.size() : ChunkEnd + 1;
+            Chunks.push_back(Text.take_front(ChunkEnd));
+            Text = Text.drop_front(ChunkEnd);
+        }
+
+        // Every chunk has its own symbols, they are concatenated in the order of the file
+        std::vector<std::vector<FunctionSymbol>> ChunkSymbols(Chunks.size());
+        if (Chunks.size() == 1)
+        {
+            ParseSymbolLines(Chunks[0], mImageBase, ChunkSymbols[0]);
+        }
+        else if (Chunks.size() > 1)
+        {
+            ThreadPool Pool(std::min<unsigned>(ThreadCount, Chunks.size()));
+            for (size_t i = 0; i < Chunks.size(); ++i)
             {
-                auto StartIdx = Idx + strlen("Preferred load address is ");
-                auto ImageBaseStr = Line.substr(StartIdx);
-                mImageBase = std::strtoull(ImageBaseStr.c_str(), nullptr, 16);
+                Pool.async([&, i]() { ParseSymbolLines(Chunks[i], mImageBase, ChunkSymbols[i]); });
             }
-        };
+            Pool.wait();
+        }
 
-        auto ParseSymbol = [&](std::string &Line) {
-            // https://github.com/mike1k/perses/blob/master/src/mapfileparser.cpp#LL25
-            std::regex Reg(
-                R"#(\s(\d+):([a-fA-F0-9]+)\s+(\S+)\s+([a-fA-F0-9]+)\s+(.+))#", std::regex_constants::ECMAScript);
-            if (std::regex_match(Line, Reg))
-            {
-                std::smatch Match;
-                for (; std::regex_search(Line, Match, Reg); Line = Match.suffix())
-                {
-                    if (Line.find(" f ") != std::string::npos)
-                    {
-                        FunctionSymbol Sym{};
+        std::vector<FunctionSymbol> FunctionSymbols;
+        size_t NumSymbols = 0;
+        for (auto &Symbols : ChunkSymbols)
+        {
+            NumSymbols += Symbols.size();
+        }
+        FunctionSymbols.reserve(NumSymbols);
+        for (auto &Symbols : ChunkSymbols)
+        {
+            std::move(Symbols.begin(), Symbols.end(), std::back_inserter(FunctionSymbols));
+        }
+
+        if (FunctionSymbols.empty())
+        {
+            return false;
+        }
 
-                        Sym.rva = std::strtoull(Match[4].str().c_str(), nullptr, 16) - mImageBase;
+        std::swap(mFunctionSymbols, FunctionSymbols);
 
-                        if (Sym.rva == 0)
-                        {
-                            continue;
-                        }
+        return true;
+    }
 
-                        if (Sym.rva < 0x1000)
-                        {
-                            continue;
-                        }
+private:
+    // Parse "Preferred load address is <hex>"
+    void ParseImageBase(StringRef Line)
+    {
+        StringRef Prefix("Preferred load address is ");
+        auto Idx = Line.find(Prefix);
+        if (Idx != StringRef::npos)
+        {
+            auto ImageBaseStr = Line.substr(Idx + Prefix.size()).str();
+            mImageBase = std::strtoull(ImageBaseStr.c_str(), nullptr, 16);
+        }
+    }
 
-                        Sym.name = Match[3].str();
-                        Sym.size = 0;
+    // Parse the function symbols of the lines
+    static void ParseSymbolLines(StringRef Text, uint64_t ImageBase, std::vector<FunctionSymbol> &Symbols)
+    {
+        while (!Text.empty())
+        {
+            auto [Line, Rest] = Text.split('\n');
+            Text = Rest;
 
-                        FunctionSymbols.push_back(Sym);
-                    }
-                }
+            FunctionSymbol Sym{};
+            if (ParseSymbolLine(Line, ImageBase, Sym))
+            {
+                Symbols.push_back(std::move(Sym));
+            }
+        }
+    }
+
+    // Parse a function symbol, the whole line must match
+    //   \s(\d+):([a-fA-F0-9]+)\s+(\S+)\s+([a-fA-F0-9]+)\s+(.+)
+    // https://github.com/mike1k/perses/blob/master/src/mapfileparser.cpp#LL25
+    static bool ParseSymbolLine(StringRef Line, uint64_t ImageBase, FunctionSymbol &Sym)
+    {
+        // The line break of the text mode
+        if (Line.endswith("\r"))
+        {
+            Line = Line.drop_back();
+        }
+
+        auto isSpace = [](char C) { return C == ' ' || C == '\t' || C == '\v' || C == '\f' || C == '\r'; };
+        size_t Pos = 0;
+        auto takeWhile = [&](auto Pred) {
+            size_t Begin = Pos;
+            while (Pos < Line.size() && Pred(Line[Pos]))
+            {
+                ++Pos;
             }
+            return Line.slice(Begin, Pos);
         };
 
-        if ((access(SymFilePath.data(), 0) != 0))
+        // Section:Offset
+        if (Line.empty() || !isSpace(Line[Pos++]))
+        {
+            return false;
+        }
+        if (takeWhile(isDigit).empty() || Pos >= Line.size() || Line[Pos++] != ':')
+        {
+            return false;
+        }
+        if (takeWhile(isHexDigit).empty() || takeWhile(isSpace).empty())
         {
-            // file does not exist
             return false;
         }
 
-        std::ifstream IfStream(SymFilePath.data());
-        std::string Line = "";
-
-        while (std::getline(IfStream, Line))
+        // Name
+        auto Name = takeWhile([&](char C) { return !isSpace(C); });
+        if (Name.empty() || takeWhile(isSpace).empty())
         {
-            // read line
+            return false;
+        }
 
-            if (mImageBase == 0)
-            {
-                ParseImageBase(Line);
-                continue;
-            }
+        // Rva+Base, at least one more character follows it
+        auto Address = takeWhile(isHexDigit);
+        if (Address.empty() || Pos + 1 >= Line.size() || !isSpace(Line[Pos]))
+        {
+            return false;
+        }
 
-            ParseSymbol(Line);
+        if (Line.find(" f ") == StringRef::npos)
+        {
+            return false;
         }
 
-        if (FunctionSymbols.empty())
+        SmallString<32> AddressStr(Address);
+        Sym.rva = std::strtoull(AddressStr.c_str(), nullptr, 16) - ImageBase;
+        if (Sym.rva < 0x1000)
         {
             return false;
         }
 
-        std::swap(mFunctionSymbols, FunctionSymbols);
+        Sym.name = Name.str();
+        Sym.size = 0;
 
         return true;
     }
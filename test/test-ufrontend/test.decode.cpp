@@ -0,0 +1,270 @@
+
+#include <UnknownFrontend/UnknownFrontend.h>
+#include <x86/DecodedInstructionCache.x86.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(test_decode, test_decode_1)
+{
+    std::cout << "---------------decode----------------\n";
+
+    uir::Context CTX;
+    CTX.setArch(uir::Context::Arch::ArchX86);
+    CTX.setMode(uir::Context::Mode::Mode64);
+
+    auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+        CTX,
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.exe)",
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.cfg.xml)",
+        true);
+    ASSERT_TRUE(Translator);
+    Translator->initTranslator();
+
+    auto Begin = std::chrono::steady_clock::now();
+    auto Module = Translator->translateBinary("Project12");
+    auto End = std::chrono::steady_clock::now();
+    ASSERT_TRUE(Module);
+
+    // Every instruction is decoded inside its block, the jmp falling through to the next block is at its end
+    size_t InstCount = 0;
+    for (auto F : *Module)
+    {
+        for (auto BB : *F)
+        {
+            for (auto &I : *BB)
+            {
+                EXPECT_GE(I.getInstructionAddress(), BB->getBasicBlockAddressBegin());
+                EXPECT_LE(I.getInstructionAddress(), BB->getBasicBlockAddressEnd());
+            }
+            InstCount += BB->size();
+        }
+    }
+    EXPECT_GT(InstCount, 0u);
+
+    double Seconds = std::chrono::duration<double>(End - Begin).count();
+    std::cout << "Project12: " << InstCount << " instructions in " << Seconds << "s, "
+              << (Seconds > 0 ? InstCount / Seconds : 0) << " instructions/sec\n";
+}
+
+TEST(test_decode, test_decode_2)
+{
+    std::cout << "---------------decode----------------\n";
+
+    uir::Context CTX;
+    CTX.setArch(uir::Context::Arch::ArchX86);
+    CTX.setMode(uir::Context::Mode::Mode64);
+
+    auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+        CTX,
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.exe)",
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.cfg.xml)",
+        false);
+    ASSERT_TRUE(Translator);
+    Translator->initTranslator();
+
+    // A large synthetic function made of "add rax, rcx"
+    const uint8_t InstBytes[] = {0x48, 0x01, 0xC8};
+    const size_t InstCount = 1 << 18;
+    std::vector<uint8_t> Bytes;
+    Bytes.reserve(InstCount * sizeof(InstBytes));
+    for (size_t i = 0; i < InstCount; ++i)
+    {
+        Bytes.insert(Bytes.end(), std::begin(InstBytes), std::end(InstBytes));
+    }
+
+    const uint64_t Address = 0x140001000;
+    uir::BasicBlock BB(CTX, "synthetic", Address, Address + Bytes.size());
+
+    auto Begin = std::chrono::steady_clock::now();
+    for (size_t Offset = 0; Offset < Bytes.size(); Offset += sizeof(InstBytes))
+    {
+        bool TransRes =
+            Translator->translateOneInstruction(Bytes.data() + Offset, Bytes.size() - Offset, Address + Offset, &BB);
+        EXPECT_TRUE(TransRes);
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    // Every "add rax, rcx" is decoded at its own address and lifted into one add
+    size_t AddCount = 0;
+    std::set<uint64_t> InstAddresses;
+    for (auto &I : BB)
+    {
+        EXPECT_EQ((I.getInstructionAddress() - Address) % sizeof(InstBytes), 0u);
+        InstAddresses.insert(I.getInstructionAddress());
+        AddCount += unknown::isa<uir::AddInstruction>(&I);
+    }
+    EXPECT_EQ(InstAddresses.size(), InstCount);
+    EXPECT_EQ(AddCount, InstCount);
+
+    double Seconds = std::chrono::duration<double>(End - Begin).count();
+    std::cout << "synthetic: " << InstCount << " instructions in " << Seconds << "s, "
+              << (Seconds > 0 ? InstCount / Seconds : 0) << " instructions/sec\n";
+}
+
+// An "add rax, <Reg>" decoded at the address, its bytes are 48 01 <ModRM>
+struct DecodedAdd
+{
+    cs_insn Insn = {};
+    cs_detail Detail = {};
+
+    DecodedAdd(uint64_t Address, uint8_t ModRM, const char *OpStr)
+    {
+        Insn.id = X86_INS_ADD;
+        Insn.address = Address;
+        Insn.size = 3;
+        Insn.bytes[0] = 0x48;
+        Insn.bytes[1] = 0x01;
+        Insn.bytes[2] = ModRM;
+        std::strcpy(Insn.mnemonic, "add");
+        std::strcpy(Insn.op_str, OpStr);
+        Insn.detail = &Detail;
+
+        Detail.x86.op_count = 2;
+        Detail.x86.operands[0].type = X86_OP_REG;
+        Detail.x86.operands[0].reg = X86_REG_RAX;
+        Detail.x86.operands[1].type = X86_OP_REG;
+    }
+};
+
+TEST(test_decode, test_decode_3)
+{
+    std::cout << "---------------decode----------------\n";
+
+    const uint64_t Address = 0x140001000;
+    const uint8_t AddRcx[] = {0x48, 0x01, 0xC8};
+    const uint8_t AddRbx[] = {0x48, 0x01, 0xD8};
+
+    ufrontend::DecodedInstructionCacheX86 Cache;
+    DecodedAdd Add(Address, 0xC8, "rax, rcx");
+    EXPECT_TRUE(Cache.insert(&Add.Insn));
+    EXPECT_FALSE(Cache.insert(&Add.Insn));
+
+    // The record is restored with the operands in use
+    DecodedAdd Restored(0, 0, "");
+    ASSERT_TRUE(Cache.lookup(Address, AddRcx, &Restored.Insn));
+    EXPECT_EQ(Restored.Insn.id, static_cast<unsigned>(X86_INS_ADD));
+    EXPECT_EQ(Restored.Insn.address, Address);
+    EXPECT_EQ(Restored.Insn.size, 3u);
+    EXPECT_STREQ(Restored.Insn.mnemonic, "add");
+    EXPECT_STREQ(Restored.Insn.op_str, "rax, rcx");
+    EXPECT_EQ(Restored.Detail.x86.op_count, 2u);
+    EXPECT_EQ(Restored.Detail.x86.operands[0].reg, X86_REG_RAX);
+
+    // Other bytes at the address miss, and so do too few of them
+    EXPECT_FALSE(Cache.lookup(Address, AddRbx, &Restored.Insn));
+    EXPECT_FALSE(Cache.lookup(Address, unknown::ArrayRef<uint8_t>(AddRcx, 2), &Restored.Insn));
+    EXPECT_FALSE(Cache.lookup(Address + 3, AddRcx, &Restored.Insn));
+
+    // The instruction of the other bytes replaces the record
+    DecodedAdd Patched(Address, 0xD8, "rax, rbx");
+    EXPECT_TRUE(Cache.insert(&Patched.Insn));
+    EXPECT_FALSE(Cache.lookup(Address, AddRcx, &Restored.Insn));
+    ASSERT_TRUE(Cache.lookup(Address, AddRbx, &Restored.Insn));
+    EXPECT_STREQ(Restored.Insn.op_str, "rax, rbx");
+}
+
+TEST(test_decode, test_decode_4)
+{
+    std::cout << "---------------decode----------------\n";
+
+    const uint64_t Address = 0x140001000;
+    const uint8_t AddRcx[] = {0x48, 0x01, 0xC8};
+
+    // Nothing is inserted once the budget is used up
+    ufrontend::DecodedInstructionCacheX86 Cache(4096);
+    EXPECT_EQ(Cache.getMemoryBudget(), 4096u);
+
+    size_t InsertCount = 0;
+    while (true)
+    {
+        DecodedAdd Add(Address + InsertCount * 3, 0xC8, "rax, rcx");
+        if (!Cache.insert(&Add.Insn))
+        {
+            break;
+        }
+        ++InsertCount;
+    }
+    EXPECT_GT(InsertCount, 0u);
+    EXPECT_LE(Cache.getMemoryUsed(), Cache.getMemoryBudget());
+
+    // The failed insert uses nothing of the budget
+    auto MemoryUsed = Cache.getMemoryUsed();
+    DecodedAdd Rejected(Address + InsertCount * 3, 0xC8, "rax, rcx");
+    EXPECT_FALSE(Cache.insert(&Rejected.Insn));
+    EXPECT_EQ(Cache.getMemoryUsed(), MemoryUsed);
+
+    DecodedAdd Restored(0, 0, "");
+    for (size_t i = 0; i < InsertCount; ++i)
+    {
+        EXPECT_TRUE(Cache.lookup(Address + i * 3, AddRcx, &Restored.Insn)) << i;
+    }
+    EXPECT_FALSE(Cache.lookup(Address + InsertCount * 3, AddRcx, &Restored.Insn));
+}
+
+TEST(test_decode, test_decode_5)
+{
+    std::cout << "---------------decode----------------\n";
+
+    const uint64_t Address = 0x140001000;
+    const size_t InstCount = 4096;
+    const uint8_t AddRcx[] = {0x48, 0x01, 0xC8};
+    const uint8_t AddRbx[] = {0x48, 0x01, 0xD8};
+
+    // The writers insert their own addresses and replace the record of a shared one back and forth, while the readers
+    // look all of them up. A hit is always the instruction of the bytes it is looked up with
+    ufrontend::DecodedInstructionCacheX86 Cache;
+    const uint64_t SharedAddress = Address + InstCount * 3;
+    std::atomic<bool> Inconsistent = false;
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            for (size_t i = t; i < InstCount; i += 4)
+            {
+                DecodedAdd Add(Address + i * 3, 0xC8, "rax, rcx");
+                Cache.insert(&Add.Insn);
+
+                DecodedAdd Shared(SharedAddress, i % 2 ? 0xC8 : 0xD8, i % 2 ? "rax, rcx" : "rax, rbx");
+                Cache.insert(&Shared.Insn);
+            }
+        });
+        Threads.emplace_back([&]() {
+            DecodedAdd Restored(0, 0, "");
+            for (size_t i = 0; i < InstCount; ++i)
+            {
+                if (Cache.lookup(Address + i * 3, AddRcx, &Restored.Insn) &&
+                    std::string(Restored.Insn.op_str) != "rax, rcx")
+                {
+                    Inconsistent = true;
+                }
+
+                if (Cache.lookup(SharedAddress, AddRbx, &Restored.Insn) &&
+                    std::string(Restored.Insn.op_str) != "rax, rbx")
+                {
+                    Inconsistent = true;
+                }
+            }
+        });
+    }
+    for (auto &Thread : Threads)
+    {
+        Thread.join();
+    }
+    EXPECT_FALSE(Inconsistent);
+
+    // Every instruction inserted once is in the cache
+    DecodedAdd Restored(0, 0, "");
+    for (size_t i = 0; i < InstCount; ++i)
+    {
+        EXPECT_TRUE(Cache.lookup(Address + i * 3, AddRcx, &Restored.Insn)) << i;
+    }
+}
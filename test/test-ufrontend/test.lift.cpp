@@ -1,8 +1,14 @@
 
 #include <UnknownFrontend/UnknownFrontend.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <vector>
 
 TEST(test_lift, test_lift_1)
 {
@@ -21,9 +27,35 @@ TEST(test_lift, test_lift_1)
     assert(Translator);
     Translator->initTranslator();
 
+    auto ConstantsBefore = CTX.getNumIntConstantsAllocated();
     auto Module = Translator->translateBinary("Project12");
     assert(Module);
+    auto ConstantsAfter = CTX.getNumIntConstantsAllocated();
     Module->print(unknown::outs());
+
+    // Every constant operand was a ConstantInt of its own before they were pooled
+    size_t ConstantOperands = 0;
+    for (auto F : *Module)
+    {
+        for (auto BB : *F)
+        {
+            for (auto &I : *BB)
+            {
+                for (size_t Index = 0; Index < I.op_count(); ++Index)
+                {
+                    ConstantOperands += unknown::dyn_cast_or_null<uir::ConstantInt>(I.getOperand(Index)) != nullptr;
+                }
+            }
+        }
+    }
+    std::cout << std::format(
+                     "ConstantInt allocated: {} before lifting, {} after lifting, {} constant operands",
+                     ConstantsBefore,
+                     ConstantsAfter,
+                     ConstantOperands)
+              << std::endl;
+    EXPECT_GT(ConstantOperands, 0u);
+    EXPECT_LT(ConstantsAfter - ConstantsBefore, ConstantOperands);
 }
 
 TEST(test_lift, test_lift_2)
@@ -47,3 +79,499 @@ TEST(test_lift, test_lift_2)
     assert(Module);
     Module->print(unknown::outs());
 }
+
+TEST(test_lift, test_lift_3)
+{
+    std::cout << "---------------lift----------------\n";
+
+    // Lift serially and in parallel, the output must be the same
+    auto liftProject12 = [](uint32_t ThreadCount) {
+        uir::Context CTX;
+        CTX.setArch(uir::Context::Arch::ArchX86);
+        CTX.setMode(uir::Context::Mode::Mode64);
+
+        auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+            CTX,
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.exe)",
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.cfg.xml)",
+            true);
+        assert(Translator);
+        Translator->setThreadCount(ThreadCount);
+        Translator->initTranslator();
+
+        auto Module = Translator->translateBinary("Project12");
+        assert(Module);
+
+        std::string Output;
+        unknown::raw_string_ostream OS(Output);
+        Module->print(OS);
+        return OS.str();
+    };
+
+    auto SerialOutput = liftProject12(1);
+    auto ParallelOutput = liftProject12(4);
+    EXPECT_EQ(SerialOutput, ParallelOutput);
+}
+
+TEST(test_lift, test_lift_4)
+{
+    std::cout << "---------------lift----------------\n";
+
+    auto CacheDirectory = (std::filesystem::temp_directory_path() / "uir-lift-cache-test").string();
+    std::filesystem::remove_all(CacheDirectory);
+
+    // The second lift loads every function from the cache, the output must be the same
+    auto liftProject12 = [&CacheDirectory]() {
+        uir::Context CTX;
+        CTX.setArch(uir::Context::Arch::ArchX86);
+        CTX.setMode(uir::Context::Mode::Mode64);
+
+        auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+            CTX,
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.exe)",
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.cfg.xml)",
+            true);
+        assert(Translator);
+        Translator->setLiftCacheDirectory(CacheDirectory, "prune_after=1h:cache_size_bytes=64m");
+        Translator->setSymbolIndexDirectory(CacheDirectory);
+        Translator->initTranslator();
+
+        auto Module = Translator->translateBinary("Project12");
+        assert(Module);
+
+        std::string Output;
+        unknown::raw_string_ostream OS(Output);
+        Module->print(OS);
+        return OS.str();
+    };
+
+    auto ColdOutput = liftProject12();
+    EXPECT_FALSE(std::filesystem::is_empty(CacheDirectory));
+
+    // The symbols of the PDB are indexed too
+    auto HasSymbolIndex = false;
+    for (auto &Entry : std::filesystem::directory_iterator(CacheDirectory))
+    {
+        HasSymbolIndex |= Entry.path().filename().string().rfind("pdbindex-", 0) == 0;
+    }
+    EXPECT_TRUE(HasSymbolIndex);
+
+    auto WarmOutput = liftProject12();
+    EXPECT_EQ(ColdOutput, WarmOutput);
+
+    std::filesystem::remove_all(CacheDirectory);
+}
+
+// Write a PE32+ image with the code at the begin of its only section, .text at ImageBase + 0x1000
+static void
+writeCodeImage(const std::string &ImagePath, uint64_t ImageBase, const std::vector<uint8_t> &Code)
+{
+    std::vector<uint8_t> Image(0x400, 0);
+    auto write16 = [&Image](size_t Offset, uint16_t V) { std::memcpy(Image.data() + Offset, &V, sizeof(V)); };
+    auto write32 = [&Image](size_t Offset, uint32_t V) { std::memcpy(Image.data() + Offset, &V, sizeof(V)); };
+    auto write64 = [&Image](size_t Offset, uint64_t V) { std::memcpy(Image.data() + Offset, &V, sizeof(V)); };
+
+    // DOS header, NT signature and file header
+    Image[0] = 'M';
+    Image[1] = 'Z';
+    write32(0x3C, 0x40);
+    std::memcpy(Image.data() + 0x40, "PE\0\0", 4);
+    write16(0x44, 0x8664);
+    write16(0x46, 1);
+    write16(0x54, 0xF0);
+
+    // Optional header without data directories
+    write16(0x58, 0x20B);
+    write64(0x58 + 24, ImageBase);
+    write32(0x58 + 108, 16);
+
+    // .text
+    std::memcpy(Image.data() + 0x148, ".text", 5);
+    write32(0x148 + 8, 0x200);
+    write32(0x148 + 12, 0x1000);
+    write32(0x148 + 16, 0x200);
+    write32(0x148 + 20, 0x200);
+    std::copy(Code.begin(), Code.end(), Image.begin() + 0x200);
+
+    std::ofstream OS(ImagePath, std::ios::binary);
+    OS.write(reinterpret_cast<const char *>(Image.data()), Image.size());
+}
+
+TEST(test_lift, test_lift_5)
+{
+    std::cout << "---------------lift----------------\n";
+
+    // Two branches back into the middle of a translated block, the later one is split first while the other one is
+    // still pending. The conditional branch out of the function jumps there from a block of its own
+    const std::vector<uint8_t> Code = {
+        0x48, 0x85, 0xC9,                   // 0x00 test rcx, rcx
+        0x74, 0x09,                         // 0x03 je 0x0E
+        0x48, 0xFF, 0xC1,                   // 0x05 inc rcx
+        0x48, 0xFF, 0xC2,                   // 0x08 inc rdx
+        0x48, 0xFF, 0xC3,                   // 0x0B inc rbx
+        0x48, 0x85, 0xC9,                   // 0x0E test rcx, rcx
+        0x75, 0xF5,                         // 0x11 jne 0x08
+        0x48, 0x85, 0xD2,                   // 0x13 test rdx, rdx
+        0x75, 0xF3,                         // 0x16 jne 0x0B
+        0x0F, 0x84, 0xE2, 0x00, 0x00, 0x00, // 0x18 je 0x100
+        0xC3,                               // 0x1E ret
+    };
+
+    const uint64_t ImageBase = 0x140000000;
+    const uint64_t Begin = ImageBase + 0x1000;
+    auto ImagePath = (std::filesystem::temp_directory_path() / "uir-lift-blocks-test.exe").string();
+    writeCodeImage(ImagePath, ImageBase, Code);
+
+    uir::Context CTX;
+    CTX.setArch(uir::Context::Arch::ArchX86);
+    CTX.setMode(uir::Context::Mode::Mode64);
+
+    auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+        CTX,
+        ImagePath,
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+        "",
+        true);
+    assert(Translator);
+    Translator->initTranslator();
+
+    auto F = std::make_unique<uir::Function>(CTX);
+    ASSERT_TRUE(Translator->translateOneFunction("blocks", Begin, Code.size(), F.get()));
+
+    // The begin, the end and the begins of the successors of every block in order, the block jumping out of the
+    // function is at the branch and is inserted last
+    struct ExpectedBlock
+    {
+        uint64_t Begin;
+        uint64_t End;
+        std::vector<uint64_t> Successors;
+    };
+    const std::vector<ExpectedBlock> ExpectedBlocks = {
+        {0x00, 0x05, {0x0E, 0x05}},
+        {0x05, 0x08, {0x08}},
+        {0x08, 0x0B, {0x0B}},
+        {0x0B, 0x0E, {0x0E}},
+        {0x0E, 0x13, {0x08, 0x13}},
+        {0x13, 0x18, {0x0B, 0x18}},
+        {0x18, 0x1E, {0x18, 0x1E}},
+        {0x1E, 0x1F, {}},
+        {0x18, 0x18, {}},
+    };
+
+    std::vector<ExpectedBlock> Blocks;
+    for (auto BB : *F)
+    {
+        ExpectedBlock Block{BB->getBasicBlockAddressBegin() - Begin, BB->getBasicBlockAddressEnd() - Begin, {}};
+        auto Terminator = BB->getTerminator();
+        ASSERT_NE(Terminator, nullptr) << std::format("0x{:X}", Block.Begin);
+        for (auto Successor : Terminator->getSuccessorsList())
+        {
+            Block.Successors.push_back(Successor->getBasicBlockAddressBegin() - Begin);
+
+            // Every edge is linked on both of its ends
+            auto &Predecessors = Successor->getPredecessorsList();
+            EXPECT_NE(std::find(Predecessors.begin(), Predecessors.end(), BB), Predecessors.end());
+        }
+        Blocks.push_back(std::move(Block));
+    }
+
+    ASSERT_EQ(Blocks.size(), ExpectedBlocks.size());
+    for (size_t i = 0; i < Blocks.size(); ++i)
+    {
+        EXPECT_EQ(Blocks[i].Begin, ExpectedBlocks[i].Begin) << i;
+        EXPECT_EQ(Blocks[i].End, ExpectedBlocks[i].End) << i;
+        EXPECT_EQ(Blocks[i].Successors, ExpectedBlocks[i].Successors) << i;
+    }
+
+    // The last block jumps to the target out of the function
+    auto ExitTerminator = F->back().getTerminator();
+    ASSERT_NE(ExitTerminator, nullptr);
+    EXPECT_EQ(ExitTerminator->getOpCodeID(), uir::OpCodeID::JmpAddr);
+
+    std::filesystem::remove(ImagePath);
+}
+
+TEST(test_lift, test_lift_6)
+{
+    std::cout << "---------------lift----------------\n";
+
+    // The end addresses of the functions, indexed by begin address. The MAP names are decorated, the PDB ones are not
+    auto liftRanges = [](const char *SymbolFile) {
+        uir::Context CTX;
+        CTX.setArch(uir::Context::Arch::ArchX86);
+        CTX.setMode(uir::Context::Mode::Mode64);
+
+        auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+            CTX,
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.exe)",
+            SymbolFile,
+            UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.cfg.xml)",
+            true);
+        assert(Translator);
+        Translator->initTranslator();
+
+        auto Module = Translator->translateBinary("Project12");
+        assert(Module);
+
+        std::map<uint64_t, uint64_t> Ranges;
+        for (auto F : *Module)
+        {
+            Ranges.try_emplace(F->getFunctionBeginAddress(), F->getFunctionEndAddress());
+        }
+        return Ranges;
+    };
+
+    // The symbols of the MAP file have no size, it is derived from the next symbol and the .pdata
+    auto MapRanges = liftRanges(UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.map)");
+    auto PdbRanges = liftRanges(UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)");
+    ASSERT_FALSE(MapRanges.empty());
+
+    size_t Compared = 0;
+    for (auto It = MapRanges.begin(); It != MapRanges.end(); ++It)
+    {
+        auto [Begin, End] = *It;
+        EXPECT_GT(End, Begin) << std::format("0x{:X}", Begin);
+
+        // A function doesn't run into the next one
+        if (auto NextIt = std::next(It); NextIt != MapRanges.end())
+        {
+            EXPECT_LE(End, NextIt->first) << std::format("0x{:X}", Begin);
+        }
+
+        // It covers the code of the same function in the PDB, which has the exact size
+        auto PdbIt = PdbRanges.find(Begin);
+        if (PdbIt != PdbRanges.end())
+        {
+            EXPECT_GE(End, PdbIt->second) << std::format("0x{:X}", Begin);
+            ++Compared;
+        }
+    }
+    EXPECT_GT(Compared, 0u);
+}
+
+// Get the instructions lifted from the instruction at the address
+static std::vector<uir::Instruction *>
+getInstructionsAt(uir::BasicBlock &BB, uint64_t Address)
+{
+    std::vector<uir::Instruction *> Instructions;
+    for (auto &I : BB)
+    {
+        if (I.getInstructionAddress() == Address)
+        {
+            Instructions.push_back(&I);
+        }
+    }
+    return Instructions;
+}
+
+// Get the first instruction of the type lifted from the instruction at the address, nullptr if there is none
+template <typename InstructionType>
+static InstructionType *
+getInstructionAt(uir::BasicBlock &BB, uint64_t Address)
+{
+    for (auto I : getInstructionsAt(BB, Address))
+    {
+        if (auto Typed = unknown::dyn_cast<InstructionType>(I))
+        {
+            return Typed;
+        }
+    }
+    return nullptr;
+}
+
+TEST(test_lift, test_lift_7)
+{
+    std::cout << "---------------lift----------------\n";
+
+    uir::Context CTX;
+    CTX.setArch(uir::Context::Arch::ArchX86);
+    CTX.setMode(uir::Context::Mode::Mode64);
+
+    auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+        CTX,
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.exe)",
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.cfg.xml)",
+        false);
+    ASSERT_TRUE(Translator);
+    Translator->initTranslator();
+
+    // Every family of the semantics table, then an instruction out of it
+    const std::vector<std::vector<uint8_t>> Insns = {
+        {0x48, 0x21, 0xC8}, // 0x00 and rax, rcx
+        {0x48, 0x09, 0xC8}, // 0x03 or rax, rcx
+        {0x48, 0x31, 0xC8}, // 0x06 xor rax, rcx
+        {0x48, 0x29, 0xC8}, // 0x09 sub rax, rcx
+        {0x48, 0x39, 0xC8}, // 0x0C cmp rax, rcx
+        {0x48, 0x85, 0xC8}, // 0x0F test rax, rcx
+        {0x48, 0xFF, 0xC0}, // 0x12 inc rax
+        {0x48, 0xFF, 0xC8}, // 0x15 dec rax
+        {0x50},             // 0x18 push rax
+        {0x59},             // 0x19 pop rcx
+        {0x01, 0xC8},       // 0x1A add eax, ecx
+        {0x0F, 0xA2},       // 0x1C cpuid
+        {0x48, 0x01, 0xC8}, // 0x1E add rax, rcx
+    };
+
+    const uint64_t Address = 0x140001000;
+    uir::BasicBlock BB(CTX, "semantics", Address, Address + 0x21);
+    uint64_t InstAddress = Address;
+    for (auto &Bytes : Insns)
+    {
+        EXPECT_TRUE(Translator->translateOneInstruction(Bytes.data(), Bytes.size(), InstAddress, &BB))
+            << std::format("0x{:X}", InstAddress);
+        InstAddress += Bytes.size();
+    }
+
+    auto isConstant = [](const uir::Value *V, uint64_t Expected) {
+        auto C = unknown::dyn_cast_or_null<uir::ConstantInt>(V);
+        return C != nullptr && C->getZExtValue() == Expected;
+    };
+
+    // and/or/xor are lifted into their own instructions, the value written to rax is read from the block
+    auto And = getInstructionAt<uir::AndInstruction>(BB, Address + 0x00);
+    auto Or = getInstructionAt<uir::OrInstruction>(BB, Address + 0x03);
+    auto Xor = getInstructionAt<uir::XorInstruction>(BB, Address + 0x06);
+    ASSERT_TRUE(And && Or && Xor);
+    EXPECT_TRUE(unknown::isa<uir::LoadInstruction>(And->getLHS()));
+    EXPECT_TRUE(unknown::isa<uir::LoadInstruction>(And->getRHS()));
+    EXPECT_EQ(Or->getLHS(), And);
+    EXPECT_EQ(Or->getRHS(), And->getRHS());
+    EXPECT_EQ(Xor->getLHS(), Or);
+    EXPECT_EQ(getInstructionAt<uir::LoadInstruction>(BB, Address + 0x03), nullptr);
+
+    // sub writes the result, cmp and test only define the flags
+    EXPECT_NE(getInstructionAt<uir::SubInstruction>(BB, Address + 0x09), nullptr);
+    EXPECT_NE(getInstructionAt<uir::StoreInstruction>(BB, Address + 0x09), nullptr);
+    EXPECT_NE(getInstructionAt<uir::SubInstruction>(BB, Address + 0x0C), nullptr);
+    EXPECT_EQ(getInstructionAt<uir::StoreInstruction>(BB, Address + 0x0C), nullptr);
+    EXPECT_NE(getInstructionAt<uir::AndInstruction>(BB, Address + 0x0F), nullptr);
+    EXPECT_EQ(getInstructionAt<uir::StoreInstruction>(BB, Address + 0x0F), nullptr);
+
+    // inc/dec add and subtract one
+    auto Inc = getInstructionAt<uir::AddInstruction>(BB, Address + 0x12);
+    auto Dec = getInstructionAt<uir::SubInstruction>(BB, Address + 0x15);
+    ASSERT_TRUE(Inc && Dec);
+    EXPECT_TRUE(isConstant(Inc->getRHS(), 1));
+    EXPECT_TRUE(isConstant(Dec->getRHS(), 1));
+
+    // push/pop are out of the table, the registers are loaded again after them
+    EXPECT_NE(getInstructionAt<uir::UnknownInstruction>(BB, Address + 0x18), nullptr);
+    EXPECT_NE(getInstructionAt<uir::UnknownInstruction>(BB, Address + 0x19), nullptr);
+    EXPECT_EQ(getInstructionAt<uir::StoreInstruction>(BB, Address + 0x18), nullptr);
+    EXPECT_EQ(getInstructionAt<uir::LoadInstruction>(BB, Address + 0x19), nullptr);
+
+    // Writing eax clears the upper half of rax
+    auto ClearsHigh = false;
+    for (auto I : getInstructionsAt(BB, Address + 0x1A))
+    {
+        auto Store = unknown::dyn_cast<uir::StoreInstruction>(I);
+        ClearsHigh |= Store && unknown::isa<uir::GetBitPtrInstruction>(Store->getPointerOperand()) &&
+                      isConstant(Store->getValueOperand(), 0);
+    }
+    EXPECT_NE(getInstructionAt<uir::AddInstruction>(BB, Address + 0x1A), nullptr);
+    EXPECT_TRUE(ClearsHigh);
+
+    // The registers written by cpuid are not known, rax and rcx are loaded again after it
+    EXPECT_NE(getInstructionAt<uir::UnknownInstruction>(BB, Address + 0x1C), nullptr);
+    auto Add = getInstructionAt<uir::AddInstruction>(BB, Address + 0x1E);
+    ASSERT_NE(Add, nullptr);
+    for (auto Operand : {Add->getLHS(), Add->getRHS()})
+    {
+        auto Load = unknown::dyn_cast<uir::LoadInstruction>(Operand);
+        ASSERT_NE(Load, nullptr);
+        EXPECT_EQ(Load->getInstructionAddress(), Address + 0x1E);
+    }
+}
+
+TEST(test_lift, test_lift_8)
+{
+    std::cout << "---------------lift----------------\n";
+
+    // The branch back splits the block after the and, the or reads rax and rcx of the head
+    const std::vector<uint8_t> Code = {
+        0x48, 0x21, 0xC8, // 0x00 and rax, rcx
+        0x48, 0x09, 0xC8, // 0x03 or rax, rcx
+        0x48, 0x31, 0xC8, // 0x06 xor rax, rcx
+        0x75, 0xF8,       // 0x09 jne 0x03
+        0xC3,             // 0x0B ret
+    };
+
+    const uint64_t ImageBase = 0x140000000;
+    const uint64_t Begin = ImageBase + 0x1000;
+    auto ImagePath = (std::filesystem::temp_directory_path() / "uir-lift-split-test.exe").string();
+    writeCodeImage(ImagePath, ImageBase, Code);
+
+    uir::Context CTX;
+    CTX.setArch(uir::Context::Arch::ArchX86);
+    CTX.setMode(uir::Context::Mode::Mode64);
+
+    auto Translator = ufrontend::UnknownFrontendTranslator::createTranslator(
+        CTX,
+        ImagePath,
+        UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)",
+        "",
+        true);
+    assert(Translator);
+    Translator->initTranslator();
+
+    auto F = std::make_unique<uir::Function>(CTX);
+    ASSERT_TRUE(Translator->translateOneFunction("split", Begin, Code.size(), F.get()));
+    ASSERT_EQ(F->size(), 3u);
+
+    // Every block only reads the values of its own instructions, the tail loads the ones of the head again
+    for (auto BB : *F)
+    {
+        for (auto &I : *BB)
+        {
+            for (size_t Index = 0; Index < I.op_count(); ++Index)
+            {
+                auto Operand = unknown::dyn_cast_or_null<uir::Instruction>(I.getOperand(Index));
+                EXPECT_TRUE(Operand == nullptr || Operand->getParent() == BB)
+                    << std::format("0x{:X}", I.getInstructionAddress());
+            }
+        }
+    }
+
+    auto Tail = *std::next(F->begin());
+    ASSERT_EQ(Tail->getBasicBlockAddressBegin(), Begin + 0x03);
+    auto Or = getInstructionAt<uir::OrInstruction>(*Tail, Begin + 0x03);
+    ASSERT_NE(Or, nullptr);
+    EXPECT_TRUE(unknown::isa<uir::LoadInstruction>(Or->getLHS()));
+    EXPECT_TRUE(unknown::isa<uir::LoadInstruction>(Or->getRHS()));
+
+    // The and/or/xor are read back as the same binary instructions
+    unknown::SmallVector<char, 0> Buffer;
+    unknown::raw_svector_ostream OS(Buffer);
+    uir::ModuleWriter Writer(*F);
+    ASSERT_TRUE(Writer.write(OS)) << Writer.getErrorMessage();
+
+    uir::ModuleReader Reader(
+        CTX, unknown::MemoryBuffer::getMemBuffer(unknown::StringRef(Buffer.data(), Buffer.size()), "split", false));
+    auto ReadF = std::make_unique<uir::Function>(CTX);
+    ASSERT_TRUE(Reader.parse()) << Reader.getErrorMessage();
+    ASSERT_TRUE(Reader.materializeFunctionInto(0, ReadF.get())) << Reader.getErrorMessage();
+
+    size_t BinaryCount = 0;
+    for (auto BB : *ReadF)
+    {
+        for (auto &I : *BB)
+        {
+            BinaryCount += unknown::isa<uir::AndInstruction>(&I) || unknown::isa<uir::OrInstruction>(&I) ||
+                           unknown::isa<uir::XorInstruction>(&I);
+        }
+    }
+    EXPECT_EQ(BinaryCount, 3u);
+
+    std::string Printed, ReadPrinted;
+    unknown::raw_string_ostream PrintedOS(Printed), ReadPrintedOS(ReadPrinted);
+    F->print(PrintedOS);
+    ReadF->print(ReadPrintedOS);
+    PrintedOS.flush();
+    ReadPrintedOS.flush();
+    EXPECT_EQ(Printed, ReadPrinted);
+
+    std::filesystem::remove(ImagePath);
+}
@@ -0,0 +1,114 @@
+#include <UnknownUtils/unknown/Symbol/SymbolParser.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+
+TEST(test_symbol, test_symbol_lookup)
+{
+    std::cout << "---------------symbol lookup----------------\n";
+
+    auto Parser = unknown::CreateSymbolParserForPEByPDB();
+    ASSERT_TRUE(Parser->OpenFunctionSymbols(UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)"));
+
+    // Every function symbol in the range can be found by its RVA and by its name
+    size_t Count = 0;
+    uint32_t PrevRVA = 0;
+    Parser->ForEachFunctionSymbolInRange(0, UINT32_MAX, [&](const unknown::SymbolParser::FunctionSymbolRef &Symbol) {
+        EXPECT_GE(Symbol.rva, PrevRVA);
+        PrevRVA = Symbol.rva;
+        ++Count;
+
+        auto ByRVA = Parser->FindFunctionSymbolByRVA(Symbol.rva);
+        ASSERT_TRUE(ByRVA.has_value());
+        EXPECT_EQ(ByRVA->rva, Symbol.rva);
+
+        auto ByName = Parser->FindFunctionSymbolByName(Symbol.name);
+        ASSERT_TRUE(ByName.has_value());
+        EXPECT_EQ(ByName->name, Symbol.name);
+    });
+    EXPECT_NE(Count, 0u);
+
+    EXPECT_FALSE(Parser->FindFunctionSymbolByName("?not_a_function@@YAXXZ").has_value());
+    EXPECT_TRUE(Parser->getFunctionSymbols().empty());
+
+    // The lookups find the symbols of a full parse of the same PDB, with the same sizes
+    auto FullParser = unknown::CreateSymbolParserForPEByPDB();
+    ASSERT_TRUE(FullParser->ParseFunctionSymbols(UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)"));
+    ASSERT_FALSE(FullParser->getFunctionSymbols().empty());
+    for (auto &Symbol : FullParser->getFunctionSymbols())
+    {
+        auto ByRVA = Parser->FindFunctionSymbolByRVA(Symbol.rva);
+        ASSERT_TRUE(ByRVA.has_value()) << Symbol.name;
+        EXPECT_EQ(ByRVA->rva, Symbol.rva) << Symbol.name;
+        EXPECT_EQ(ByRVA->size, Symbol.size) << Symbol.name;
+
+        // The folded functions share an RVA, either of their names may be found
+        auto ByRVAName = Parser->FindFunctionSymbolByName(ByRVA->name);
+        ASSERT_TRUE(ByRVAName.has_value()) << Symbol.name;
+        EXPECT_EQ(ByRVAName->rva, Symbol.rva) << Symbol.name;
+
+        auto ByName = Parser->FindFunctionSymbolByName(Symbol.name);
+        ASSERT_TRUE(ByName.has_value()) << Symbol.name;
+        EXPECT_EQ(ByName->rva, Symbol.rva) << Symbol.name;
+        EXPECT_EQ(ByName->size, Symbol.size) << Symbol.name;
+    }
+}
+
+TEST(test_symbol, test_symbol_index)
+{
+    std::cout << "---------------symbol index----------------\n";
+
+    auto CacheDirectory = (std::filesystem::temp_directory_path() / "uir-symbol-index-test").string();
+    std::filesystem::remove_all(CacheDirectory);
+
+    auto parseSymbols = [&CacheDirectory](bool UseIndex) {
+        auto Parser = unknown::CreateSymbolParserForPEByPDB();
+        if (UseIndex)
+        {
+            Parser->setIndexCacheDirectory(CacheDirectory);
+        }
+        EXPECT_TRUE(Parser->ParseFunctionSymbols(UNKNOWN_REBUILDER_SRC_DIR R"(/sample/pe-x64/Project12.pdb)"));
+        return Parser->getFunctionSymbols();
+    };
+
+    // The first parse writes the index, the second one loads it
+    auto Fresh = parseSymbols(false);
+    parseSymbols(true);
+    ASSERT_FALSE(std::filesystem::is_empty(CacheDirectory));
+    auto Reloaded = parseSymbols(true);
+
+    ASSERT_FALSE(Fresh.empty());
+    ASSERT_EQ(Reloaded.size(), Fresh.size());
+    for (size_t i = 0; i < Fresh.size(); ++i)
+    {
+        auto &Expected = Fresh[i];
+        auto &Actual = Reloaded[i];
+        EXPECT_EQ(Actual.name, Expected.name);
+        EXPECT_EQ(Actual.internal_name, Expected.internal_name);
+        EXPECT_EQ(Actual.rva, Expected.rva);
+        EXPECT_EQ(Actual.size, Expected.size);
+        EXPECT_EQ(Actual.cbFrame, Expected.cbFrame);
+        EXPECT_EQ(Actual.cbPad, Expected.cbPad);
+        EXPECT_EQ(Actual.offPad, Expected.offPad);
+        EXPECT_EQ(Actual.cbSaveRegs, Expected.cbSaveRegs);
+        EXPECT_EQ(Actual.offExHdlr, Expected.offExHdlr);
+        EXPECT_EQ(Actual.sectExHdlr, Expected.sectExHdlr);
+        EXPECT_EQ(Actual.hasAlloca, Expected.hasAlloca);
+        EXPECT_EQ(Actual.hasSetJmp, Expected.hasSetJmp);
+        EXPECT_EQ(Actual.hasLongJmp, Expected.hasLongJmp);
+        EXPECT_EQ(Actual.hasInlAsm, Expected.hasInlAsm);
+        EXPECT_EQ(Actual.hasEH, Expected.hasEH);
+        EXPECT_EQ(Actual.hasSEH, Expected.hasSEH);
+        EXPECT_EQ(Actual.hasNaked, Expected.hasNaked);
+        EXPECT_EQ(Actual.hasSecurityChecks, Expected.hasSecurityChecks);
+        EXPECT_EQ(Actual.hasAsyncEH, Expected.hasAsyncEH);
+        EXPECT_EQ(Actual.hasWasInlined, Expected.hasWasInlined);
+        EXPECT_EQ(Actual.hasGSCheck, Expected.hasGSCheck);
+        EXPECT_EQ(Actual.hasSafeBuffers, Expected.hasSafeBuffers);
+        EXPECT_EQ(Actual.hasOptSpeed, Expected.hasOptSpeed);
+        EXPECT_EQ(Actual.hasGuardCF, Expected.hasGuardCF);
+    }
+
+    std::filesystem::remove_all(CacheDirectory);
+}
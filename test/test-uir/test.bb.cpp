@@ -1,7 +1,9 @@
 #include <UnknownIR.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <format>
 #include <iostream>
+#include <vector>
 
 using namespace uir;
 
@@ -20,13 +22,172 @@ TEST(test_uir, test_uir_bb_1)
         IBR.setInsertPoint(ret1);
         auto ret2 = IBR.createRetVoid(0x401007);
 
-        for (auto I : BB1)
+        for (auto &I : BB1)
         {
-            unknown::outs() << *I;
+            unknown::outs() << I;
         }
 
         unknown::outs() << BB1;
     }
 
     std::cout << "--------------------bp-----------------------" << std::endl;
-}
\ No newline at end of file
+}
+
+TEST(test_uir, test_uir_bb_2)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // A pass that rewrites every instruction of a large block
+    const size_t InstCount = 1 << 16;
+    BasicBlock BB(CTX, "bb1", 0x401000, 0x401000 + InstCount);
+
+    IRBuilder IRB(&BB);
+    std::vector<Instruction *> InstList;
+    InstList.reserve(InstCount);
+    for (size_t i = 0; i < InstCount; ++i)
+    {
+        InstList.push_back(IRB.createRetVoid(0x401000 + i));
+    }
+
+    auto Begin = std::chrono::steady_clock::now();
+    for (auto Inst : InstList)
+    {
+        // Insert a new instruction before the old one and erase the old one
+        IRB.setInsertPoint(Inst);
+        IRB.createRetVoid(Inst->getInstructionAddress());
+        Inst->eraseFromParent();
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(BB.size(), InstCount);
+
+    uint64_t Address = 0x401000;
+    for (auto &I : BB)
+    {
+        EXPECT_EQ(I.getInstructionAddress(), Address++);
+        EXPECT_EQ(I.getParent(), &BB);
+    }
+
+    double Seconds = std::chrono::duration<double>(End - Begin).count();
+    std::cout << std::format("rewrote {} instructions in {}s", InstCount, Seconds) << std::endl;
+}
+
+TEST(test_uir, test_uir_bb_3)
+{
+    // The anonymous blocks are numbered by their function, building two contexts on one thread doesn't restart it
+    Context CTX1;
+    CTX1.setArch(Context::Arch::ArchX86);
+    CTX1.setMode(Context::Mode::Mode64);
+    Context CTX2;
+    CTX2.setArch(Context::Arch::ArchX86);
+    CTX2.setMode(Context::Mode::Mode64);
+
+    Function F1(CTX1, "func1");
+    Function F2(CTX2, "func2");
+    for (uint64_t i = 0; i < 3; ++i)
+    {
+        F1.insertBasicBlock(BasicBlock::create(CTX1, "", 0x401000 + i, 0x401001 + i, &F1));
+        F2.insertBasicBlock(BasicBlock::create(CTX2, "", 0x402000 + i, 0x402001 + i, &F2));
+    }
+
+    // A block created without a function is numbered when it joins one
+    F1.insertBasicBlock(BasicBlock::create(CTX1));
+
+    std::vector<std::string> Names1;
+    for (auto BB : F1)
+    {
+        Names1.push_back(BB->getBasicBlockName());
+    }
+    std::vector<std::string> Names2;
+    for (auto BB : F2)
+    {
+        Names2.push_back(BB->getBasicBlockName());
+    }
+
+    EXPECT_EQ(Names1, (std::vector<std::string>{"0", "1", "2", "3"}));
+    EXPECT_EQ(Names2, (std::vector<std::string>{"0", "1", "2"}));
+}
+
+TEST(test_uir, test_uir_bb_4)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // The blocks are unlinked from their function in constant time
+    const size_t BlockCount = 1 << 14;
+    Function F(CTX, "func1");
+    std::vector<BasicBlock *> Blocks;
+    for (size_t i = 0; i < BlockCount; ++i)
+    {
+        Blocks.push_back(BasicBlock::create(CTX, "", 0x401000 + i, 0x401001 + i, &F));
+        F.insertBasicBlock(Blocks.back());
+    }
+
+    auto Begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < BlockCount; i += 2)
+    {
+        Blocks[i]->eraseFromParent();
+    }
+    auto End = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(F.size(), BlockCount / 2);
+    uint64_t Address = 0x401001;
+    for (auto BB : F)
+    {
+        EXPECT_EQ(BB->getParent(), &F);
+        EXPECT_EQ(BB->getBasicBlockAddressBegin(), Address);
+        Address += 2;
+    }
+
+    // A removed block is unlinked but kept
+    auto Last = Blocks[BlockCount - 1];
+    Last->removeFromParent();
+    EXPECT_EQ(Last->getParent(), nullptr);
+    EXPECT_EQ(F.size(), BlockCount / 2 - 1);
+
+    Last->insertBefore(&F.front());
+    EXPECT_EQ(&F.front(), Last);
+    EXPECT_EQ(Last->getParent(), &F);
+
+    std::cout << std::format(
+                     "eraseFromParent: {} blocks in {}us",
+                     BlockCount / 2,
+                     std::chrono::duration_cast<std::chrono::microseconds>(End - Begin).count())
+              << std::endl;
+}
+
+TEST(test_uir, test_uir_bb_5)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // A block created with a parent isn't linked until the parent inserts it
+    Function F(CTX, "func1");
+    auto Head = BasicBlock::create(CTX, "head", 0x401000, 0x401001, &F);
+    F.insertBasicBlock(Head);
+
+    auto Pending = BasicBlock::create(CTX, "pending", 0x401001, 0x401002, &F);
+    EXPECT_EQ(Pending->getParent(), &F);
+    Pending->removeFromParent();
+    EXPECT_EQ(Pending->getParent(), nullptr);
+    EXPECT_EQ(F.size(), 1u);
+
+    // The unlinked block is no insert position, it can be inserted itself
+    auto Other = BasicBlock::create(CTX, "other", 0x401002, 0x401003);
+    Other->setParent(&F);
+    Pending->insertAfter(Other);
+    EXPECT_EQ(Pending->getParent(), nullptr);
+
+    Other->insertAfter(Head);
+    Pending->insertAfter(Other);
+    EXPECT_EQ(F.size(), 3u);
+    EXPECT_EQ(&F.back(), Pending);
+
+    auto Unlinked = BasicBlock::create(CTX, "unlinked", 0x401003, 0x401004, &F);
+    Unlinked->eraseFromParent();
+    EXPECT_EQ(F.size(), 3u);
+}
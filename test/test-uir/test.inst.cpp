@@ -214,3 +214,56 @@ TEST(test_uir, test_uir_inst_Load_1)
         std::cout << std::format("Op = {}", Op->getName()) << std::endl;
     }
 }
+
+TEST(test_uir, test_uir_inst_Add_1)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    std::cout << std::format("AddComponent = {}", AddComponent.mOpCodeName.data()) << std::endl;
+
+    auto Ptr = LocalVariable::get(Type::getInt32PtrTy(CTX), "ptr1", 0x601000);
+    auto LoadInst = LoadInstruction::get(Ptr);
+    auto Imm = ConstantInt::get(Type::getInt32Ty(CTX), unknown::APInt(32, 8));
+
+    auto FlagsVar = FlagsVariable::get(CTX);
+    FlagsVar->setCarryFlag(true);
+    FlagsVar->setZeroFlag(true);
+
+    auto AddInst = AddInstruction::get(LoadInst, Imm, FlagsVar);
+    AddInst->setInstructionAddress(0x401000);
+    AddInst->enablePrintOp();
+    AddInst->print(unknown::outs());
+    unknown::outs() << *AddInst;
+
+    EXPECT_TRUE(unknown::isa<BinaryInstruction>(AddInst));
+    EXPECT_EQ(AddInst->getType(), Type::getInt32Ty(CTX));
+    EXPECT_EQ(AddInst->getLHS(), LoadInst);
+    EXPECT_EQ(AddInst->getRHS(), Imm);
+    EXPECT_EQ(AddInst->getFlagsVariable(), FlagsVar);
+}
+
+TEST(test_uir, test_uir_inst_Sub_1)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    std::cout << std::format("SubComponent = {}", SubComponent.mOpCodeName.data()) << std::endl;
+
+    auto Ptr = LocalVariable::get(Type::getInt64PtrTy(CTX), "rsp", 0);
+    auto LoadInst = LoadInstruction::get(Ptr);
+    auto Imm = ConstantInt::get(Type::getInt64Ty(CTX), unknown::APInt(64, 8));
+
+    // The stack pointer is updated without the flags
+    auto SubInst = SubInstruction::get(LoadInst, Imm, nullptr);
+    SubInst->setInstructionAddress(0x401000);
+    SubInst->enablePrintOp();
+    SubInst->print(unknown::outs());
+    unknown::outs() << *SubInst;
+
+    EXPECT_TRUE(unknown::isa<BinaryInstruction>(SubInst));
+    EXPECT_FALSE(unknown::isa<AddInstruction>(SubInst));
+    EXPECT_EQ(SubInst->getFlagsVariable(), nullptr);
+}
@@ -1,7 +1,9 @@
 #include <UnknownIR.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <format>
 #include <iostream>
+#include <vector>
 
 using namespace uir;
 
@@ -51,4 +53,553 @@ TEST(test_uir, test_uir_module_1)
     }
 
     std::cout << "--------------------bp-----------------------" << std::endl;
-}
\ No newline at end of file
+}
+
+TEST(test_uir, test_uir_module_2)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // A large module: every block has some loads and stores and ends with a terminator
+    const size_t FunctionCount = 256;
+    const size_t BlockCount = 64;
+    const size_t MemInstCount = 8;
+
+    Module module(CTX, "mod2");
+    uint64_t Address = 0x401000;
+    for (size_t i = 0; i < FunctionCount; ++i)
+    {
+        Function *F = Function::get(CTX, std::format("func{}", i).c_str());
+        GlobalVariable *GV = GlobalVariable::get(Type::getInt32PtrTy(CTX), std::format("gv{}", i).c_str(), 0x601000 + i);
+        module.insertGlobalVariable(GV);
+
+        for (size_t j = 0; j < BlockCount; ++j)
+        {
+            BasicBlock *BB = BasicBlock::get(CTX, std::format("bb{}", j).c_str(), Address, Address);
+            for (size_t k = 0; k < MemInstCount; ++k)
+            {
+                if (k % 2 == 0)
+                {
+                    BB->insertInst(LoadInstruction::get(GV));
+                }
+                else
+                {
+                    BB->insertInst(StoreInstruction::get(CTX, ConstantInt::get(CTX, unknown::APInt(32, k)), GV));
+                }
+            }
+
+            if (j + 1 == BlockCount)
+            {
+                BB->insertInst(ReturnInstruction::get(CTX));
+            }
+            else
+            {
+                BB->insertInst(JmpAddrInstruction::get(CTX, ConstantInt::get(CTX, unknown::APInt(64, Address + 1))));
+            }
+
+            Address += 1;
+            F->insertBasicBlock(BB);
+        }
+
+        module.insertFunction(F);
+    }
+
+    // A pass that classifies every instruction of the module
+    struct DispatchCount
+    {
+        size_t Loads = 0;
+        size_t Stores = 0;
+        size_t Terminators = 0;
+        size_t Others = 0;
+    };
+
+    auto runPass = [&](auto &&Classify) {
+        DispatchCount Count;
+        auto Begin = std::chrono::steady_clock::now();
+        for (int Round = 0; Round < 16; ++Round)
+        {
+            for (auto F : module)
+            {
+                for (auto BB : *F)
+                {
+                    for (auto &I : *BB)
+                    {
+                        Classify(static_cast<Value *>(&I), Count);
+                    }
+                }
+            }
+        }
+        auto End = std::chrono::steady_clock::now();
+        return std::make_pair(Count, std::chrono::duration<double, std::micro>(End - Begin).count());
+    };
+
+    auto [RTTICount, RTTITime] = runPass([](Value *V, DispatchCount &Count) {
+        if (dynamic_cast<LoadInstruction *>(V))
+        {
+            ++Count.Loads;
+        }
+        else if (dynamic_cast<StoreInstruction *>(V))
+        {
+            ++Count.Stores;
+        }
+        else if (dynamic_cast<TerminatorInstruction *>(V))
+        {
+            ++Count.Terminators;
+        }
+        else
+        {
+            ++Count.Others;
+        }
+    });
+
+    auto [ClassofCount, ClassofTime] = runPass([](Value *V, DispatchCount &Count) {
+        if (unknown::isa<LoadInstruction>(V))
+        {
+            ++Count.Loads;
+        }
+        else if (unknown::isa<StoreInstruction>(V))
+        {
+            ++Count.Stores;
+        }
+        else if (unknown::isa<TerminatorInstruction>(V))
+        {
+            ++Count.Terminators;
+        }
+        else
+        {
+            ++Count.Others;
+        }
+    });
+
+    const size_t BlockTotal = 16 * FunctionCount * BlockCount;
+    EXPECT_EQ(ClassofCount.Loads, RTTICount.Loads);
+    EXPECT_EQ(ClassofCount.Stores, RTTICount.Stores);
+    EXPECT_EQ(ClassofCount.Terminators, RTTICount.Terminators);
+    EXPECT_EQ(ClassofCount.Loads, BlockTotal * MemInstCount / 2);
+    EXPECT_EQ(ClassofCount.Terminators, BlockTotal);
+    EXPECT_EQ(ClassofCount.Others, 0u);
+
+    std::cout << std::format("dynamic_cast dispatch: {:.0f}us, classof dispatch: {:.0f}us", RTTITime, ClassofTime)
+              << std::endl;
+}
+
+TEST(test_uir, test_uir_module_3)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    Module module(CTX, "mod3");
+
+    // Functions are 0x10 bytes long with a gap of 0x10 bytes between them
+    const size_t FunctionCount = 1024;
+    std::vector<Function *> Functions;
+    for (size_t i = 0; i < FunctionCount; ++i)
+    {
+        uint64_t Begin = 0x401000 + i * 0x20;
+        Function *F = Function::get(CTX, std::format("func{}", i).c_str(), nullptr, Begin, Begin + 0x10);
+        module.insertFunction(F);
+        Functions.push_back(F);
+    }
+
+    auto GV = GlobalVariable::get(Type::getInt64PtrTy(CTX), "gv1", 0x601000);
+    module.insertGlobalVariable(GV);
+
+    // By name
+    EXPECT_EQ(module.getFunction("func7").value_or(nullptr), Functions[7]);
+    EXPECT_FALSE(module.getFunction("func_none").has_value());
+    EXPECT_EQ(module.getGlobalVariable("gv1").value_or(nullptr), GV);
+
+    // By begin address
+    EXPECT_EQ(module.getFunction(0x401000 + 5 * 0x20).value_or(nullptr), Functions[5]);
+    EXPECT_FALSE(module.getFunction(0x401001).has_value());
+
+    // By containing address
+    EXPECT_EQ(module.getFunctionContaining(0x401000 + 5 * 0x20 + 0xF).value_or(nullptr), Functions[5]);
+    EXPECT_FALSE(module.getFunctionContaining(0x401000 + 5 * 0x20 + 0x10).has_value());
+    EXPECT_FALSE(module.getFunctionContaining(0x400000).has_value());
+    EXPECT_EQ(module.getGlobalVariableContaining(0x601007).value_or(nullptr), GV);
+    EXPECT_FALSE(module.getGlobalVariableContaining(0x601008).has_value());
+
+    // The indexes follow the address and the parent
+    Functions[5]->setFunctionBeginAddress(0x401000 + 5 * 0x20 + 0x4);
+    EXPECT_FALSE(module.getFunction(0x401000 + 5 * 0x20).has_value());
+    EXPECT_EQ(module.getFunction(0x401000 + 5 * 0x20 + 0x4).value_or(nullptr), Functions[5]);
+
+    Functions[7]->removeFromParent();
+    EXPECT_FALSE(module.getFunction("func7").has_value());
+    EXPECT_FALSE(module.getFunctionContaining(0x401000 + 7 * 0x20).has_value());
+    EXPECT_EQ(module.size(), FunctionCount - 1);
+
+    module.insertFunction(Functions[7]);
+    EXPECT_EQ(module.getFunction("func7").value_or(nullptr), Functions[7]);
+
+    // The name index follows the renames
+    Functions[8]->setName("func8_renamed");
+    EXPECT_FALSE(module.getFunction("func8").has_value());
+    EXPECT_EQ(module.getFunction("func8_renamed").value_or(nullptr), Functions[8]);
+
+    Functions[9]->setFunctionName("func9_renamed");
+    EXPECT_FALSE(module.getFunction("func9").has_value());
+    EXPECT_EQ(module.getFunction("func9_renamed").value_or(nullptr), Functions[9]);
+
+    GV->setName("gv1_renamed");
+    EXPECT_FALSE(module.getGlobalVariable("gv1").has_value());
+    EXPECT_EQ(module.getGlobalVariable("gv1_renamed").value_or(nullptr), GV);
+
+    // Removing the indexed one of two values with the same key exposes the other one
+    Function *Dup = Function::get(CTX, "func10", nullptr, 0x401000 + 10 * 0x20, 0x401000 + 10 * 0x20 + 0x10);
+    module.insertFunction(Dup);
+    EXPECT_EQ(module.getFunction("func10").value_or(nullptr), Functions[10]);
+
+    Functions[10]->removeFromParent();
+    EXPECT_EQ(module.getFunction("func10").value_or(nullptr), Dup);
+    EXPECT_EQ(module.getFunction(0x401000 + 10 * 0x20).value_or(nullptr), Dup);
+    module.insertFunction(Functions[10]);
+
+    Functions[11]->setName("func10");
+    Dup->removeFromParent();
+    EXPECT_EQ(module.getFunction("func10").value_or(nullptr), Functions[11]);
+    EXPECT_EQ(module.getFunction(0x401000 + 10 * 0x20).value_or(nullptr), Functions[10]);
+    delete Dup;
+
+    auto GV2 = GlobalVariable::get(Type::getInt64PtrTy(CTX), "gv1_renamed", 0x601000);
+    module.insertGlobalVariable(GV2);
+    GV->removeFromParent();
+    EXPECT_EQ(module.getGlobalVariable("gv1_renamed").value_or(nullptr), GV2);
+    EXPECT_EQ(module.getGlobalVariableContaining(0x601000).value_or(nullptr), GV2);
+    module.insertGlobalVariable(GV);
+}
+
+TEST(test_uir, test_uir_module_4)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    const size_t FunctionCount = 256;
+    const size_t BlockCount = 32;
+    const size_t MemInstCount = 16;
+
+    // Every value in an arena takes its size plus the word recording the arena
+    const size_t ValueHeaderSize = sizeof(void *);
+    const size_t FunctionArenaBytes =
+        BlockCount * (sizeof(BasicBlock) + ValueHeaderSize + sizeof(ReturnInstruction) + ValueHeaderSize +
+                      MemInstCount * (sizeof(LoadInstruction) + sizeof(StoreInstruction) + 2 * ValueHeaderSize));
+    const size_t ModuleArenaBytes = FunctionCount * (sizeof(Function) + ValueHeaderSize);
+
+    // Build a module with the IRBuilder and measure how long it takes to free it
+    auto buildAndFree = [&](bool EnableArena) {
+        auto M = Module::get(CTX, "mod4");
+        if (EnableArena)
+        {
+            M->enableArena();
+        }
+
+        uint64_t Address = 0x401000;
+        for (size_t i = 0; i < FunctionCount; ++i)
+        {
+            Function *F = Function::get(CTX, std::format("func{}", i).c_str(), M.get(), Address);
+            EXPECT_EQ(F->getArena() != nullptr, EnableArena);
+
+            GlobalVariable *GV =
+                GlobalVariable::get(Type::getInt32PtrTy(CTX), std::format("gv{}", i).c_str(), 0x601000 + i * 4);
+            M->insertGlobalVariable(GV);
+
+            for (size_t j = 0; j < BlockCount; ++j)
+            {
+                BasicBlock *BB = BasicBlock::create(CTX, std::format("bb{}", j).c_str(), Address, Address, F);
+                F->insertBasicBlock(BB);
+
+                IRBuilder IRB(BB);
+                for (size_t k = 0; k < MemInstCount; ++k)
+                {
+                    auto Load = IRB.createLoad(GV, Address++);
+                    IRB.createStore(Load, GV, Address++);
+                }
+                IRB.createRetVoid(Address++);
+            }
+
+            M->insertFunction(F);
+
+            // The blocks and the instructions are allocated in the arena of the function and nowhere else
+            if (EnableArena)
+            {
+                EXPECT_EQ(F->getArena()->getBytesAllocated(), FunctionArenaBytes);
+            }
+        }
+
+        // The functions are allocated in the arena of the module
+        if (EnableArena)
+        {
+            EXPECT_EQ(M->getArena()->getBytesAllocated(), ModuleArenaBytes);
+        }
+        else
+        {
+            EXPECT_EQ(M->getArena(), nullptr);
+        }
+
+        auto Begin = std::chrono::steady_clock::now();
+        M.reset();
+        auto End = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(End - Begin).count();
+    };
+
+    auto HeapTime = buildAndFree(false);
+    auto ArenaTime = buildAndFree(true);
+    std::cout << std::format("free heap module: {:.1f}ms, free arena module: {:.1f}ms", HeapTime, ArenaTime)
+              << std::endl;
+}
+
+TEST(test_uir, test_uir_module_5)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    auto M = Module::get(CTX, "mod5");
+    GlobalVariable *GV = GlobalVariable::get(Type::getInt32PtrTy(CTX), "gv1", 0x601000);
+    GV->setComment("global");
+    M->insertGlobalVariable(GV);
+
+    auto GA = GlobalArray<uint16_t>::get(CTX, Type::getInt16Ty(CTX), {0x1, 0xABCD, 0x3}, "ga1", 0x602000);
+    M->insertGlobalVariable(GA);
+
+    Function *F = Function::get(CTX, "func1", M.get(), 0x401000, 0x401020);
+    F->addFnAttr("noreturn");
+    F->setSEH(true);
+    F->insertArgument(Argument::get(Type::getInt32Ty(CTX), "arg1", F, 0));
+    F->insertFunctionContext(FunctionContext::get(Type::getInt64Ty(CTX), "rsp", F, 0));
+
+    BasicBlock *BB1 = BasicBlock::create(CTX, "bb1", 0x401000, 0x401010, F);
+    BasicBlock *BB2 = BasicBlock::create(CTX, "bb2", 0x401010, 0x401020, F);
+    F->insertBasicBlock(BB1);
+    F->insertBasicBlock(BB2);
+    BB2->getPredecessorsList().push_back(BB1);
+
+    // The load of bb2 is stored in bb1, it is a forward reference
+    IRBuilder IRB2(BB2);
+    auto Load = IRB2.createLoad(GV, 0x401010);
+    Load->addExtraInfo("forward");
+    IRB2.createUnknown("cpuid", 0x401012);
+    IRB2.createRetImm(ConstantInt::get(CTX, unknown::APInt(16, 8)), 0x401014);
+
+    IRBuilder IRB1(BB1);
+    auto GBP = IRB1.createGetBitPtr(Type::getInt8PtrTy(CTX), GV, ConstantInt::get(CTX, unknown::APInt(32, 3)), 0x401000);
+    IRB1.createStore(Load, GV, 0x401004);
+    IRB1.createStore(ConstantInt::get(CTX, unknown::APInt(8, 0xFF)), GBP, 0x401008);
+    IRB1.createJmpBB(BB2, 0x40100C);
+
+    M->insertFunction(F);
+
+    // Write the module into memory
+    unknown::SmallVector<char, 0> Buffer;
+    unknown::raw_svector_ostream OS(Buffer);
+    ModuleWriter Writer(*M);
+    ASSERT_TRUE(Writer.write(OS)) << Writer.getErrorMessage();
+    std::cout << std::format("binary module: {} bytes", Buffer.size()) << std::endl;
+
+    // Read it back, the body is decoded on demand
+    ModuleReader Reader(
+        CTX, unknown::MemoryBuffer::getMemBuffer(unknown::StringRef(Buffer.data(), Buffer.size()), "mod5", false));
+    ASSERT_TRUE(Reader.parse()) << Reader.getErrorMessage();
+    EXPECT_EQ(Reader.getNumFunctions(), 1u);
+    EXPECT_EQ(Reader.getFunctionName(0), "func1");
+    EXPECT_EQ(Reader.getModule()->size(), 0u);
+    EXPECT_FALSE(Reader.materializeFunction("func2").has_value());
+
+    auto Func1 = Reader.materializeFunction("func1");
+    ASSERT_TRUE(Func1.has_value() && *Func1) << Reader.getErrorMessage();
+    EXPECT_EQ((*Func1)->size(), 2u);
+    EXPECT_TRUE((*Func1)->hasSEH());
+    EXPECT_TRUE((*Func1)->hasFnAttr("noreturn"));
+    EXPECT_EQ((*Func1)->back().getPredecessorsList().size(), 1u);
+    EXPECT_EQ((*Func1)->back().front().getExtraInfoList().size(), 1u);
+
+    auto ReadModule = Reader.takeModule();
+    EXPECT_EQ(ReadModule->global_size(), 2u);
+
+    // The elements of the global array are read back
+    auto ReadGA = dynamic_cast<GlobalArray<uint16_t> *>(ReadModule->getGlobalVariable("ga1").value_or(nullptr));
+    ASSERT_NE(ReadGA, nullptr);
+    EXPECT_EQ(ReadGA->getGlobalArray(), GA->getGlobalArray());
+    EXPECT_EQ(ReadGA->getGlobalVariableAddress(), 0x602000u);
+
+    // The printed modules are the same
+    std::string Printed, ReadPrinted;
+    unknown::raw_string_ostream PrintedOS(Printed), ReadPrintedOS(ReadPrinted);
+    M->print(PrintedOS);
+    ReadModule->print(ReadPrintedOS);
+    PrintedOS.flush();
+    ReadPrintedOS.flush();
+    EXPECT_EQ(Printed, ReadPrinted);
+    std::cout << ReadPrinted << std::endl;
+}
+
+TEST(test_uir, test_uir_module_6)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    auto M = Module::get(CTX, "mod6");
+    GlobalVariable *GV = GlobalVariable::get(Type::getInt32PtrTy(CTX), "gv1", 0x0);
+    M->insertGlobalVariable(GV);
+
+    Function *F = Function::get(CTX, "func1", M.get(), 0x401000, 0x401010);
+    F->addFnAttr("noreturn");
+    F->addFnAttr("naked");
+    F->insertArgument(Argument::get(Type::getInt32Ty(CTX), "arg1", F, 7));
+    F->insertFunctionContext(FunctionContext::get(Type::getInt64Ty(CTX), "rsp", F, 12));
+
+    BasicBlock *BB1 = BasicBlock::create(CTX, "bb1", 0x401000, 0x401010, F);
+    F->insertBasicBlock(BB1);
+
+    IRBuilder IRB(BB1);
+    auto Load = IRB.createLoad(GV, 0x401000);
+    Load->setComment("<load>");
+    IRB.createStore(ConstantInt::get(CTX, unknown::APInt(128, 0xABCDEF)), GV, 0x401004);
+    IRB.createRetImm(ConstantInt::get(CTX, unknown::APInt(16, 8)), 0x40100F);
+    M->insertFunction(F);
+
+    // The streamed output is the same as the one of the in-memory printer
+    unknown::XMLPrinter Printer;
+    M->print(Printer);
+
+    std::string Streamed;
+    unknown::raw_string_ostream OS(Streamed);
+    M->print(OS);
+    OS.flush();
+
+    EXPECT_EQ(Streamed, std::string(Printer.CStr()));
+    EXPECT_NE(Streamed.find("range=\"0x401000-0x401010\""), std::string::npos);
+    EXPECT_NE(Streamed.find("addr=\"0x0\""), std::string::npos);
+    EXPECT_NE(Streamed.find("argno=\"7\""), std::string::npos);
+    std::cout << Streamed << std::endl;
+
+    // The addresses with the hex letters are printed as std::format("0x{:X}") printed them
+    auto HexM = Module::get(CTX, "mod6_hex");
+    const uint64_t GVAddress = 0xDEADBEEF;
+    const uint64_t Begin = 0x4FA0B0;
+    const uint64_t End = 0x4FA0CE;
+    HexM->insertGlobalVariable(GlobalVariable::get(Type::getInt32PtrTy(CTX), "gv1", GVAddress));
+
+    Function *HexF = Function::get(CTX, "func1", HexM.get(), Begin, End);
+    BasicBlock *HexBB = BasicBlock::create(CTX, "bb1", Begin, End, HexF);
+    HexF->insertBasicBlock(HexBB);
+    IRBuilder(HexBB).createRetVoid(0x4FA0CD);
+    HexM->insertFunction(HexF);
+
+    std::string HexStreamed;
+    unknown::raw_string_ostream HexOS(HexStreamed);
+    HexM->print(HexOS);
+    HexOS.flush();
+
+    auto Golden = std::format(
+        "<module name=\"module.mod6_hex\" arch=\"x86\" mode=\"64\">\n"
+        "    <gv name=\"@gv1 i32*\" addr=\"0x{:X}\"/>\n"
+        "    <f name=\"function.func1\" range=\"0x{:X}-0x{:X}\" attributes=\"\">\n"
+        "        <bb name=\"block.bb1\" range=\"0x{:X}-0x{:X}\">\n"
+        "            <i addr=\"0x{:X}\" name=\"uir.ret\"/>\n"
+        "        </bb>\n"
+        "    </f>\n"
+        "</module>\n",
+        GVAddress,
+        Begin,
+        End,
+        Begin,
+        End,
+        0x4FA0CD);
+    EXPECT_EQ(HexStreamed, Golden);
+}
+
+TEST(test_uir, test_uir_module_7)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // The names of the anonymous values are given when they are printed, so each printer gets its own module
+    auto buildModule = [&]() {
+        auto M = Module::get(CTX, "mod7");
+        GlobalVariable *GV = GlobalVariable::get(Type::getInt32PtrTy(CTX), "gv1", 0x601000);
+        M->insertGlobalVariable(GV);
+
+        for (uint64_t i = 0; i < 64; ++i)
+        {
+            uint64_t Address = 0x401000 + i * 0x10;
+            Function *F = Function::get(CTX, std::format("func{}", i), M.get(), Address, Address + 0x10);
+            BasicBlock *BB = BasicBlock::create(CTX, "", Address, Address + 0x10, F);
+            F->insertBasicBlock(BB);
+
+            // The anonymous locals are numbered per function
+            IRBuilder IRB(BB);
+            auto Load = IRB.createLoad(GV, Address);
+            IRB.createStore(Load, GV, Address + 4);
+            IRB.createRetVoid(Address + 8);
+            M->insertFunction(F);
+        }
+        return M;
+    };
+
+    // The functions printed on the thread pool are written in module order
+    auto SerialM = buildModule();
+    auto ParallelM = buildModule();
+    std::string Parallel, Serial;
+    unknown::raw_string_ostream ParallelOS(Parallel), SerialOS(Serial);
+    SerialM->print(SerialOS);
+    ParallelM->printParallel(ParallelOS, 4);
+    ParallelOS.flush();
+    SerialOS.flush();
+    EXPECT_EQ(Parallel, Serial);
+    EXPECT_LT(Parallel.find("function.func0"), Parallel.find("function.func63"));
+    EXPECT_NE(Parallel.find("name=\"%0 i32=uir.load @gv1 i32*\""), std::string::npos);
+}
+
+TEST(test_uir, test_uir_module_8)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // The argument and the block of another function can't be referenced in the container
+    auto M = Module::get(CTX, "mod8");
+    Function *F1 = Function::get(CTX, "func1", M.get(), 0x401000, 0x401010);
+    Function *F2 = Function::get(CTX, "func2", M.get(), 0x401010, 0x401020);
+    auto Arg = Argument::get(Type::getInt32PtrTy(CTX), "arg1", F2, 0);
+    F2->insertArgument(Arg);
+    BasicBlock *BB1 = BasicBlock::create(CTX, "bb1", 0x401000, 0x401010, F1);
+    BasicBlock *BB2 = BasicBlock::create(CTX, "bb2", 0x401010, 0x401020, F2);
+    F1->insertBasicBlock(BB1);
+    F2->insertBasicBlock(BB2);
+    IRBuilder IRB1(BB1);
+    IRB1.createLoad(Arg, 0x401000);
+    IRB1.createRetVoid(0x401004);
+    IRBuilder(BB2).createJmpBB(BB1, 0x401010);
+    M->insertFunction(F1);
+    M->insertFunction(F2);
+
+    unknown::SmallVector<char, 0> Buffer;
+    unknown::raw_svector_ostream OS(Buffer);
+    ModuleWriter Writer(*M);
+    EXPECT_FALSE(Writer.write(OS));
+    EXPECT_EQ(Writer.getErrorMessage(), "unresolved operand in the function func1");
+    EXPECT_TRUE(Buffer.empty());
+
+    // The function which jumps out is written alone
+    ModuleWriter Writer1(*F2);
+    EXPECT_FALSE(Writer1.write(OS));
+    EXPECT_EQ(Writer1.getErrorMessage(), "successor out of the function func2");
+    EXPECT_TRUE(Buffer.empty());
+
+    // The pointers of the host in a global array are not written
+    auto M2 = Module::get(CTX, "mod8_2");
+    int Host = 0;
+    M2->insertGlobalVariable(GlobalArray<int *>::get(CTX, Type::getInt64Ty(CTX), {&Host}, "ga1", 0x602000));
+
+    ModuleWriter Writer2(*M2);
+    EXPECT_FALSE(Writer2.write(OS));
+    EXPECT_EQ(Writer2.getErrorMessage(), "the elements of the global array ga1 can't be written");
+    EXPECT_TRUE(Buffer.empty());
+}
@@ -1,7 +1,9 @@
 #include <UnknownIR.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <format>
 #include <iostream>
+#include <thread>
 
 using namespace uir;
 
@@ -140,3 +142,77 @@ TEST(test_uir, test_uir_type_5)
         std::cout << std::format("GA->getGlobalArray({}) = 0x{:X}", i, GA->getGlobalArray()[i]) << std::endl;
     }
 }
+
+TEST(test_uir, test_uir_type_6)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // Contention of the uniquing tables in the context
+    const uint32_t Iterations = 100000;
+    for (uint32_t ThreadCount = 1; ThreadCount <= 32; ThreadCount *= 2)
+    {
+        auto Begin = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> Threads;
+        for (uint32_t i = 0; i < ThreadCount; ++i)
+        {
+            Threads.emplace_back([&CTX, i]() {
+                for (uint32_t j = 0; j < Iterations; ++j)
+                {
+                    uint32_t Bits = 8u << (j % 6);
+                    auto IntTy = Type::getIntNTy(CTX, Bits);
+                    auto PtrTy = Type::getIntNPtrTy(CTX, Bits);
+                    auto CI = ConstantInt::get(CTX, unknown::APInt(Bits, (i + j) % 1024));
+                    EXPECT_EQ(IntTy->getTypeBits(), Bits);
+                    EXPECT_EQ(PtrTy->getElementTypeBits(), Bits);
+                    EXPECT_EQ(CI->getType(), IntTy);
+                }
+            });
+        }
+
+        for (auto &T : Threads)
+        {
+            T.join();
+        }
+
+        auto End = std::chrono::steady_clock::now();
+        double Seconds = std::chrono::duration<double>(End - Begin).count();
+        std::cout << std::format(
+                         "threads = {}, {:.0f} lookups/sec",
+                         ThreadCount,
+                         ThreadCount * Iterations * 3 / (Seconds > 0 ? Seconds : 1))
+                  << std::endl;
+    }
+}
+
+TEST(test_uir, test_uir_type_7)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // The built-in integer types are returned by IntegerType::get
+    EXPECT_EQ(IntegerType::get(CTX, 1), Type::getInt1Ty(CTX));
+    EXPECT_EQ(IntegerType::get(CTX, 8), Type::getInt8Ty(CTX));
+    EXPECT_EQ(IntegerType::get(CTX, 16), Type::getInt16Ty(CTX));
+    EXPECT_EQ(IntegerType::get(CTX, 32), Type::getInt32Ty(CTX));
+    EXPECT_EQ(IntegerType::get(CTX, 64), Type::getInt64Ty(CTX));
+    EXPECT_EQ(IntegerType::get(CTX, 128), Type::getInt128Ty(CTX));
+
+    // The other widths are uniqued
+    auto Int256Ty = IntegerType::get(CTX, 256);
+    EXPECT_EQ(Int256Ty, IntegerType::get(CTX, 256));
+    EXPECT_EQ(Int256Ty->getTypeName(), "i256");
+    auto Int4096Ty = IntegerType::get(CTX, 4096);
+    EXPECT_EQ(Int4096Ty, IntegerType::get(CTX, 4096));
+
+    // The pointer types are uniqued
+    EXPECT_EQ(Type::getInt8PtrTy(CTX), PointerType::get(CTX, Type::getInt8Ty(CTX)));
+    EXPECT_EQ(Type::getIntNPtrTy(CTX, 256), Int256Ty->getPointerTo());
+    EXPECT_EQ(Type::getIntNPtrTy(CTX, 256)->getTypeName(), "i256*");
+    auto PtrPtrTy = PointerType::get(CTX, Type::getInt32PtrTy(CTX));
+    EXPECT_EQ(PtrPtrTy, Type::getInt32PtrTy(CTX)->getPointerTo());
+    EXPECT_EQ(PtrPtrTy->getTypeName(), "i32**");
+}
@@ -83,3 +83,137 @@ TEST(test_uir, test_uir_value_4)
     std::cout << std::format("CSTInt ReadableName =  {}", CSTInt->getReadableName()) << std::endl;
     unknown::outs() << "CSTInt ReadableName = " << *CSTInt;
 }
+
+TEST(test_uir, test_uir_value_5)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    auto Preallocated = CTX.getNumIntConstantsAllocated();
+    std::cout << std::format("Preallocated ConstantInt = {}", Preallocated) << std::endl;
+
+    // The small immediates are preallocated
+    auto Zero32 = ConstantInt::get(CTX, unknown::APInt(32, 0));
+    auto MinusOne32 = ConstantInt::get(CTX, unknown::APInt(32, -1, true));
+    auto Imm8 = ConstantInt::get(CTX, unknown::APInt(8, 0x7b));
+    EXPECT_EQ(CTX.getNumIntConstantsAllocated(), Preallocated);
+    EXPECT_EQ(Zero32, ConstantInt::get(CTX, unknown::APInt(32, 0)));
+    EXPECT_EQ(MinusOne32, ConstantInt::get(CTX, unknown::APInt(32, 0xFFFFFFFF)));
+    EXPECT_NE(Zero32, ConstantInt::get(CTX, unknown::APInt(64, 0)));
+    std::cout << std::format("Imm8 ReadableName = {}", Imm8->getReadableName()) << std::endl;
+
+    // The others are hash-consed by (width, value)
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto Val = ConstantInt::get(CTX, unknown::APInt(32, 0x401000));
+        EXPECT_EQ(Val->getZExtValue(), 0x401000u);
+    }
+    auto Wide = ConstantInt::get(CTX, unknown::APInt(256, 0x401000));
+    EXPECT_EQ(Wide, ConstantInt::get(CTX, unknown::APInt(256, 0x401000)));
+    EXPECT_EQ(CTX.getNumIntConstantsAllocated(), Preallocated + 2);
+
+    std::cout << std::format("Allocated ConstantInt = {}", CTX.getNumIntConstantsAllocated()) << std::endl;
+}
+
+TEST(test_uir, test_uir_value_6)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    std::cout << std::format(
+                     "sizeof Value = {}, User = {}, ConstantInt = {}, Instruction = {}, LoadInstruction = {}",
+                     sizeof(Value),
+                     sizeof(User),
+                     sizeof(ConstantInt),
+                     sizeof(Instruction),
+                     sizeof(LoadInstruction))
+              << std::endl;
+
+    auto Ptr1 = new GlobalVariable(Type::getInt32PtrTy(CTX), "global_ptr_1", 0x401000);
+    auto Ptr2 = new GlobalVariable(Type::getInt32PtrTy(CTX), "global_ptr_2", 0x402000);
+    auto Load1 = new LoadInstruction(Ptr1);
+    auto Load2 = new LoadInstruction(Ptr1);
+    EXPECT_EQ(Ptr1->user_size(), 2u);
+    EXPECT_TRUE(Ptr1->user_contains(Load1));
+
+    // Replace all uses
+    Ptr1->replaceAllUsesWith(Ptr2);
+    EXPECT_TRUE(Ptr1->user_empty());
+    EXPECT_EQ(Ptr2->user_size(), 2u);
+    EXPECT_EQ(Load2->getOperand(0), Ptr2);
+
+    // The operands are moved out of line
+    for (int i = 0; i < 8; ++i)
+    {
+        Load1->insertOperandAndUpdateUsers(Ptr1);
+    }
+    EXPECT_EQ(Load1->op_count(), 9u);
+    EXPECT_EQ(Ptr1->user_count(Load1), 8u);
+    EXPECT_EQ(Load1->getOperand(0), Ptr2);
+
+    Load1->eraseOperandAndUpdateUsers(Ptr1);
+    EXPECT_EQ(Load1->op_count(), 1u);
+    EXPECT_TRUE(Ptr1->user_empty());
+
+    delete Load1;
+    delete Load2;
+    EXPECT_TRUE(Ptr2->user_empty());
+    std::cout << std::format("Ptr2 users = {}", Ptr2->user_size()) << std::endl;
+
+    delete Ptr1;
+    delete Ptr2;
+}
+
+TEST(test_uir, test_uir_value_7)
+{
+    Context CTX;
+    CTX.setArch(Context::Arch::ArchX86);
+    CTX.setMode(Context::Mode::Mode64);
+
+    // The names are interned in the context
+    auto Ptr1 = new GlobalVariable(Type::getInt32PtrTy(CTX), "global_ptr", 0x401000);
+    auto Ptr2 = new GlobalVariable(Type::getInt32PtrTy(CTX), "global_ptr", 0x402000);
+    EXPECT_EQ(Ptr1->getNameRef().data(), Ptr2->getNameRef().data());
+
+    // The anonymous locals are numbered per function when they are named
+    auto buildFunction = [&](const char *FunctionName) {
+        Function *F = Function::get(CTX, FunctionName);
+        BasicBlock *BB = BasicBlock::create(CTX, "entry", 0x401000, 0x401000, F);
+        F->insertBasicBlock(BB);
+
+        IRBuilder IRB(BB);
+        auto Load1 = IRB.createLoad(Ptr1, 0x401000);
+        auto Load2 = IRB.createLoad(Ptr2, 0x401004);
+        EXPECT_FALSE(Load1->hasName());
+        EXPECT_FALSE(Load2->hasName());
+        return F;
+    };
+
+    auto F1 = buildFunction("func1");
+    auto F2 = buildFunction("func2");
+    EXPECT_EQ(F2->front().front().getName(), "0");
+    EXPECT_EQ(F1->front().front().getName(), "0");
+    EXPECT_EQ(F1->front().back().getName(), "1");
+    EXPECT_EQ(F2->front().back().getName(), "1");
+
+    // The numbers don't depend on which name is asked first
+    auto F3 = buildFunction("func3");
+    EXPECT_EQ(F3->front().back().getName(), "1");
+    EXPECT_EQ(F3->front().front().getName(), "0");
+
+    // The extra info and comment are allocated when they are used
+    EXPECT_TRUE(Ptr1->getExtraInfoList().empty());
+    EXPECT_TRUE(Ptr1->getComment().empty());
+    Ptr1->addExtraInfo("reg");
+    Ptr1->addComment("rax");
+    EXPECT_EQ(Ptr1->getExtraInfoList().size(), 1u);
+    EXPECT_EQ(Ptr1->getComment(), "rax");
+
+    delete F1;
+    delete F2;
+    delete F3;
+    delete Ptr1;
+    delete Ptr2;
+}